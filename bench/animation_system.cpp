@@ -0,0 +1,63 @@
+#include "CX/Sprite/AnimationSystem.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+
+namespace
+{
+   constexpr size_t frames = 1000u;
+   constexpr float dt = 1.f / 60.f;
+
+   /// @brief Time updates of a system and print milliseconds per update.
+   /// @param sheet Animation sheet.
+   /// @param animation Animation every sprite plays.
+   /// @param count Sprite count.
+   /// @param moving Should every sprite also be moved each frame.
+   void measure(const std::shared_ptr<const cx::AnimationSheet>& sheet, cx::AnimationId animation, size_t count, bool moving)
+   {
+      cx::AnimationSystem system (sheet);
+      system.reserve(count);
+
+      for (size_t i = 0; i < count; ++i)
+         system.add(cx::Vec2f(float(i % 200u) * 8.f, float(i / 200u) * 8.f), cx::Vec2f(8.f, 8.f), animation);
+
+      // First update writes every quad, it is not part of the steady state
+      system.update(dt);
+
+      const auto start = std::chrono::steady_clock::now();
+
+      for (size_t frame = 0; frame < frames; ++frame)
+      {
+         if (moving)
+            for (cx::AnimationSystem::Handle handle = 0; handle < count; ++handle)
+               system.set_position(handle, system.get_position(handle) + cx::Vec2f(1.f, 0.f));
+
+         system.update(dt);
+      }
+
+      const auto end = std::chrono::steady_clock::now();
+      const double milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+
+      // Reading a vertex keeps the updates from being optimized away
+      std::printf("%10zu %8s %14.4f   (x %.0f)\n", count, moving ? "yes" : "no", milliseconds / double(frames),
+                  double(system.get_vertices()[0].position.x));
+   }
+}
+
+/// @brief Measure AnimationSystem::update with still and moving sprites.
+int main()
+{
+   auto sheet = std::make_shared<cx::AnimationSheet>();
+   const cx::AnimationId animation = sheet->add("walk", cx::Animation {8u, 0u, 16u, 16u, 0u, 0u, 0.1f, true, false});
+
+   std::printf("%10s %8s %14s\n", "sprites", "moving", "ms / update");
+
+   for (const size_t count : {1'000u, 20'000u, 100'000u})
+   {
+      measure(sheet, animation, count, false);
+      measure(sheet, animation, count, true);
+   }
+
+   return 0;
+}
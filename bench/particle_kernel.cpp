@@ -0,0 +1,76 @@
+#include "CX/Particle/ParticleKernel.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <initializer_list>
+
+namespace
+{
+   /// @brief Fill the arrays the kernel touches, without colors so no SFML library is needed.
+   /// Velocities settle at acceleration over friction instead of decaying into slow denormals.
+   /// @param storage Particle storage.
+   /// @param count Particle count.
+   void fill(cx::ParticleStorage& storage, size_t count)
+   {
+      storage.position.assign(count, cx::Vec2f(0.f));
+      storage.velocity.assign(count, cx::Vec2f(10.f, -5.f));
+      storage.acceleration.assign(count, cx::Vec2f(2.f, 9.8f));
+      storage.scale.assign(count, cx::Vec2f(1.f));
+      storage.scale_velocity.assign(count, cx::Vec2f(.1f));
+      storage.rotation.assign(count, 0.f);
+      storage.rot_velocity.assign(count, 45.f);
+      storage.friction.assign(count, .5f);
+      storage.age.assign(count, 0.f);
+   }
+
+   /// @brief Get name of an instruction set.
+   /// @param level Instruction set.
+   /// @return Name.
+   const char* get_name(cx::SimdLevel level)
+   {
+      switch (level)
+      {
+      case cx::SimdLevel::sse2: return "sse2";
+      case cx::SimdLevel::avx2: return "avx2";
+      default:                  return "scalar";
+      }
+   }
+}
+
+/// @brief Time integrate_particles for every supported instruction set at 1k, 10k and 100k particles.
+int main()
+{
+   constexpr size_t work = 50'000'000u;
+
+   std::printf("%-10s %-8s %16s %14s\n", "particles", "level", "particles / ms", "ns / particle");
+
+   for (const size_t count : {size_t(1'000), size_t(10'000), size_t(100'000)})
+   {
+      for (const cx::SimdLevel level : {cx::SimdLevel::scalar, cx::SimdLevel::sse2, cx::SimdLevel::avx2})
+      {
+         // Unsupported levels fall back, so their numbers would repeat a lower level
+         if (level > cx::get_simd_level())
+            continue;
+
+         cx::ParticleStorage storage;
+         fill(storage, count);
+
+         const size_t iterations = work / count;
+         cx::integrate_particles(storage, 1.f / 60.f, level);
+
+         const auto start = std::chrono::steady_clock::now();
+         for (size_t i = 0; i < iterations; ++i)
+            cx::integrate_particles(storage, 1.f / 60.f, level);
+         const auto end = std::chrono::steady_clock::now();
+
+         const double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+         const double per_particle = nanoseconds / double(iterations * count);
+
+         // Printing a result keeps the loop from being optimized away
+         std::printf("%-10zu %-8s %16.0f %14.3f   (age %.1f)\n", count, get_name(level),
+                     1'000'000.0 / per_particle, per_particle, storage.age[count - 1u]);
+      }
+   }
+
+   return 0;
+}
@@ -0,0 +1,65 @@
+#include "CX/Math/Random.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+namespace
+{
+   constexpr size_t count = 20'000'000u;
+
+   /// @brief Float generator as it was before Pcg32, a thread local mt19937 and a distribution per call.
+   float mt19937_randf(float min, float max)
+   {
+      static thread_local std::random_device rd;
+      static thread_local std::mt19937 generator(rd());
+      std::uniform_real_distribution<float> dist(min, max);
+      return dist(generator);
+   }
+
+   /// @brief Integer generator as it was before Pcg32, a thread local mt19937 and a distribution per call.
+   int mt19937_randi(int min, int max)
+   {
+      static thread_local std::random_device rd;
+      static thread_local std::mt19937 generator(rd());
+      std::uniform_int_distribution<int> dist(min, max);
+      return dist(generator);
+   }
+
+   /// @brief Time a generator and print nanoseconds per number.
+   /// @param name Name of the generator.
+   /// @param generate Function returning one number.
+   template<typename F>
+   void measure(const char* name, F generate)
+   {
+      double sum = 0.0;
+      const auto start = std::chrono::steady_clock::now();
+
+      for (size_t i = 0; i < count; ++i)
+         sum += double(generate());
+
+      const auto end = std::chrono::steady_clock::now();
+      const double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+
+      // Printing the sum keeps the loop from being optimized away
+      std::printf("%-26s %10.3f   (sum %.0f)\n", name, nanoseconds / double(count), sum);
+   }
+}
+
+/// @brief Compare Pcg32 and random_engine against the old mt19937 based functions.
+int main()
+{
+   std::printf("%-26s %10s\n", "generator", "ns / number");
+
+   measure("mt19937 randf", [] { return mt19937_randf(0.f, 1.f); });
+   measure("mt19937 randi", [] { return mt19937_randi(0, 100); });
+
+   measure("random_engine randf", [] { return cx::randf(0.f, 1.f); });
+   measure("random_engine randi", [] { return cx::randi(0, 100); });
+
+   cx::Pcg32 engine (std::random_device{}());
+   measure("Pcg32 randf", [&engine] { return engine.randf(0.f, 1.f); });
+   measure("Pcg32 randi", [&engine] { return engine.randi(0, 100); });
+
+   return 0;
+}
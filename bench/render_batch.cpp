@@ -0,0 +1,82 @@
+#include "CX/Render/RenderBatch.hpp"
+
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+   /// @brief Submit buttons laid out in a grid, each an untextured background with glyphs on a font page.
+   /// @param batch Render batch.
+   /// @param font_page Texture standing in for a font page.
+   /// @param count Button count.
+   void submit_buttons(cx::RenderBatch& batch, const sf::Texture& font_page, size_t count)
+   {
+      constexpr float width = 60.f;
+      constexpr float height = 20.f;
+
+      for (size_t i = 0; i < count; ++i)
+      {
+         const float x = float(i % 20u) * (width + 4.f);
+         const float y = float(i / 20u) * (height + 4.f);
+
+         const sf::Vertex background[6] {
+            sf::Vertex(sf::Vector2f(x, y)), sf::Vertex(sf::Vector2f(x + width, y)),
+            sf::Vertex(sf::Vector2f(x + width, y + height)), sf::Vertex(sf::Vector2f(x, y)),
+            sf::Vertex(sf::Vector2f(x + width, y + height)), sf::Vertex(sf::Vector2f(x, y + height))
+         };
+         batch.submit(background, 6u, nullptr);
+
+         // Glyphs sit inside the background, so they overlap it and have to stay above it
+         const sf::Vertex glyphs[6] {
+            sf::Vertex(sf::Vector2f(x + 4.f, y + 4.f), sf::Vector2f(0.f, 0.f)),
+            sf::Vertex(sf::Vector2f(x + 40.f, y + 4.f), sf::Vector2f(8.f, 0.f)),
+            sf::Vertex(sf::Vector2f(x + 40.f, y + 16.f), sf::Vector2f(8.f, 8.f)),
+            sf::Vertex(sf::Vector2f(x + 4.f, y + 4.f), sf::Vector2f(0.f, 0.f)),
+            sf::Vertex(sf::Vector2f(x + 40.f, y + 16.f), sf::Vector2f(8.f, 8.f)),
+            sf::Vertex(sf::Vector2f(x + 4.f, y + 16.f), sf::Vector2f(0.f, 8.f))
+         };
+         batch.submit(glyphs, 6u, &font_page);
+      }
+   }
+}
+
+/// @brief Check that buttons flush in a constant count of draw calls, whatever their count.
+int main()
+{
+   sf::RenderTexture target;
+   sf::Texture font_page;
+
+   if (!target.create(1280u, 1280u) || !font_page.create(8u, 8u))
+   {
+      std::printf("could not create the render target\n");
+      return 1;
+   }
+
+   cx::RenderBatch batch;
+   size_t first_draw_calls = 0u;
+   bool constant = true;
+
+   std::printf("%10s %12s %11s %12s\n", "buttons", "submissions", "draw calls", "ms / flush");
+
+   for (const size_t count : {1u, 10u, 100u, 500u, 1000u})
+   {
+      submit_buttons(batch, font_page, count);
+
+      const auto start = std::chrono::steady_clock::now();
+      batch.flush(target);
+      const auto end = std::chrono::steady_clock::now();
+
+      const cx::RenderStats& stats = batch.get_stats();
+      std::printf("%10zu %12zu %11zu %12.4f\n", count, stats.submissions, stats.draw_calls,
+                  std::chrono::duration<double, std::milli>(end - start).count());
+
+      if (first_draw_calls == 0u)
+         first_draw_calls = stats.draw_calls;
+      constant = constant && stats.draw_calls == first_draw_calls;
+   }
+
+   std::printf(constant ? "draw calls are constant\n" : "draw calls grow with the button count\n");
+   return constant ? 0 : 1;
+}
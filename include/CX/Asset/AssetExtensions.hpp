@@ -0,0 +1,29 @@
+#ifndef CX_ASSET_ASSET_EXTENSIONS_HPP
+#define CX_ASSET_ASSET_EXTENSIONS_HPP
+
+#include <string>
+#include <unordered_set>
+
+namespace cx
+{
+   namespace extensions
+   {
+      /// @brief Texture extensions.
+      inline const std::unordered_set<std::string> texture
+      {".bmp", ".dds", ".jpg", ".jpeg", ".png", ".tga", ".psd", ".gif", ".hdr", ".pic"};
+
+      /// @brief Sound extensions.
+      inline const std::unordered_set<std::string> sound
+      {".wav", ".ogg", ".flac", ".aiff", ".aif"};
+
+      /// @brief Music extensions.
+      inline const std::unordered_set<std::string> music
+      {".wav", ".ogg", ".flac", ".mid", ".midi"};
+
+      /// @brief Font extensions.
+      inline const std::unordered_set<std::string> font
+      {".ttf", ".otf", ".pfa", ".pfb", ".bmf"};
+   }
+}
+
+#endif
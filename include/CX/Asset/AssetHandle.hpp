@@ -0,0 +1,221 @@
+#ifndef CX_ASSET_ASSET_HANDLE_HPP
+#define CX_ASSET_ASSET_HANDLE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace cx
+{
+   /// @brief State of an asset loading in the background.
+   enum class AssetStatus : char
+   {
+      pending,  ///< @brief Waiting to be loaded or being loaded.
+      ready,    ///< @brief Loaded.
+      failed,   ///< @brief Could not be loaded.
+      cancelled ///< @brief Cancelled before it was loaded.
+   };
+
+   /// @brief Shared state of one asset loading in the background, independent of its type.
+   class AssetLoad
+   {
+   public:
+      // Getter functions
+
+      /// @brief Get state of the load.
+      /// @return Status.
+      inline AssetStatus get_status() const
+      {
+         return status.load(std::memory_order_acquire);
+      }
+
+      /// @brief Check if the load is no longer pending.
+      /// @return True if ready, failed or cancelled.
+      inline bool is_finished() const
+      {
+         return get_status() != AssetStatus::pending;
+      }
+
+      /// @brief Get priority, higher priorities are loaded first.
+      /// @return Priority.
+      inline int get_priority() const
+      {
+         return priority.load(std::memory_order_relaxed);
+      }
+
+      // Setter functions
+
+      /// @brief Change priority, takes effect if the load has not started yet.
+      /// @param priority Priority, higher priorities are loaded first.
+      inline void set_priority(int priority)
+      {
+         this->priority.store(priority, std::memory_order_relaxed);
+      }
+
+      // Wait functions
+
+      /// @brief Block until the load is finished.
+      inline void wait() const
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         condition.wait(lock, [this] { return is_finished(); });
+      }
+
+      /// @brief Block until the load is finished or a timeout passed.
+      /// @param timeout Longest time to wait.
+      /// @return True if finished.
+      inline bool wait_for(std::chrono::milliseconds timeout) const
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         return condition.wait_for(lock, timeout, [this] { return is_finished(); });
+      }
+
+      /// @brief Cancel the load if it is still pending. Callbacks of cancelled loads are not called.
+      /// @return True if cancelled.
+      inline bool cancel()
+      {
+         return finish(AssetStatus::cancelled);
+      }
+
+   private:
+      friend class AssetManager;
+
+      std::atomic<AssetStatus> status {AssetStatus::pending};
+      std::atomic<int> priority {0};
+      std::function<void(bool)> on_finished;
+
+      mutable std::mutex mutex;
+      mutable std::condition_variable condition;
+
+      /// @brief Leave the pending state and wake waiting threads.
+      /// @param result Ready, failed or cancelled.
+      /// @return False if the load was already finished.
+      inline bool finish(AssetStatus result)
+      {
+         AssetStatus expected = AssetStatus::pending;
+
+         {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!status.compare_exchange_strong(expected, result, std::memory_order_acq_rel))
+               return false;
+         }
+
+         condition.notify_all();
+         return true;
+      }
+   };
+
+   /// @brief Typed handle to an asset loading in the background, cheap to copy.
+   /// @tparam T Asset type.
+   template<typename T>
+   class AssetHandle
+   {
+   public:
+      // Constructors
+
+      /// @brief Create an empty handle.
+      AssetHandle() = default;
+
+      // Getter functions
+
+      /// @brief Check if the handle refers to a load.
+      /// @return True if valid.
+      inline bool is_valid() const
+      {
+         return state != nullptr;
+      }
+
+      /// @brief Get state of the load.
+      /// @return Status, cancelled for an empty handle.
+      inline AssetStatus get_status() const
+      {
+         return state ? state->get_status() : AssetStatus::cancelled;
+      }
+
+      /// @brief Check if the asset is loaded.
+      /// @return True if ready.
+      inline bool is_ready() const
+      {
+         return get_status() == AssetStatus::ready;
+      }
+
+      /// @brief Check if the load is no longer pending.
+      /// @return True if ready, failed or cancelled.
+      inline bool is_finished() const
+      {
+         return get_status() != AssetStatus::pending;
+      }
+
+      /// @brief Get the asset.
+      /// @return Asset, null until ready.
+      inline std::shared_ptr<T> get() const
+      {
+         return is_ready() ? state->asset : nullptr;
+      }
+
+      /// @brief Get priority, higher priorities are loaded first.
+      /// @return Priority.
+      inline int get_priority() const
+      {
+         return state ? state->get_priority() : 0;
+      }
+
+      // Setter functions
+
+      /// @brief Change priority, takes effect if the load has not started yet.
+      /// @param priority Priority, higher priorities are loaded first.
+      inline void set_priority(int priority) const
+      {
+         if (state)
+            state->set_priority(priority);
+      }
+
+      // Wait functions
+
+      /// @brief Block until the load is finished.
+      /// Textures are finished by AssetManager::update, wait with AssetManager::wait on the thread owning the window.
+      /// @return Asset, null if it failed or was cancelled.
+      inline std::shared_ptr<T> wait() const
+      {
+         if (state)
+            state->wait();
+         return get();
+      }
+
+      /// @brief Block until the load is finished or a timeout passed.
+      /// @param timeout Longest time to wait.
+      /// @return True if finished.
+      inline bool wait_for(std::chrono::milliseconds timeout) const
+      {
+         return !state || state->wait_for(timeout);
+      }
+
+      /// @brief Cancel the load if it is still pending.
+      /// @return True if cancelled.
+      inline bool cancel() const
+      {
+         return state && state->cancel();
+      }
+
+   private:
+      friend class AssetManager;
+
+      /// @brief Load state holding the asset once ready.
+      struct State : AssetLoad
+      {
+         std::shared_ptr<T> asset;
+      };
+
+      std::shared_ptr<State> state;
+
+      /// @brief Create a handle to a load.
+      /// @param state Load state.
+      explicit AssetHandle(std::shared_ptr<State> state)
+         : state(std::move(state)) {}
+   };
+}
+
+#endif
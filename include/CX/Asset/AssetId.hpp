@@ -0,0 +1,94 @@
+#ifndef CX_ASSET_ASSET_ID_HPP
+#define CX_ASSET_ASSET_ID_HPP
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace cx
+{
+   /// @brief Interned asset name, compared and looked up by index instead of by string.
+   /// Names are interned once for the lifetime of the program and shared by every asset manager.
+   class AssetId
+   {
+   public:
+      using index_t = uint32_t;
+
+      static constexpr index_t invalid_index = index_t(-1); ///< @brief Index of an empty id.
+
+      // Constructors
+
+      /// @brief Create an empty id.
+      constexpr AssetId() = default;
+
+      /// @brief Create an id, interning the name if it is new.
+      /// @param name Name.
+      explicit AssetId(std::string_view name);
+
+      // Lookup functions
+
+      /// @brief Find the id of a name without interning it.
+      /// @param name Name.
+      /// @return Id, empty if the name was never interned.
+      static AssetId find(std::string_view name);
+
+      // Getter functions
+
+      /// @brief Get index, dense from 0 in order of interning.
+      /// @return Index, invalid_index if empty.
+      constexpr index_t get_index() const
+      {
+         return index;
+      }
+
+      /// @brief Get the interned name.
+      /// @return Name, empty if the id is empty.
+      const std::string& get_name() const;
+
+      /// @brief Check if the id refers to a name.
+      /// @return True if not empty.
+      constexpr bool is_valid() const
+      {
+         return index != invalid_index;
+      }
+
+      /// @brief Get count of names interned so far.
+      /// @return Name count.
+      static size_t get_count();
+
+      // Operators
+
+      constexpr explicit operator bool() const
+      {
+         return is_valid();
+      }
+
+      constexpr bool operator==(const AssetId& other) const = default;
+
+   private:
+      index_t index = invalid_index;
+   };
+
+   /// @brief Transparent string hash, lets string keyed maps be searched with a std::string_view without a copy.
+   struct StringHash
+   {
+      using is_transparent = void;
+
+      inline size_t operator()(std::string_view string) const
+      {
+         return std::hash<std::string_view>()(string);
+      }
+   };
+}
+
+template<>
+struct std::hash<cx::AssetId>
+{
+   inline size_t operator()(const cx::AssetId& id) const
+   {
+      return std::hash<cx::AssetId::index_t>()(id.get_index());
+   }
+};
+
+#endif
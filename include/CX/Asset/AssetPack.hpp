@@ -0,0 +1,140 @@
+#ifndef CX_ASSET_ASSET_PACK_HPP
+#define CX_ASSET_ASSET_PACK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace fs = std::filesystem;
+
+namespace cx
+{
+   /// @brief Read only archive of asset files, memory mapped so files are read without copies or system calls.
+   /// Layout is a header, an index of entries sorted by name, the names, then the file data,
+   /// every file aligned to data_alignment. Numbers are little endian.
+   class AssetPack
+   {
+   public:
+      static constexpr uint32_t magic = 0x4b505843u;  ///< @brief "CXPK" read as a little endian number.
+      static constexpr uint32_t version = 1u;         ///< @brief Version of the layout.
+      static constexpr uint64_t data_alignment = 16u; ///< @brief Alignment of file data from the start of the pack.
+
+      /// @brief Kinds of asset a file can be loaded as, combined as bit flags.
+      enum Kind : uint8_t
+      {
+         texture = 1u << 0u, ///< @brief Has a texture extension.
+         sound   = 1u << 1u, ///< @brief Has a sound extension.
+         song    = 1u << 2u, ///< @brief Has a music extension.
+         font    = 1u << 3u  ///< @brief Has a font extension.
+      };
+
+      /// @brief Start of the pack.
+      struct Header
+      {
+         uint32_t magic;
+         uint32_t version;
+         uint32_t entry_count;
+         uint32_t reserved;
+         uint64_t names_offset;
+         uint64_t names_size;
+      };
+
+      /// @brief Index entry of one file.
+      struct Entry
+      {
+         uint64_t offset;      ///< @brief Offset of the data from the start of the pack.
+         uint64_t size;        ///< @brief Size of the data.
+         uint32_t name_offset; ///< @brief Offset of the name in the names.
+         uint32_t name_length; ///< @brief Length of the name.
+         uint8_t kinds;        ///< @brief Kind flags.
+         uint8_t reserved[7];
+      };
+
+      static_assert(sizeof(Header) == 32u && sizeof(Entry) == 32u, "Pack layout must not depend on padding");
+
+      // Constructors
+
+      /// @brief Create a closed pack.
+      AssetPack() = default;
+
+      /// @brief Open a pack.
+      /// @param path Path to the pack.
+      explicit AssetPack(const fs::path& path);
+
+      AssetPack(const AssetPack&) = delete;
+      AssetPack& operator=(const AssetPack&) = delete;
+
+      AssetPack(AssetPack&& other) noexcept;
+      AssetPack& operator=(AssetPack&& other) noexcept;
+
+      ~AssetPack();
+
+      // File functions
+
+      /// @brief Map a pack into memory, closing the previous one. Throws if it is not a valid pack.
+      /// @param path Path to the pack.
+      void open(const fs::path& path);
+
+      /// @brief Unmap the pack, data of its files must no longer be used.
+      void close();
+
+      /// @brief Pack every asset file in a directory and its subdirectories.
+      /// Files are named by their path relative to the directory, with forward slashes.
+      /// @param directory Directory.
+      /// @param path Path to the new pack.
+      /// @return Count of files packed.
+      static size_t write(const fs::path& directory, const fs::path& path);
+
+      // Getter functions
+
+      /// @brief Check if a pack is mapped.
+      /// @return True if open.
+      bool is_open() const;
+
+      /// @brief Get path of the pack.
+      /// @return Path.
+      const fs::path& get_path() const;
+
+      /// @brief Get count of files.
+      /// @return File count.
+      size_t size() const;
+
+      /// @brief Get the index.
+      /// @return Entries sorted by name.
+      std::span<const Entry> get_entries() const;
+
+      /// @brief Find a file by name.
+      /// @param name Name, a path relative to the packed directory with forward slashes.
+      /// @return Entry, null if there is no such file.
+      const Entry* find(std::string_view name) const;
+
+      /// @brief Find all files in a directory and its subdirectories.
+      /// @param directory Directory name with forward slashes, empty for every file.
+      /// @return Entries, next to each other as they are sorted by name.
+      std::span<const Entry> find_directory(std::string_view directory) const;
+
+      /// @brief Get name of a file.
+      /// @param entry Entry.
+      /// @return Name.
+      std::string_view get_name(const Entry& entry) const;
+
+      /// @brief Get data of a file, valid while the pack is open.
+      /// @param entry Entry.
+      /// @return Data.
+      std::span<const std::byte> get_data(const Entry& entry) const;
+
+   private:
+      fs::path path;
+      const std::byte* data = nullptr;
+      size_t data_size = 0u;
+      std::span<const Entry> entries;
+      std::string_view names;
+
+      /// @brief Check the mapped layout and read the index.
+      void parse();
+   };
+}
+
+#endif
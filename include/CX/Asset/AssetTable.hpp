@@ -0,0 +1,148 @@
+#ifndef CX_ASSET_ASSET_TABLE_HPP
+#define CX_ASSET_ASSET_TABLE_HPP
+
+#include "CX/Asset/AssetId.hpp"
+#include <deque>
+#include <memory>
+#include <string_view>
+
+namespace cx
+{
+   /// @brief Assets of one type indexed by the index of their id.
+   /// Lookups by id are a bounds check and an array access, lookups by name search the interned names once.
+   /// Slots never move, so references to assets stay valid while others are added.
+   /// @tparam T Asset type.
+   template<typename T>
+   class AssetTable
+   {
+   public:
+      using asset_t = std::shared_ptr<T>;
+
+      // Lookup functions
+
+      /// @brief Check if an asset exists.
+      /// @param id Asset id.
+      /// @return True if exists.
+      inline bool contains(AssetId id) const
+      {
+         return find(id) != nullptr;
+      }
+
+      /// @brief Check if an asset exists.
+      /// @param name Asset name.
+      /// @return True if exists.
+      inline bool contains(std::string_view name) const
+      {
+         return contains(AssetId::find(name));
+      }
+
+      /// @brief Find an asset.
+      /// @param id Asset id.
+      /// @return Asset, null if it does not exist.
+      inline const asset_t* find(AssetId id) const
+      {
+         const size_t index = id.get_index();
+         return index < slots.size() && slots[index] ? &slots[index] : nullptr;
+      }
+
+      /// @brief Find an asset.
+      /// @param name Asset name.
+      /// @return Asset, null if it does not exist.
+      inline const asset_t* find(std::string_view name) const
+      {
+         return find(AssetId::find(name));
+      }
+
+      /// @brief Get the slot of an asset, adding an empty one if needed.
+      /// @param id Asset id.
+      /// @return Asset slot.
+      inline asset_t& operator[](AssetId id)
+      {
+         if (id.get_index() >= slots.size())
+            slots.resize(size_t(id.get_index()) + 1u);
+         return slots[id.get_index()];
+      }
+
+      /// @brief Get the slot of an asset, adding an empty one if needed.
+      /// @param name Asset name, interned if new.
+      /// @return Asset slot.
+      inline asset_t& operator[](std::string_view name)
+      {
+         return (*this)[AssetId(name)];
+      }
+
+      // Modify functions
+
+      /// @brief Add an asset if the id is free.
+      /// @param id Asset id.
+      /// @param asset Asset.
+      /// @return Asset with the id, the existing one if it was taken.
+      inline const asset_t& insert(AssetId id, asset_t asset)
+      {
+         asset_t& slot = (*this)[id];
+
+         if (!slot)
+         {
+            slot = std::move(asset);
+            ++count;
+         }
+
+         return slot;
+      }
+
+      /// @brief Add or replace an asset.
+      /// @param id Asset id.
+      /// @param asset Asset.
+      /// @return Asset.
+      inline const asset_t& assign(AssetId id, asset_t asset)
+      {
+         asset_t& slot = (*this)[id];
+
+         if (!slot)
+            ++count;
+
+         slot = std::move(asset);
+         return slot;
+      }
+
+      /// @brief Remove an asset.
+      /// @param id Asset id.
+      inline void erase(AssetId id)
+      {
+         if (!contains(id))
+            return;
+
+         slots[id.get_index()].reset();
+         --count;
+      }
+
+      /// @brief Remove an asset.
+      /// @param name Asset name.
+      inline void erase(std::string_view name)
+      {
+         erase(AssetId::find(name));
+      }
+
+      /// @brief Remove all assets.
+      inline void clear()
+      {
+         slots.clear();
+         count = 0u;
+      }
+
+      // Getter functions
+
+      /// @brief Get count of assets.
+      /// @return Asset count.
+      inline size_t size() const
+      {
+         return count;
+      }
+
+   private:
+      std::deque<asset_t> slots;
+      size_t count = 0u;
+   };
+}
+
+#endif
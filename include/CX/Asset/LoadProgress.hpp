@@ -0,0 +1,122 @@
+#ifndef CX_ASSET_LOAD_PROGRESS_HPP
+#define CX_ASSET_LOAD_PROGRESS_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace cx
+{
+   /// @brief Progress of loading many assets in the background.
+   /// Safe to read from any thread while loading.
+   class LoadProgress
+   {
+   public:
+      // Getter functions
+
+      /// @brief Get count of files to load, 0 until the directories are walked.
+      /// @return File count.
+      inline size_t get_total() const
+      {
+         return total.load(std::memory_order_acquire);
+      }
+
+      /// @brief Get count of files loaded.
+      /// @return Loaded count.
+      inline size_t get_loaded() const
+      {
+         return loaded.load(std::memory_order_acquire);
+      }
+
+      /// @brief Get count of files that could not be loaded.
+      /// @return Failed count.
+      inline size_t get_failed() const
+      {
+         return failed.load(std::memory_order_acquire);
+      }
+
+      /// @brief Get share of files done, loaded or failed.
+      /// @return Progress between 0 and 1.
+      inline float get_progress() const
+      {
+         if (is_finished())
+            return 1.f;
+
+         const size_t count = get_total();
+         return count == 0u ? 0.f : float(get_loaded() + get_failed()) / float(count);
+      }
+
+      /// @brief Check if the directories were walked and the total is known.
+      /// @return True if walked.
+      inline bool is_walked() const
+      {
+         return walked.load(std::memory_order_acquire);
+      }
+
+      /// @brief Check if every file is done.
+      /// @return True if finished.
+      inline bool is_finished() const
+      {
+         return finished.load(std::memory_order_acquire);
+      }
+
+      /// @brief Check if any file could not be loaded.
+      /// @return True if something failed.
+      inline bool has_failed() const
+      {
+         return get_failed() != 0u || walk_failed.load(std::memory_order_acquire);
+      }
+
+      /// @brief Block until every file is done.
+      inline void wait() const
+      {
+         std::unique_lock<std::mutex> lock(mutex);
+         condition.wait(lock, [this] { return is_finished(); });
+      }
+
+   private:
+      friend class AssetManager;
+
+      std::atomic<size_t> total {0u};
+      std::atomic<size_t> loaded {0u};
+      std::atomic<size_t> failed {0u};
+      std::atomic<size_t> done {0u};
+      std::atomic<bool> walked {false};
+      std::atomic<bool> walk_failed {false};
+      std::atomic<bool> finished {false};
+
+      mutable std::mutex mutex;
+      mutable std::condition_variable condition;
+
+      /// @brief Set count of files found, before any of them is loaded.
+      /// @param count File count.
+      inline void set_total(size_t count)
+      {
+         total.store(count, std::memory_order_release);
+         walked.store(true, std::memory_order_release);
+      }
+
+      /// @brief Count a file as done.
+      /// @param success Was the file loaded.
+      /// @return True if it was the last file.
+      inline bool add_done(bool success)
+      {
+         (success ? loaded : failed).fetch_add(1u, std::memory_order_acq_rel);
+         return done.fetch_add(1u, std::memory_order_acq_rel) + 1u == get_total();
+      }
+
+      /// @brief Mark loading as finished and wake waiting threads.
+      inline void finish()
+      {
+         {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.store(true, std::memory_order_release);
+         }
+
+         condition.notify_all();
+      }
+   };
+}
+
+#endif
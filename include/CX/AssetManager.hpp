@@ -4,12 +4,28 @@
 #include <SFML/Audio/Music.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Time.hpp>
+#include <atomic>
+#include "CX/Asset/AssetExtensions.hpp"
+#include "CX/Asset/AssetHandle.hpp"
+#include "CX/Asset/AssetPack.hpp"
+#include "CX/Asset/AssetTable.hpp"
+#include "CX/Asset/LoadProgress.hpp"
+#include "CX/Atlas/TextureAtlas.hpp"
+#include "CX/ThreadPool.hpp"
+#include <deque>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <span>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -25,12 +41,28 @@ namespace cx
       using sound_t   = std::shared_ptr<sf::SoundBuffer>;
       using music_t   = std::shared_ptr<fs::path>;
       using font_t    = std::shared_ptr<sf::Font>;
+      using atlas_t   = std::shared_ptr<TextureAtlas>;
+
+      using progress_t = std::shared_ptr<const LoadProgress>;
+
+      /// @brief File served from a mounted pack.
+      struct PackedFile
+      {
+         std::shared_ptr<const AssetPack> pack; ///< @brief Pack, keeps the data mapped while held.
+         std::span<const std::byte> data;       ///< @brief Data of the file inside the pack.
+
+         /// @brief Check if the file was found.
+         /// @return True if found.
+         explicit operator bool() const { return pack != nullptr; }
+      };
 
       // Constructors
    
       /// @brief Create a default asset manager.
       AssetManager() = default;
-      ~AssetManager() = default;
+
+      /// @brief Cancel pending background loads and wait for running ones.
+      ~AssetManager();
 
       /// @brief Create a new asset manager.
       /// @param root_directory Root directory.
@@ -66,6 +98,23 @@ namespace cx
       /// @return Root directory.
       const fs::path& get_root_directory() const;
 
+      // Pack functions
+
+      /// @brief Mount a pack written by AssetPack::write or cx_pack from the root directory.
+      /// Loads of files inside the root are then served from the mapped pack, without touching the file system.
+      /// Packs mounted later are searched first.
+      /// @param path Path to the pack.
+      /// @param relative_to_root Is path relative to root.
+      void mount_pack(const fs::path& path, bool relative_to_root = true);
+
+      /// @brief Unmount all packs. Assets loaded from them stay valid.
+      void unmount_packs();
+
+      /// @brief Find a file in the mounted packs.
+      /// @param path Full path to the file, inside the root directory.
+      /// @return Packed file, empty if no pack contains it.
+      PackedFile find_packed(const fs::path& path) const;
+
       // Load functions
 
       /// @brief Load or retrieve a texture.
@@ -162,47 +211,226 @@ namespace cx
                          bool relative_to_root = true,
                          bool recursive = true);
 
+      // Load async functions
+
+      /// @brief Load a texture in the background.
+      /// The image is decoded on a loader thread and turned into a texture by update.
+      /// @param identifier New identifier.
+      /// @param path Path to the texture.
+      /// @param relative_to_root Is path relative to root.
+      /// @param priority Priority, higher priorities are loaded first.
+      /// @param on_finished Called by update when finished, false if it failed. Not called if cancelled.
+      /// @return Handle to the texture.
+      AssetHandle<sf::Texture> load_texture_async(const std::string& identifier,
+                                                  const fs::path& path,
+                                                  bool relative_to_root = true,
+                                                  int priority = 0,
+                                                  const std::function<void(bool)>& on_finished = nullptr);
+
+      /// @brief Load a sound in the background.
+      /// @param identifier New identifier.
+      /// @param path Path to the sound.
+      /// @param relative_to_root Is path relative to root.
+      /// @param priority Priority, higher priorities are loaded first.
+      /// @param on_finished Called by update when finished, false if it failed. Not called if cancelled.
+      /// @return Handle to the sound.
+      AssetHandle<sf::SoundBuffer> load_sound_async(const std::string& identifier,
+                                                    const fs::path& path,
+                                                    bool relative_to_root = true,
+                                                    int priority = 0,
+                                                    const std::function<void(bool)>& on_finished = nullptr);
+
+      /// @brief Load a song in the background.
+      /// @param identifier New identifier.
+      /// @param path Path to the song.
+      /// @param relative_to_root Is path relative to root.
+      /// @param priority Priority, higher priorities are loaded first.
+      /// @param on_finished Called by update when finished, false if it failed. Not called if cancelled.
+      /// @return Handle to the path of the song.
+      AssetHandle<fs::path> load_song_async(const std::string& identifier,
+                                            const fs::path& path,
+                                            bool relative_to_root = true,
+                                            int priority = 0,
+                                            const std::function<void(bool)>& on_finished = nullptr);
+
+      /// @brief Load a font in the background.
+      /// @param identifier New identifier.
+      /// @param path Path to the font.
+      /// @param relative_to_root Is path relative to root.
+      /// @param priority Priority, higher priorities are loaded first.
+      /// @param on_finished Called by update when finished, false if it failed. Not called if cancelled.
+      /// @return Handle to the font.
+      AssetHandle<sf::Font> load_font_async(const std::string& identifier,
+                                            const fs::path& path,
+                                            bool relative_to_root = true,
+                                            int priority = 0,
+                                            const std::function<void(bool)>& on_finished = nullptr);
+
+      /// @brief Block until a background load is finished.
+      /// Creates decoded textures while waiting, so it can be called on the thread owning the window.
+      /// @param handle Handle to the load.
+      /// @return Asset, null if it failed or was cancelled.
+      template<typename T>
+      std::shared_ptr<T> wait(const AssetHandle<T>& handle)
+      {
+         while (!handle.is_finished())
+         {
+            flush_uploads();
+            handle.wait_for(std::chrono::milliseconds(1));
+         }
+
+         return handle.get();
+      }
+
       // Load directory async functions
 
       /// @brief Load all textures in a directory in the background.
-      /// @param on_finished Called when finished.
+      /// The directory is walked first, then every image is decoded as its own task on the loader threads.
+      /// Decoded images are turned into textures by update, on the thread owning the window.
+      /// @param on_finished Called by update when every file is done, false if any failed.
       /// @param directory Directory.
       /// @param relative_to_root Is directory relative to root.
       /// @param recursive Should subdirectories be loaded.
-      void load_texture_dir_async(const std::function<void(bool)>& on_finished,
-                                  const fs::path& directory = "",
-                                  bool relative_to_root = true,
-                                  bool recursive = true);
+      /// @return Progress of the load.
+      progress_t load_texture_dir_async(const std::function<void(bool)>& on_finished,
+                                        const fs::path& directory = "",
+                                        bool relative_to_root = true,
+                                        bool recursive = true);
 
       /// @brief Load all sounds in a directory in the background.
-      /// @param on_finished Called when finished.
+      /// The directory is walked first, then every file is loaded as its own task on the loader threads.
+      /// @param on_finished Called by update when every file is done, false if any failed.
       /// @param directory Directory.
       /// @param relative_to_root Is directory relative to root.
       /// @param recursive Should subdirectories be loaded.
-      void load_sound_dir_async(const std::function<void(bool)>& on_finished,
-                                  const fs::path& directory = "",
-                                  bool relative_to_root = true,
-                                  bool recursive = true);
+      /// @return Progress of the load.
+      progress_t load_sound_dir_async(const std::function<void(bool)>& on_finished,
+                                      const fs::path& directory = "",
+                                      bool relative_to_root = true,
+                                      bool recursive = true);
 
       /// @brief Load all songs in a directory in the background.
-      /// @param on_finished Called when finished.
+      /// The directory is walked first, then every file is loaded as its own task on the loader threads.
+      /// @param on_finished Called by update when every file is done, false if any failed.
       /// @param directory Directory.
       /// @param relative_to_root Is directory relative to root.
       /// @param recursive Should subdirectories be loaded.
-      void load_song_dir_async(const std::function<void(bool)>& on_finished,
-                            const fs::path& directory = "",
-                            bool relative_to_root = true,
-                            bool recursive = true);
+      /// @return Progress of the load.
+      progress_t load_song_dir_async(const std::function<void(bool)>& on_finished,
+                                     const fs::path& directory = "",
+                                     bool relative_to_root = true,
+                                     bool recursive = true);
 
       /// @brief Load all fonts in a directory in the background.
-      /// @param on_finished Called when finished.
+      /// The directory is walked first, then every file is loaded as its own task on the loader threads.
+      /// @param on_finished Called by update when every file is done, false if any failed.
       /// @param directory Directory.
       /// @param relative_to_root Is directory relative to root.
       /// @param recursive Should subdirectories be loaded.
-      void load_font_dir_async(const std::function<void(bool)>& on_finished,
-                                  const fs::path& directory = "",
-                                  bool relative_to_root = true,
-                                  bool recursive = true);
+      /// @return Progress of the load.
+      progress_t load_font_dir_async(const std::function<void(bool)>& on_finished,
+                                     const fs::path& directory = "",
+                                     bool relative_to_root = true,
+                                     bool recursive = true);
+
+      // Loader functions
+
+      /// @brief Change count of threads loading in the background, waits for running loads first.
+      /// @param thread_count Thread count, at least 1.
+      void set_loader_thread_count(size_t thread_count);
+
+      /// @brief Get count of threads loading in the background.
+      /// @return Thread count, 0 before the first background load.
+      size_t get_loader_thread_count() const;
+
+      /// @brief Block until every background load is done. Decoded textures still wait for update.
+      void wait_for_loads();
+
+      // Upload functions
+
+      /// @brief Create textures from decoded images within the upload budget, then call finished callbacks.
+      /// Call once per frame on the thread owning the window, at least one texture is created per call.
+      /// @return Count of textures created.
+      size_t update();
+
+      /// @brief Create textures from all decoded images, ignoring the upload budget.
+      /// @return Count of textures created.
+      size_t flush_uploads();
+
+      /// @brief Change how much update may upload per call.
+      /// @param time Time spent uploading, zero for no limit.
+      /// @param bytes Pixel bytes uploaded, 0 for no limit.
+      void set_upload_budget(sf::Time time, size_t bytes = 0u);
+
+      /// @brief Get time update may spend uploading.
+      /// @return Time, zero for no limit.
+      sf::Time get_upload_time_budget() const;
+
+      /// @brief Get pixel bytes update may upload.
+      /// @return Bytes, 0 for no limit.
+      size_t get_upload_byte_budget() const;
+
+      /// @brief Get count of decoded images waiting to be uploaded.
+      /// @return Image count.
+      size_t get_pending_upload_count() const;
+
+      // Atlas functions
+
+      /// @brief Load or retrieve a texture atlas packed from all textures in a directory.
+      /// The directory is read from the mounted packs if one contains it, otherwise from the file system.
+      /// Images get the same identifier as their file name.
+      /// @param identifier New identifier.
+      /// @param directory Directory.
+      /// @param layout_path Layout file that skips packing while the textures are unchanged, empty to always pack.
+      /// @param relative_to_root Are directory and layout file relative to root.
+      /// @param recursive Should subdirectories be packed.
+      /// @param page_size Width and height of every atlas page.
+      /// @param padding Empty pixels around every image.
+      /// @return Texture atlas.
+      const atlas_t& load_texture_atlas(const std::string& identifier,
+                                        const fs::path& directory = "",
+                                        const fs::path& layout_path = "",
+                                        bool relative_to_root = true,
+                                        bool recursive = true,
+                                        unsigned page_size = 2048u,
+                                        unsigned padding = 2u);
+
+      /// @brief Load or retrieve a texture atlas packed from a list of textures.
+      /// Images get the same identifier as their file name.
+      /// @param identifier New identifier.
+      /// @param paths Paths to textures.
+      /// @param layout_path Layout file that skips packing while the textures are unchanged, empty to always pack.
+      /// @param relative_to_root Are paths and layout file relative to root.
+      /// @param page_size Width and height of every atlas page.
+      /// @param padding Empty pixels around every image.
+      /// @return Texture atlas.
+      const atlas_t& load_texture_atlas(const std::string& identifier,
+                                        const std::vector<fs::path>& paths,
+                                        const fs::path& layout_path = "",
+                                        bool relative_to_root = true,
+                                        unsigned page_size = 2048u,
+                                        unsigned padding = 2u);
+
+      /// @brief Get texture atlas or throw error.
+      /// @param identifier Identifier.
+      /// @return Texture atlas.
+      const atlas_t& get_texture_atlas(std::string_view identifier) const;
+
+      /// @brief Get texture region or throw error.
+      /// Images packed into an atlas give their page and rectangle, other textures are returned whole.
+      /// An image in more than one atlas is taken from the atlas loaded first.
+      /// @param identifier Identifier of the image or texture.
+      /// @return Texture region.
+      TextureRegion get_texture_region(const std::string& identifier);
+
+      /// @brief Check if texture atlas exists.
+      /// @param identifier Identifier.
+      /// @return True if exists.
+      bool find_texture_atlas(std::string_view identifier) const;
+
+      /// @brief Unload a texture atlas. Regions taken from it become invalid.
+      /// @param identifier Identifier.
+      void unload_texture_atlas(std::string_view identifier);
 
       // Insert functions
 
@@ -235,22 +463,42 @@ namespace cx
       /// @brief Get texture or throw error.
       /// @param identifier Identifier.
       /// @return Texture.
-      const texture_t& get_texture(const std::string& identifier);
+      const texture_t& get_texture(std::string_view identifier) const;
+
+      /// @brief Get texture or throw error, without hashing the name.
+      /// @param id Interned identifier.
+      /// @return Texture.
+      const texture_t& get_texture(AssetId id) const;
 
       /// @brief Get sound or throw error.
       /// @param identifier Identifier.
       /// @return Sound.
-      const sound_t& get_sound(const std::string& identifier);
+      const sound_t& get_sound(std::string_view identifier) const;
+
+      /// @brief Get sound or throw error, without hashing the name.
+      /// @param id Interned identifier.
+      /// @return Sound.
+      const sound_t& get_sound(AssetId id) const;
 
       /// @brief Get song or throw error.
       /// @param identifier Identifier.
       /// @return Song.
-      const music_t& get_song(const std::string& identifier);
+      const music_t& get_song(std::string_view identifier) const;
+
+      /// @brief Get song or throw error, without hashing the name.
+      /// @param id Interned identifier.
+      /// @return Song.
+      const music_t& get_song(AssetId id) const;
 
       /// @brief Get font or throw error.
       /// @param identifier Identifier.
       /// @return Font.
-      const font_t& get_font(const std::string& identifier);
+      const font_t& get_font(std::string_view identifier) const;
+
+      /// @brief Get font or throw error, without hashing the name.
+      /// @param id Interned identifier.
+      /// @return Font.
+      const font_t& get_font(AssetId id) const;
 
       // Update functions
 
@@ -305,40 +553,60 @@ namespace cx
       /// @brief Check if texture exists.
       /// @param identifier Identifier.
       /// @return True if exists.
-      bool find_texture(const std::string& identifier) const;
+      bool find_texture(std::string_view identifier) const;
+
+      /// @brief Check if texture exists, without hashing the name.
+      /// @param id Interned identifier.
+      /// @return True if exists.
+      bool find_texture(AssetId id) const;
 
       /// @brief Check if sound exists.
       /// @param identifier Identifier.
       /// @return True if exists.
-      bool find_sound(const std::string& identifier) const;
+      bool find_sound(std::string_view identifier) const;
+
+      /// @brief Check if sound exists, without hashing the name.
+      /// @param id Interned identifier.
+      /// @return True if exists.
+      bool find_sound(AssetId id) const;
 
       /// @brief Check if song exists.
       /// @param identifier Identifier.
       /// @return True if exists.
-      bool find_song(const std::string& identifier) const;
+      bool find_song(std::string_view identifier) const;
+
+      /// @brief Check if song exists, without hashing the name.
+      /// @param id Interned identifier.
+      /// @return True if exists.
+      bool find_song(AssetId id) const;
 
       /// @brief Check if font exists.
       /// @param identifier Identifier.
       /// @return True if exists.
-      bool find_font(const std::string& identifier) const;
+      bool find_font(std::string_view identifier) const;
+
+      /// @brief Check if font exists, without hashing the name.
+      /// @param id Interned identifier.
+      /// @return True if exists.
+      bool find_font(AssetId id) const;
 
       // Unload functions
 
       /// @brief Unload a texture.
       /// @param identifier Identifier.
-      void unload_texture(const std::string& identifier);
+      void unload_texture(std::string_view identifier);
 
       /// @brief Unload a sound.
       /// @param identifier Identifier.
-      void unload_sound(const std::string& identifier);
+      void unload_sound(std::string_view identifier);
 
       /// @brief Unload a song.
       /// @param identifier Identifier.
-      void unload_song(const std::string& identifier);
+      void unload_song(std::string_view identifier);
 
       /// @brief Unload a font.
       /// @param identifier Identifier.
-      void unload_font(const std::string& identifier); 
+      void unload_font(std::string_view identifier);
 
       /// @brief Unload all textures.
       void unload_textures();
@@ -357,32 +625,189 @@ namespace cx
 
    private:
       /// @brief Texture extensions.
-      inline static const std::unordered_set<std::string> texture_extensions
-      {".bmp", ".dds", ".jpg", ".jpeg", ".png", ".tga", ".psd", ".gif", ".hdr", ".pic"};
+      inline static const std::unordered_set<std::string>& texture_extensions = extensions::texture;
 
       /// @brief Sound extensions.
-      inline static const std::unordered_set<std::string> sound_extensions
-      {".wav", ".ogg", ".flac", ".aiff", ".aif"};
+      inline static const std::unordered_set<std::string>& sound_extensions = extensions::sound;
 
       /// @brief Music extensions.
-      inline static const std::unordered_set<std::string> music_extensions
-      {".wav", ".ogg", ".flac", ".mid", ".midi"};
+      inline static const std::unordered_set<std::string>& music_extensions = extensions::music;
 
       /// @brief Font extensions.
-      inline static const std::unordered_set<std::string> font_extensions
-      {".ttf", ".otf", ".pfa", ".pfb", ".bmf"};
+      inline static const std::unordered_set<std::string>& font_extensions = extensions::font;
 
       fs::path root;
 
-      std::unordered_map<std::string, texture_t> textures;
-      std::unordered_map<std::string, sound_t>   sounds;
-      std::unordered_map<std::string, music_t>   music;
-      std::unordered_map<std::string, font_t>    fonts;
+      AssetTable<sf::Texture>     textures;
+      AssetTable<sf::SoundBuffer> sounds;
+      AssetTable<fs::path>        music;
+      AssetTable<sf::Font>        fonts;
+
+      std::unordered_map<std::string, atlas_t, StringHash, std::equal_to<>> atlases;
+      std::vector<atlas_t> atlas_order; ///< @brief Atlases in load order, searched for images.
 
       std::mutex texture_mutex;
       std::mutex sound_mutex;
       std::mutex music_mutex;
       std::mutex font_mutex;
+
+      /// @brief Shared state of one background load, completed once per file.
+      struct LoadJob
+      {
+         std::shared_ptr<LoadProgress> progress;
+         std::function<void(bool)> on_finished;
+
+         /// @brief Count a file as done, reports completion after the last one.
+         /// @param success Was the file loaded.
+         void complete(bool success) const;
+      };
+
+      using job_t = std::shared_ptr<const LoadJob>;
+
+      /// @brief Decoded image waiting to become a texture.
+      struct PendingUpload
+      {
+         std::string identifier;
+         fs::path path;
+         sf::Image image;
+         std::function<void(const texture_t&)> complete; ///< @brief Called with the texture, null if it failed.
+         std::shared_ptr<const AssetLoad> load;          ///< @brief Skipped once finished, null for directory loads.
+      };
+
+      /// @brief Load waiting for a loader thread.
+      struct LoadRequest
+      {
+         std::shared_ptr<AssetLoad> load;
+         std::function<void()> run;
+         size_t order = 0u;
+      };
+
+      std::vector<LoadRequest> requests;
+      std::mutex request_mutex;
+      size_t request_count = 0u;
+
+      std::vector<std::function<void()>> callbacks;
+      std::mutex callback_mutex;
+
+      std::atomic<bool> stopping {false};
+
+      std::vector<std::shared_ptr<const AssetPack>> packs;
+      mutable std::shared_mutex pack_mutex;
+
+      std::deque<PendingUpload> uploads;
+      mutable std::mutex upload_mutex;
+      sf::Time upload_time_budget = sf::milliseconds(2);
+      size_t upload_byte_budget = 0u;
+
+      /// @brief Threads loading in the background, last so it finishes its tasks before anything else is destroyed.
+      std::unique_ptr<ThreadPool> loader;
+
+      /// @brief Get threads loading in the background, created on first use.
+      /// @return Thread pool.
+      ThreadPool& get_loader();
+
+      /// @brief Collect files with given extensions in a directory.
+      /// @param directory Directory.
+      /// @param extensions Extensions to collect.
+      /// @param recursive Should subdirectories be searched.
+      /// @param paths Collected paths.
+      static void find_files(const fs::path& directory,
+                             const std::unordered_set<std::string>& extensions,
+                             bool recursive,
+                             std::vector<fs::path>& paths);
+
+      /// @brief Collect files of a kind in a directory from the mounted packs.
+      /// @param directory Full path to the directory.
+      /// @param kind Kind of asset to collect.
+      /// @param recursive Should subdirectories be searched.
+      /// @param paths Collected paths.
+      /// @return True if a pack contains the directory.
+      bool find_packed_files(const fs::path& directory,
+                             AssetPack::Kind kind,
+                             bool recursive,
+                             std::vector<fs::path>& paths) const;
+
+      /// @brief Collect files of a kind in a directory, from the mounted packs if one contains it.
+      /// @param directory Full path to the directory.
+      /// @param kind Kind of asset to collect.
+      /// @param extensions Extensions to collect from the file system.
+      /// @param recursive Should subdirectories be searched.
+      /// @return Collected paths.
+      std::vector<fs::path> collect_files(const fs::path& directory,
+                                          AssetPack::Kind kind,
+                                          const std::unordered_set<std::string>& extensions,
+                                          bool recursive) const;
+
+      /// @brief Load a texture, image or sound buffer from the mounted packs or the file system. Throws on failure.
+      /// @param asset Asset to load into.
+      /// @param path Full path to the file.
+      template<typename T>
+      void open_asset(T& asset, const fs::path& path) const;
+
+      /// @brief Load a font from the mounted packs or the file system. Throws on failure.
+      /// A packed font reads the pack while it lives, so it holds the pack.
+      /// @param path Full path to the file.
+      /// @return Font.
+      font_t open_font(const fs::path& path) const;
+
+      /// @brief Check a song from the mounted packs or the file system. Throws if it cannot be played.
+      /// @param path Full path to the file.
+      void check_song(const fs::path& path) const;
+
+      /// @brief Walk a directory on a loader thread, then load every file found as its own task.
+      /// @param on_finished Called when every file is done.
+      /// @param directory Full path to the directory.
+      /// @param recursive Should subdirectories be loaded.
+      /// @param kind Kind of asset to load from the mounted packs.
+      /// @param extensions Extensions to load from the file system.
+      /// @param load Function loading one file, throws on failure. Returns false if a later stage completes the file.
+      /// @return Progress of the load.
+      progress_t load_dir_async(const std::function<void(bool)>& on_finished,
+                                const fs::path& directory,
+                                bool recursive,
+                                AssetPack::Kind kind,
+                                const std::unordered_set<std::string>& extensions,
+                                std::function<bool(const fs::path&, const job_t&)> load);
+
+      /// @brief Queue a load, run by the next free loader thread in order of priority.
+      /// @param load Load state.
+      /// @param run Function loading the asset.
+      void submit_request(std::shared_ptr<AssetLoad> load, std::function<void()> run);
+
+      /// @brief Run the pending load with the highest priority.
+      void run_next_request();
+
+      /// @brief Load a sound, song or font in the background.
+      /// @param assets Assets of the type.
+      /// @param mutex Mutex guarding the assets.
+      /// @param identifier New identifier.
+      /// @param path Full path to the asset.
+      /// @param priority Priority.
+      /// @param on_finished Called by update when finished.
+      /// @param open Function creating the asset from a path, throws on failure.
+      /// @return Handle to the asset.
+      template<typename T>
+      AssetHandle<T> load_async(AssetTable<T>& assets,
+                                std::mutex& mutex,
+                                const std::string& identifier,
+                                const fs::path& path,
+                                int priority,
+                                const std::function<void(bool)>& on_finished,
+                                std::function<std::shared_ptr<T>(const fs::path&)> open);
+
+      /// @brief Finish a load and queue its callback for update.
+      /// @param load Load state, the asset has to be set before.
+      /// @param success Was the asset loaded.
+      void complete_load(AssetLoad& load, bool success);
+
+      /// @brief Queue a callback for update.
+      /// @param callback Callback.
+      void post(std::function<void()> callback);
+
+      /// @brief Create textures from decoded images.
+      /// @param budgeted Should the upload budget be respected.
+      /// @return Count of textures created.
+      size_t upload_textures(bool budgeted);
    };
 }
 
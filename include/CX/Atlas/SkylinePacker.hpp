@@ -0,0 +1,153 @@
+#ifndef CX_ATLAS_SKYLINE_PACKER_HPP
+#define CX_ATLAS_SKYLINE_PACKER_HPP
+
+#include "CX/Vector/Vec2.hpp"
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace cx
+{
+   /// @brief Pack rectangles into a fixed area using the skyline bottom-left heuristic.
+   /// Keeps the top edge of placed rectangles as a list of horizontal segments
+   /// and puts every rectangle where its top ends up lowest.
+   class SkylinePacker
+   {
+   public:
+      // Constructors
+
+      /// @brief Create a new packer.
+      /// @param size Size of the area.
+      SkylinePacker(const Vec2i& size)
+         : size(size), skyline {Segment {0, 0, size.x}} {}
+
+      // Pack functions
+
+      /// @brief Place a rectangle.
+      /// @param rect_size Size of the rectangle.
+      /// @return Top-left position, or nothing if it does not fit.
+      inline std::optional<Vec2i> insert(const Vec2i& rect_size)
+      {
+         if (rect_size.x <= 0 || rect_size.y <= 0 || rect_size.x > size.x || rect_size.y > size.y)
+            return std::nullopt;
+
+         size_t best_index = skyline.size();
+         int32_t best_top = std::numeric_limits<int32_t>::max();
+         int32_t best_width = std::numeric_limits<int32_t>::max();
+
+         for (size_t i = 0; i < skyline.size(); ++i)
+         {
+            const int32_t top = fit(i, rect_size);
+
+            // Lowest top first, narrowest segment to break ties
+            if (top >= 0 && (top < best_top || (top == best_top && skyline[i].width < best_width)))
+            {
+               best_index = i;
+               best_top = top;
+               best_width = skyline[i].width;
+            }
+         }
+
+         if (best_index == skyline.size())
+            return std::nullopt;
+
+         const Vec2i position (skyline[best_index].x, best_top);
+         place(best_index, position, rect_size);
+         return position;
+      }
+
+      /// @brief Remove all rectangles.
+      inline void clear()
+      {
+         skyline.assign(1u, Segment {0, 0, size.x});
+      }
+
+      // Getter functions
+
+      /// @brief Get size of the area.
+      /// @return Size.
+      inline const Vec2i& get_size() const
+      {
+         return size;
+      }
+
+   private:
+      /// @brief Horizontal part of the skyline.
+      struct Segment
+      {
+         int32_t x;
+         int32_t y;
+         int32_t width;
+      };
+
+      Vec2i size;
+      std::vector<Segment> skyline;
+
+      /// @brief Check where a rectangle fits starting at a segment.
+      /// @param index Index of the first segment.
+      /// @param rect_size Size of the rectangle.
+      /// @return Top of the rectangle, -1 if it does not fit.
+      inline int32_t fit(size_t index, const Vec2i& rect_size) const
+      {
+         if (skyline[index].x + rect_size.x > size.x)
+            return -1;
+
+         int32_t top = 0;
+         int32_t width_left = rect_size.x;
+
+         for (size_t i = index; width_left > 0; ++i)
+         {
+            top = std::max(top, skyline[i].y);
+            if (top + rect_size.y > size.y)
+               return -1;
+
+            width_left -= skyline[i].width;
+         }
+
+         return top;
+      }
+
+      /// @brief Raise the skyline over a placed rectangle.
+      /// @param index Index of the first segment under it.
+      /// @param position Position of the rectangle.
+      /// @param rect_size Size of the rectangle.
+      inline void place(size_t index, const Vec2i& position, const Vec2i& rect_size)
+      {
+         skyline.insert(skyline.begin() + index, Segment {position.x, position.y + rect_size.y, rect_size.x});
+
+         // Shrink or remove segments now covered by the rectangle
+         const int32_t right = position.x + rect_size.x;
+
+         for (size_t i = index + 1u; i < skyline.size(); )
+         {
+            if (skyline[i].x >= right)
+               break;
+
+            const int32_t cut = right - skyline[i].x;
+            if (cut < skyline[i].width)
+            {
+               skyline[i].x += cut;
+               skyline[i].width -= cut;
+               break;
+            }
+
+            skyline.erase(skyline.begin() + i);
+         }
+
+         // Merge neighbours at the same height
+         for (size_t i = 0; i + 1u < skyline.size(); )
+         {
+            if (skyline[i].y == skyline[i + 1u].y)
+            {
+               skyline[i].width += skyline[i + 1u].width;
+               skyline.erase(skyline.begin() + i + 1u);
+            }
+            else
+               ++i;
+         }
+      }
+   };
+}
+
+#endif
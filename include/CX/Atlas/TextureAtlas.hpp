@@ -0,0 +1,123 @@
+#ifndef CX_ATLAS_TEXTURE_ATLAS_HPP
+#define CX_ATLAS_TEXTURE_ATLAS_HPP
+
+#include <SFML/Graphics/Image.hpp>
+#include "CX/Atlas/TextureRegion.hpp"
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace cx
+{
+   /// @brief Pack many images into a few large textures so they can share draw calls.
+   class TextureAtlas
+   {
+   public:
+      using loader_t = std::function<void(sf::Image&, const fs::path&)>; ///< @brief Decodes an image or throws.
+
+      // Constructors
+
+      /// @brief Create a new texture atlas.
+      /// @param page_size Width and height of every page, clamped to the maximum texture size.
+      /// @param padding Empty pixels around every image, filled with its edge pixels.
+      TextureAtlas(unsigned page_size = 2048u, unsigned padding = 2u);
+
+      // Build functions
+
+      /// @brief Add an image to pack on the next build.
+      /// @param identifier Identifier.
+      /// @param path Path to the image.
+      void add(const std::string& identifier, const fs::path& path);
+
+      /// @brief Load and pack all added images.
+      /// When a layout file is given and still matches the added files, packing is skipped.
+      /// Otherwise the images are packed and the layout is written to it.
+      /// @param layout_path Path to the layout file, empty to always pack.
+      /// @param loader Decodes added images, empty to load them from the file system.
+      void build(const fs::path& layout_path = "", const loader_t& loader = nullptr);
+
+      /// @brief Remove all images and pages.
+      void clear();
+
+      // Getter functions
+
+      /// @brief Check if an image is in the atlas.
+      /// @param identifier Identifier.
+      /// @return True if found.
+      bool contains(const std::string& identifier) const;
+
+      /// @brief Get page and rectangle of an image or throw error.
+      /// @param identifier Identifier.
+      /// @return Texture region.
+      TextureRegion get_region(const std::string& identifier) const;
+
+      /// @brief Get a page.
+      /// @param index Index of the page.
+      /// @return Page texture.
+      const sf::Texture& get_page(size_t index) const;
+
+      /// @brief Get count of pages.
+      /// @return Page count.
+      size_t page_count() const;
+
+      /// @brief Get count of images.
+      /// @return Image count.
+      size_t size() const;
+
+      /// @brief Get width and height of every page.
+      /// @return Page size.
+      unsigned get_page_size() const;
+
+      /// @brief Get empty pixels around every image.
+      /// @return Padding.
+      unsigned get_padding() const;
+
+      /// @brief Check if the last build used the layout file instead of packing.
+      /// @return True if the layout was loaded.
+      bool is_layout_cached() const;
+
+   private:
+      /// @brief Image inside the atlas.
+      struct Entry
+      {
+         std::string identifier;
+         fs::path path;
+         sf::Image image;
+         size_t page = 0u;
+         Vec4i rect;
+      };
+
+      unsigned page_size;
+      unsigned padding;
+      bool layout_cached = false;
+
+      std::vector<Entry> entries;
+      std::vector<std::unique_ptr<sf::Texture>> pages;
+      std::unordered_map<std::string, size_t> lookup;
+
+      /// @brief Pack every entry into as few pages as possible.
+      /// @return Count of pages.
+      size_t pack();
+
+      /// @brief Read entry positions from a layout file.
+      /// @param layout_path Path to the layout file.
+      /// @return Count of pages, 0 if the file is missing or does not match the entries.
+      size_t load_layout(const fs::path& layout_path);
+
+      /// @brief Write entry positions to a layout file.
+      /// @param layout_path Path to the layout file.
+      /// @param count Count of pages.
+      void save_layout(const fs::path& layout_path, size_t count) const;
+
+      /// @brief Copy entries into page textures.
+      /// @param count Count of pages.
+      void create_pages(size_t count);
+   };
+}
+
+#endif
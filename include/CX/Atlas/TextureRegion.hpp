@@ -0,0 +1,37 @@
+#ifndef CX_ATLAS_TEXTURE_REGION_HPP
+#define CX_ATLAS_TEXTURE_REGION_HPP
+
+#include <SFML/Graphics/Texture.hpp>
+#include "CX/Vector/Vec4.hpp"
+
+namespace cx
+{
+   /// @brief Part of a texture, such as an image packed into a texture atlas page.
+   struct TextureRegion
+   {
+      // Constructors
+
+      /// @brief Create an empty region.
+      TextureRegion() = default;
+
+      /// @brief Create a region covering a whole texture.
+      /// @param texture Texture.
+      TextureRegion(const sf::Texture* texture)
+         : texture(texture)
+      {
+         if (texture != nullptr)
+            rect = Vec4i(0, 0, int32_t(texture->getSize().x), int32_t(texture->getSize().y));
+      }
+
+      /// @brief Create a new region.
+      /// @param texture Texture.
+      /// @param rect Rectangle inside the texture in pixels.
+      TextureRegion(const sf::Texture* texture, const Vec4i& rect)
+         : texture(texture), rect(rect) {}
+
+      const sf::Texture* texture = nullptr; ///< @brief Texture.
+      Vec4i rect;                           ///< @brief Rectangle inside the texture in pixels.
+   };
+}
+
+#endif
@@ -49,7 +49,7 @@ namespace cx
       
       /// @brief Play a saved sound.
       /// @param identifier Saved sound identifier.
-      void play_saved_sound(const std::string& identifier);
+      void play_saved_sound(std::string_view identifier);
 
       /// @brief Play a sound.
       /// @param identifier Asset identifier.
@@ -61,6 +61,16 @@ namespace cx
                       float min_pitch = 1.f,
                       float max_pitch = 1.f);
 
+      /// @brief Play a sound without hashing its name.
+      /// @param id Interned asset identifier.
+      /// @param max_duplicates Maximum amount of identical sounds.
+      /// @param min_pitch Minimum pitch and playback speed.
+      /// @param max_pitch Maximum pitch and playback speed.
+      void play_sound(AssetId id,
+                      unsigned char max_duplicates = 255,
+                      float min_pitch = 1.f,
+                      float max_pitch = 1.f);
+
       /// @brief Play a random sound.
       /// @param identifier Asset identifiers.
       /// @param max_duplicates Maximum amount of identical sounds.
@@ -144,7 +154,7 @@ namespace cx
       /// @brief Check if a saved sound exists.
       /// @param name Name of the sound.
       /// @return True if exists.
-      bool contains_saved_sound(const std::string& name) const;
+      bool contains_saved_sound(std::string_view name) const;
 
       /// @brief Check if the music pool contains a song.
       /// @param name Name of the song.
@@ -155,22 +165,37 @@ namespace cx
       /// @brief Save sounds.
       struct AudioManagerSound
       {
-         std::vector<std::string> identifiers;
+         std::vector<AssetId> identifiers;
          unsigned char duplicate_count {255};
          float min_pitch {1.f};
          float max_pitch {1.f};
       };
 
       cx::AssetManager& asset;
+      AssetManager::PackedFile song_data; ///< @brief Packed data streamed by the current song, outlives it.
       sf::Music current_song;
       std::vector<std::string> song_pool;
       std::vector<std::shared_ptr<sf::Sound>> active_sounds;
-      std::unordered_map<std::string, AudioManagerSound> saved_sounds;
+      std::unordered_map<std::string, AudioManagerSound, StringHash, std::equal_to<>> saved_sounds;
 
       bool shuffle_music {};
       float sound_volume {100.f};
       float music_volume {100.f};
       size_t music_index {0};
+
+      /// @brief Play a sound buffer unless too many copies are playing.
+      /// @param buffer Sound buffer.
+      /// @param max_duplicates Maximum amount of identical sounds.
+      /// @param min_pitch Minimum pitch and playback speed.
+      /// @param max_pitch Maximum pitch and playback speed.
+      void play_buffer(const sf::SoundBuffer& buffer,
+                       unsigned char max_duplicates,
+                       float min_pitch,
+                       float max_pitch);
+
+      /// @brief Open a song for streaming, from its mounted pack if it is packed.
+      /// @param identifier Song identifier.
+      void open_song(const std::string& identifier);
    };
 }
 
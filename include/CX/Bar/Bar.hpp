@@ -1,9 +1,10 @@
 #ifndef CX_BAR_BAR_HPP
 #define CX_BAR_BAR_HPP
 
-#include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/Shader.hpp>
 #include "CX/Bar/BarStyle.hpp"
+#include "CX/Render/FillMode.hpp"
+#include "CX/Render/Quad.hpp"
 #include "CX/UIElement/UIElement.hpp"
 
 namespace cx
@@ -133,6 +134,15 @@ namespace cx
       /// @param percent Progress 0 to 100.
       void set_progress_percent(char percent);
 
+      /// @brief Change direction the bar fills in.
+      /// @param mode Fill mode.
+      void set_fill_mode(FillMode mode);
+
+      /// @brief Clip textured left to right fills with the shared clipping shader instead of geometry.
+      /// Costs a shader switch per bar and cannot be batched.
+      /// @param enabled Should the shader be used.
+      void set_shader_clipping(bool enabled);
+
       // Getter functions
 
       /// @brief Get bar type.
@@ -195,6 +205,14 @@ namespace cx
       /// @return Progress.
       char get_progress_percent() const;
 
+      /// @brief Get direction the bar fills in.
+      /// @return Fill mode.
+      FillMode get_fill_mode() const;
+
+      /// @brief Check if textured fills are clipped with the shared clipping shader.
+      /// @return True if the shader is used.
+      bool is_shader_clipping() const;
+
       // Update functions
 
       /// @brief Increment bar progress.
@@ -243,32 +261,43 @@ namespace cx
       // Render functions
 
       /// @brief Render the bar.
-      /// @param window Window to draw to.
-      void render(sf::RenderWindow& window) const override;
+      /// @param target Target to draw to.
+      void render(sf::RenderTarget& target) const override;
 
       /// @brief Render the bar.
-      /// @param window Window to draw to.
+      /// @param target Target to draw to.
       /// @param shader Shader.
-      void render(sf::RenderWindow& window, const sf::Shader* shader) const override;
+      void render(sf::RenderTarget& target, const sf::Shader* shader) const override;
+
+      /// @brief Submit the bar to a render batch.
+      /// @param batch Render batch.
+      /// @param layer Layer.
+      void submit(RenderBatch& batch, int layer = 0) const override;
 
       // Access functions
 
       /// @brief Get foreground.
       /// @return Foreground.
-      sf::RectangleShape& get_foreground();
+      Quad& get_foreground();
 
       /// @brief Get background.
       /// @return Background.
-      sf::RectangleShape& get_background();
+      Quad& get_background();
 
    private:
-      sf::Shader clip_shader;
-      sf::RectangleShape background;
-      sf::RectangleShape foreground;
+      Quad background;
+      Quad foreground;
       float bar_progress = 1.f;
+      FillMode fill_mode = FillMode::left_to_right;
+      bool shader_clipping = false;
 
       /// @brief Update bar.
       void updateBar();
+
+      /// @brief Draw the foreground cut to the progress.
+      /// @param target Target to draw to.
+      /// @param shader Shader.
+      void render_foreground(sf::RenderTarget& target, const sf::Shader* shader) const;
    };
 }
 
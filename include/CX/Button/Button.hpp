@@ -1,10 +1,11 @@
 #ifndef CX_BUTTON_BUTTON_HPP
 #define CX_BUTTON_BUTTON_HPP
 
-#include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/Text.hpp>
 #include "CX/Button/ButtonStyle.hpp"
+#include "CX/Render/Quad.hpp"
 #include "CX/Text/FontStyle.hpp"
+#include "CX/Text/GlyphRun.hpp"
 #include "CX/UIElement/UIElement.hpp"
 
 namespace cx
@@ -229,19 +230,24 @@ namespace cx
       // Render functions
 
       /// @brief Render the button.
-      /// @param window Window to draw to.
-      void render(sf::RenderWindow& window) const override;
+      /// @param target Target to draw to.
+      void render(sf::RenderTarget& target) const override;
 
       /// @brief Render the button.
-      /// @param window Window to draw to.
+      /// @param target Target to draw to.
       /// @param shader Shader.
-      void render(sf::RenderWindow& window, const sf::Shader* shader) const override;
+      void render(sf::RenderTarget& target, const sf::Shader* shader) const override;
+
+      /// @brief Submit the button to a render batch.
+      /// @param batch Render batch.
+      /// @param layer Layer.
+      void submit(RenderBatch& batch, int layer = 0) const override;
 
       // Access functions
 
       /// @brief Get background.
       /// @return Background.
-      sf::RectangleShape& get_background();
+      Quad& get_background();
 
       /// @brief Get text.
       /// @return Text.
@@ -249,8 +255,9 @@ namespace cx
 
    private:
       bool button_disabled = false;
-      sf::RectangleShape rect;
+      Quad rect;
       sf::Text text;
+      mutable GlyphRun glyphs;
 
       /// @brief Recenter text.
       void recenter(); 
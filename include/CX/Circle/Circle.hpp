@@ -156,13 +156,18 @@ namespace cx
       // Render functions
 
       /// @brief Render the circle.
-      /// @param window Window to draw to.
-      void render(sf::RenderWindow& window) const override;
+      /// @param target Target to draw to.
+      void render(sf::RenderTarget& target) const override;
 
       /// @brief Render the circle.
-      /// @param window Window to draw to.
+      /// @param target Target to draw to.
       /// @param shader Shader.
-      void render(sf::RenderWindow& window, const sf::Shader* shader) const override;
+      void render(sf::RenderTarget& target, const sf::Shader* shader) const override;
+
+      /// @brief Submit the circle to a render batch.
+      /// @param batch Render batch.
+      /// @param layer Layer.
+      void submit(RenderBatch& batch, int layer = 0) const override;
 
       // Access functions
 
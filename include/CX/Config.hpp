@@ -5,10 +5,6 @@
 #error "CX library requires the C++ standard to be atleast C++20."
 #endif
 
-#ifndef CX_SHADER_PATH
-#define CX_SHADER_PATH "../shaders/"
-#endif
-
 #ifdef NDEBUG
 #define CX_RELEASE
 #else
@@ -32,4 +28,8 @@
    #define CX_UNKNOWN_OS
 #endif
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+   #define CX_X86
+#endif
+
 #endif
@@ -28,9 +28,9 @@ namespace cx::errors
       static constexpr const char* invalid_font = "'Text'/'Button' uninitialized font. Sources: 'Text', 'Button' or 'set_font'.";
    }
 
-   namespace slider
+   namespace shader
    {
-      static constexpr const char* could_not_load_shader = "'Slider' Could not load clipping_shader.frag. Source: 'Slider'.";
+      static constexpr const char* could_not_compile = "'Shaders' could not compile embedded shader '{}'. Sources: 'Bar', 'Slider' or 'get_clipping_shader'.";
    }
 
    namespace asset
@@ -44,6 +44,21 @@ namespace cx::errors
       static constexpr const char* invalid_extension    = "'AssetManager' could not update asset '{}' as it has an invalid extension '{}'. Sources: 'insert', 'load' or 'update'.";
    }
 
+   namespace pack
+   {
+      static constexpr const char* cannot_open_pack  = "'AssetPack' could not open pack '{}'. Source: 'open'.";
+      static constexpr const char* invalid_pack      = "'AssetPack' file '{}' is not a valid pack. Source: 'open'.";
+      static constexpr const char* cannot_write_pack = "'AssetPack' could not write pack '{}'. Source: 'write'.";
+   }
+
+   namespace atlas
+   {
+      static constexpr const char* cannot_load_image    = "'TextureAtlas' could not load image '{}'. Source: 'build'.";
+      static constexpr const char* image_too_large      = "'TextureAtlas' image '{}' does not fit on a {}x{} page. Source: 'build'.";
+      static constexpr const char* image_does_not_exist = "'TextureAtlas' could not get image '{}' as it does not exist. Source: 'get_region'.";
+      static constexpr const char* cannot_create_page   = "'TextureAtlas' could not create a {}x{} page. Source: 'build'.";
+   }
+
    namespace audio
    {
       static constexpr const char* sound_doesnot_exist   = "'AudioManager' could not play sound '{}' as it does not exist. Sources: 'play_saved_sound', 'play_sound' or 'play_random_sound'.";
@@ -0,0 +1,187 @@
+#ifndef CX_MATH_BULK_RANDOM_HPP
+#define CX_MATH_BULK_RANDOM_HPP
+
+#include "CX/Color.hpp"
+#include "CX/Math/Constants.hpp"
+#include "CX/Math/Random.hpp"
+#include "CX/Vector/Vec2.hpp"
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+namespace cx
+{
+   /// @brief Fill whole arrays with random values.
+   /// Runs 8 xoshiro128+ generators side by side in structure-of-arrays form,
+   /// so every step produces 8 values with plain loops the compiler turns into SIMD.
+   class BulkRandom
+   {
+   public:
+      static constexpr size_t lanes = 8u; ///< @brief Values generated per step.
+
+      // Constructors
+
+      /// @brief Create a generator seeded from the random engine of the current thread.
+      BulkRandom()
+      {
+         seed((uint64_t(random_engine()()) << 32u) | random_engine()());
+      }
+
+      /// @brief Create a new generator.
+      /// @param seed Seed.
+      BulkRandom(uint64_t seed)
+      {
+         this->seed(seed);
+      }
+
+      // Setter functions
+
+      /// @brief Restart the generator.
+      /// @param seed Seed.
+      inline void seed(uint64_t seed)
+      {
+         // Expand the seed with splitmix64 so no lane starts all zero
+         for (size_t lane = 0; lane < lanes; ++lane)
+         {
+            for (size_t word = 0; word < 4u; word += 2u)
+            {
+               seed += 0x9e3779b97f4a7c15ULL;
+               uint64_t z = seed;
+               z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9ULL;
+               z = (z ^ (z >> 27u)) * 0x94d049bb133111ebULL;
+               z ^= z >> 31u;
+
+               state[word][lane] = static_cast<uint32_t>(z);
+               state[word + 1u][lane] = static_cast<uint32_t>(z >> 32u) | 1u;
+            }
+         }
+      }
+
+      // Fill functions
+
+      /// @brief Fill with uniform floats.
+      /// @param out Values to fill.
+      /// @param min Minimum value.
+      /// @param max Maximum value.
+      inline void fill(std::span<float> out, float min = 0.f, float max = 1.f)
+      {
+         generate(out.size(), [&](size_t i, const float* u) { out[i] = min + (max - min) * u[0]; }, 1u);
+      }
+
+      /// @brief Fill with uniform vectors.
+      /// @param out Values to fill.
+      /// @param min Minimum values.
+      /// @param max Maximum values.
+      inline void fill(std::span<Vec2f> out, const Vec2f& min, const Vec2f& max)
+      {
+         const Vec2f range = max - min;
+         generate(out.size(), [&](size_t i, const float* u)
+         {
+            out[i] = Vec2f(min.x + range.x * u[0], min.y + range.y * u[1]);
+         }, 2u);
+      }
+
+      /// @brief Fill with uniform colors, each channel between the channels of min and max.
+      /// @param out Values to fill.
+      /// @param min Minimum channels.
+      /// @param max Maximum channels.
+      inline void fill(std::span<Color> out, const Color& min, const Color& max)
+      {
+         generate(out.size(), [&](size_t i, const float* u)
+         {
+            out[i] = Color(channel(min.r, max.r, u[0]), channel(min.g, max.g, u[1]),
+                           channel(min.b, max.b, u[2]), channel(min.a, max.a, u[3]));
+         }, 4u);
+      }
+
+      /// @brief Fill with points spread evenly over a disk or annulus.
+      /// @param out Values to fill.
+      /// @param center Center of the disk.
+      /// @param radius_min Inner radius, 0 for a full disk.
+      /// @param radius_max Outer radius.
+      inline void fill_disk(std::span<Vec2f> out, const Vec2f& center, float radius_min, float radius_max)
+      {
+         // Square radii are uniform in area
+         const float inner = radius_min * radius_min;
+         const float outer = radius_max * radius_max;
+
+         generate(out.size(), [&](size_t i, const float* u)
+         {
+            const float angle = u[0] * Constants<float>::two_pi;
+            const float radius = std::sqrt(inner + (outer - inner) * u[1]);
+            out[i] = Vec2f(center.x + std::cos(angle) * radius, center.y + std::sin(angle) * radius);
+         }, 2u);
+      }
+
+      /// @brief Fill with normally distributed floats.
+      /// @param out Values to fill.
+      /// @param mean Mean.
+      /// @param deviation Standard deviation.
+      inline void fill_normal(std::span<float> out, float mean = 0.f, float deviation = 1.f)
+      {
+         // Box-Muller, one pair of uniforms per value
+         generate(out.size(), [&](size_t i, const float* u)
+         {
+            const float radius = std::sqrt(-2.f * std::log(1.f - u[0]));
+            out[i] = mean + deviation * radius * std::cos(u[1] * Constants<float>::two_pi);
+         }, 2u);
+      }
+
+   private:
+      alignas(32) uint32_t state[4][lanes] {};
+
+      /// @brief Step every lane once.
+      /// @param out Uniform floats in [0, 1), one per lane.
+      inline void next(float* out)
+      {
+         for (size_t lane = 0; lane < lanes; ++lane)
+         {
+            const uint32_t result = state[0][lane] + state[3][lane];
+            const uint32_t t = state[1][lane] << 9u;
+
+            state[2][lane] ^= state[0][lane];
+            state[3][lane] ^= state[1][lane];
+            state[1][lane] ^= state[2][lane];
+            state[0][lane] ^= state[3][lane];
+            state[2][lane] ^= t;
+            state[3][lane] = (state[3][lane] << 11u) | (state[3][lane] >> 21u);
+
+            // Low bits of xoshiro128+ are weak, use the top 24
+            out[lane] = float(result >> 8u) * 0x1p-24f;
+         }
+      }
+
+      /// @brief Call a function for every output with the uniforms it needs.
+      /// @param count Count of outputs.
+      /// @param func Function taking the output index and its uniforms.
+      /// @param per_value Uniforms needed per output, at most 4.
+      template<typename Func>
+      inline void generate(size_t count, Func&& func, size_t per_value)
+      {
+         alignas(32) float uniforms[lanes * 4u];
+         const size_t per_block = lanes * 4u / per_value;
+
+         for (size_t begin = 0; begin < count; begin += per_block)
+         {
+            for (size_t step = 0; step < 4u; ++step)
+               next(uniforms + step * lanes);
+
+            const size_t end = std::min(begin + per_block, count);
+            for (size_t i = begin; i < end; ++i)
+               func(i, uniforms + (i - begin) * per_value);
+         }
+      }
+
+      /// @brief Get a color channel between two channels.
+      /// @param a First channel.
+      /// @param b Second channel.
+      /// @param u Uniform float.
+      /// @return Channel.
+      static inline unsigned char channel(unsigned char a, unsigned char b, float u)
+      {
+         return static_cast<unsigned char>(float(a) + (float(b) - float(a)) * u + .5f);
+      }
+   };
+}
+
+#endif
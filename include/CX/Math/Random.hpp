@@ -2,111 +2,309 @@
 #define CX_MATH_RANDOM_HPP
 
 #include "CX/Concepts.hpp"
-#include <random>
+#include <atomic>
+#include <cstdint>
 #include <ctime>
+#include <limits>
+#include <random>
 
 namespace cx
 {
+   /// @brief Small and fast random generator (PCG32).
+   /// 16 bytes of state, satisfies the standard uniform random bit generator requirements.
+   class Pcg32
+   {
+   public:
+      using result_type = uint32_t;
+
+      static constexpr uint64_t default_seed   = 0x853c49e6748fea9bULL; ///< @brief Default seed.
+      static constexpr uint64_t default_stream = 0xda3e39cb94b95bdbULL; ///< @brief Default stream.
+
+      // Constructors
+
+      /// @brief Create a generator with the default seed.
+      constexpr Pcg32()
+      {
+         seed(default_seed, default_stream);
+      }
+
+      /// @brief Create a new generator.
+      /// @param seed Seed.
+      /// @param stream Stream, generators with the same seed and different streams do not overlap.
+      constexpr Pcg32(uint64_t seed, uint64_t stream = default_stream)
+      {
+         this->seed(seed, stream);
+      }
+
+      // Setter functions
+
+      /// @brief Restart the generator.
+      /// @param seed Seed.
+      /// @param stream Stream, generators with the same seed and different streams do not overlap.
+      constexpr void seed(uint64_t seed, uint64_t stream = default_stream)
+      {
+         state = 0u;
+         increment = (stream << 1u) | 1u;
+         (*this)();
+         state += seed;
+         (*this)();
+      }
+
+      // Generate functions
+
+      /// @brief Generate the next 32 random bits.
+      /// @return Random bits.
+      constexpr result_type operator()()
+      {
+         const uint64_t old = state;
+         state = old * 6364136223846793005ULL + increment;
+
+         const uint32_t shifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+         const uint32_t rotation = static_cast<uint32_t>(old >> 59u);
+         return (shifted >> rotation) | (shifted << ((~rotation + 1u) & 31u));
+      }
+
+      /// @brief Create an independent generator seeded and streamed from this one.
+      /// @return New generator.
+      constexpr Pcg32 split()
+      {
+         const uint64_t seed = (uint64_t((*this)()) << 32u) | (*this)();
+         const uint64_t stream = (uint64_t((*this)()) << 32u) | (*this)();
+         return Pcg32(seed, stream);
+      }
+
+      /// @brief Generate a random integer in [0, range). Unbiased.
+      /// @param range Range, 0 for all 32 bits.
+      /// @return Random integer.
+      constexpr uint32_t bounded(uint32_t range)
+      {
+         if (range == 0u)
+            return (*this)();
+
+         // Multiply and reject the biased low part (Lemire)
+         uint64_t product = uint64_t((*this)()) * range;
+         uint32_t low = static_cast<uint32_t>(product);
+
+         if (low < range)
+         {
+            const uint32_t threshold = (~range + 1u) % range;
+
+            while (low < threshold)
+            {
+               product = uint64_t((*this)()) * range;
+               low = static_cast<uint32_t>(product);
+            }
+         }
+
+         return static_cast<uint32_t>(product >> 32u);
+      }
+
+      /// @brief Generate a random integer.
+      /// @param min Minimum value.
+      /// @param max Maximum value.
+      /// @return Random integer in [min, max].
+      template<Integral T = int>
+      constexpr T randi(T min = T(0), T max = T(1))
+      {
+         const uint64_t range = uint64_t(max) - uint64_t(min);
+
+         if (range <= std::numeric_limits<uint32_t>::max())
+            return static_cast<T>(uint64_t(min) + bounded(static_cast<uint32_t>(range + 1u)));
+
+         return std::uniform_int_distribution<T>(min, max)(*this);
+      }
+
+      /// @brief Generate a random float.
+      /// @param min Minimum value.
+      /// @param max Maximum value.
+      /// @return Random float in [min, max).
+      template<Floating T = float>
+      constexpr T randf(T min = T(0), T max = T(1))
+      {
+         if constexpr (sizeof(T) <= sizeof(float))
+            return min + (max - min) * (T((*this)() >> 8u) * T(0x1p-24f));
+         else
+         {
+            const uint64_t bits = (uint64_t((*this)()) << 32u) | (*this)();
+            return min + (max - min) * (T(bits >> 11u) * T(0x1p-53));
+         }
+      }
+
+      /// @brief Generate a random boolean.
+      /// @return Random boolean.
+      constexpr bool randb()
+      {
+         return ((*this)() >> 31u) != 0u;
+      }
+
+      // Getter functions
+
+      /// @brief Get minimum generated value.
+      /// @return Minimum value.
+      static constexpr result_type min()
+      {
+         return 0u;
+      }
+
+      /// @brief Get maximum generated value.
+      /// @return Maximum value.
+      static constexpr result_type max()
+      {
+         return std::numeric_limits<result_type>::max();
+      }
+
+   private:
+      uint64_t state = 0u;
+      uint64_t increment = 0u;
+   };
+
+   /// @brief Seed shared by the random engines of every thread.
+   struct RandomSeed
+   {
+      std::atomic<uint64_t> seed {0u};         ///< @brief Seed.
+      std::atomic<uint64_t> next_stream {0u};  ///< @brief Stream of the next thread to reseed.
+      std::atomic<uint32_t> generation {0u};   ///< @brief Bumped on every seed, 0 if never seeded.
+   };
+
+   /// @brief Get seed shared by the random engines of every thread.
+   /// @return Random seed.
+   inline RandomSeed& get_random_seed()
+   {
+      static RandomSeed seed;
+      return seed;
+   }
+
+   /// @brief Get random engine of the current thread.
+   /// Seeded from the system until seed is called, after which every thread
+   /// reseeds on its next use with the shared seed and its own stream.
+   /// @return Random engine.
+   inline Pcg32& random_engine()
+   {
+      static thread_local Pcg32 engine = []
+      {
+         std::random_device device;
+         return Pcg32((uint64_t(device()) << 32u) | device(), (uint64_t(device()) << 32u) | device());
+      }();
+      static thread_local uint32_t generation = 0u;
+
+      RandomSeed& seed = get_random_seed();
+      const uint32_t current = seed.generation.load(std::memory_order_acquire);
+
+      if (generation != current)
+      {
+         generation = current;
+         engine.seed(seed.seed.load(std::memory_order_relaxed), seed.next_stream++);
+      }
+
+      return engine;
+   }
+
+   /// @brief Seed the random engines of every thread, making random numbers reproducible.
+   /// The calling thread gets the first stream, other threads get the next ones in order of use.
+   /// @param seed Seed.
+   inline void seed(uint64_t seed)
+   {
+      RandomSeed& random_seed = get_random_seed();
+      random_seed.seed.store(seed, std::memory_order_relaxed);
+      random_seed.next_stream = 0u;
+      random_seed.generation.fetch_add(1u, std::memory_order_release);
+
+      random_engine();
+   }
+
    /// @brief Seed the current time.
    inline void seed_random()
    {
-      srand(time(nullptr));
+      seed(static_cast<uint64_t>(time(nullptr)));
    }
-   
-   /// @brief Seed the random.
-   /// @param seed Seed.
-   inline void seed(uint32_t seed)
+
+   /// @brief Check if random numbers are reproducible.
+   /// @return True if seeded.
+   inline bool is_random_deterministic()
+   {
+      return get_random_seed().generation.load(std::memory_order_acquire) != 0u;
+   }
+
+   /// @brief Create an independent random engine from the engine of the current thread.
+   /// Use one per job to keep parallel randomness reproducible.
+   /// @return Random engine.
+   inline Pcg32 split_random_engine()
    {
-      srand(seed);
+      return random_engine().split();
    }
 
-   /// @brief Generate a random integer. Requires to be seeded.
+   /// @brief Generate a random integer.
    /// @param min Minimum value.
    /// @param max Maximum value.
    /// @return Randomly generated integer.
    template<Integral T = int>
    inline T randi(T min = T(0), T max = T(1))
    {
-      return min + (rand() % (max - min + 1));
+      return random_engine().randi<T>(min, max);
    }
 
-   /// @brief Generate a random float. Requires to be seeded.
+   /// @brief Generate a random float.
    /// @param min Minimum value.
    /// @param max Maximum value.
    /// @return Randomly generated float.
    template<Floating T = float>
    inline T randf(T min = T(0), T max = T(1))
    {
-      return min + static_cast<T>(rand()) / static_cast<T>(RAND_MAX / (max - min));
+      return random_engine().randf<T>(min, max);
    }
 
-   /// @brief Generate a random boolean. Requires to be seeded.
+   /// @brief Generate a random boolean.
    /// @return Randomly generated boolean.
    inline bool randb()
    {
-      return static_cast<bool>(rand() % 2);
+      return random_engine().randb();
    }
 
-   /// @brief Generate a random integer. Unseeded.
+   /// @brief Generate a random integer.
    /// @param min Minimum value.
    /// @param max Maximum value.
    /// @return Randomly generated integer.
    template<Integral T = int>
    inline T randiu(T min = T(0), T max = T(1))
    {
-      static thread_local std::random_device rd;
-      static thread_local std::mt19937 generator(rd());
-      std::uniform_int_distribution<T> dist(min, max);
-      return dist(generator);
+      return random_engine().randi<T>(min, max);
    }
 
-   /// @brief Generate a random float. Unseeded.
+   /// @brief Generate a random float.
    /// @param min Minimum value.
    /// @param max Maximum value.
    /// @return Randomly generated float.
    template<Floating T = float>
    inline T randfu(T min = T(0), T max = T(1))
    {
-      static thread_local std::random_device rd;
-      static thread_local std::mt19937 generator(rd());
-      std::uniform_real_distribution<T> dist(min, max);
-      return dist(generator);
+      return random_engine().randf<T>(min, max);
    }
 
-   /// @brief Generate a random boolean. Unseeded.
+   /// @brief Generate a random boolean.
    /// @return Randomly generated boolean.
    inline bool randbu()
    {
-      static thread_local std::random_device rd;
-      static thread_local std::mt19937 generator(rd());
-      std::uniform_int_distribution<uint8_t> dist(0, 1);
-      return static_cast<bool>(dist(generator));
+      return random_engine().randb();
    }
 
-   /// @brief Generate a random number. Unseeded.
+   /// @brief Generate a random number.
    /// @param min Minimum value.
    /// @param max Maximum value.
    /// @return Randomly generated number.
    template<Floating T = float>
    inline T random(T min = T(0), T max = T(1))
    {
-      static thread_local std::random_device rd;
-      static thread_local std::mt19937 generator(rd());
-      std::uniform_real_distribution<T> dist(min, max);
-      return dist(generator);
+      return random_engine().randf<T>(min, max);
    }
 
-   /// @brief Generate a random number. Unseeded.
+   /// @brief Generate a random number.
    /// @param min Minimum value.
    /// @param max Maximum value.
    /// @return Randomly generated number.
    template<Integral T = int>
    inline T random(T min = T(0), T max = T(1))
    {
-      static thread_local std::random_device rd;
-      static thread_local std::mt19937 generator(rd());
-      std::uniform_int_distribution<T> dist(min, max);
-      return dist(generator);
+      return random_engine().randi<T>(min, max);
    }
 }
 
@@ -0,0 +1,128 @@
+#ifndef CX_PARTICLE_LIFETIME_CURVE_HPP
+#define CX_PARTICLE_LIFETIME_CURVE_HPP
+
+#include "CX/Color.hpp"
+#include <algorithm>
+#include <array>
+#include <type_traits>
+#include <vector>
+
+namespace cx
+{
+   /// @brief Value of a lifetime curve at a point of particle life.
+   /// @tparam T Value type.
+   template<typename T>
+   struct CurveKey
+   {
+      float time = 0.f; ///< @brief Point of life from 0 (spawn) to 1 (death).
+      T value {};       ///< @brief Value at that point.
+   };
+
+   /// @brief Value over particle lifetime, baked into a lookup table.
+   /// Keys are linearly interpolated once when set, sampling is a single table fetch.
+   /// @tparam T Value type, float or Color.
+   template<typename T>
+   class LifetimeCurve
+   {
+   public:
+      static constexpr size_t resolution = 64u; ///< @brief Lookup table size.
+
+      // Constructors
+
+      /// @brief Create an empty curve.
+      LifetimeCurve() = default;
+
+      /// @brief Create a new curve.
+      /// @param keys Curve keys.
+      LifetimeCurve(const std::vector<CurveKey<T>>& keys)
+      {
+         set_keys(keys);
+      }
+
+      // Setter functions
+
+      /// @brief Set curve keys and rebuild the lookup table.
+      /// @param keys Curve keys, in any order. Empty to clear the curve.
+      inline void set_keys(std::vector<CurveKey<T>> keys)
+      {
+         std::stable_sort(keys.begin(), keys.end(),
+                          [](const CurveKey<T>& a, const CurveKey<T>& b) { return a.time < b.time; });
+         this->keys = std::move(keys);
+
+         if (this->keys.empty())
+            return;
+
+         size_t key = 0u;
+         for (size_t i = 0; i < resolution; ++i)
+         {
+            const float time = float(i) / float(resolution - 1u);
+
+            while (key + 1u < this->keys.size() && this->keys[key + 1u].time < time)
+               ++key;
+
+            const CurveKey<T>& from = this->keys[key];
+            const CurveKey<T>& to = this->keys[std::min(key + 1u, this->keys.size() - 1u)];
+            const float span = to.time - from.time;
+            const float t = span > 0.f ? std::clamp((time - from.time) / span, 0.f, 1.f) : 0.f;
+
+            table[i] = interpolate(from.value, to.value, t);
+         }
+      }
+
+      /// @brief Remove all keys.
+      inline void clear()
+      {
+         keys.clear();
+      }
+
+      // Getter functions
+
+      /// @brief Check if the curve has no keys.
+      /// @return True if empty.
+      inline bool empty() const
+      {
+         return keys.empty();
+      }
+
+      /// @brief Get curve keys.
+      /// @return Keys sorted by time.
+      inline const std::vector<CurveKey<T>>& get_keys() const
+      {
+         return keys;
+      }
+
+      /// @brief Get value at a point of life.
+      /// @param life Age divided by lifetime, clamped to [0, 1].
+      /// @return Value.
+      inline const T& sample(float life) const
+      {
+         const float index = life * float(resolution - 1u) + .5f;
+
+         if (!(index > 0.f))
+            return table.front();
+         if (index >= float(resolution - 1u))
+            return table.back();
+
+         return table[size_t(index)];
+      }
+
+   private:
+      std::vector<CurveKey<T>> keys;
+      std::array<T, resolution> table {};
+
+      /// @brief Interpolate between two values.
+      /// @param a First value.
+      /// @param b Second value.
+      /// @param t Interpolation strength.
+      /// @return Interpolated value.
+      static inline T interpolate(const T& a, const T& b, float t)
+      {
+         if constexpr (std::is_same_v<T, Color>)
+            return a.blend(b, t);
+         else
+            return a + (b - a) * t;
+      }
+   };
+}
+
+#endif
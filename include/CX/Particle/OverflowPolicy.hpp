@@ -0,0 +1,14 @@
+#ifndef CX_PARTICLE_OVERFLOW_POLICY_HPP
+#define CX_PARTICLE_OVERFLOW_POLICY_HPP
+
+namespace cx
+{
+   /// @brief What to do when a particle is spawned while the pool is full.
+   enum class OverflowPolicy : char
+   {
+      drop_new,      ///< @brief Do not spawn the new particle.
+      recycle_oldest ///< @brief Replace the oldest particle with the new one.
+   };
+}
+
+#endif
@@ -0,0 +1,211 @@
+#ifndef CX_PARTICLE_PARTICLE_HPP
+#define CX_PARTICLE_PARTICLE_HPP
+
+#include "CX/Particle/ParticleStorage.hpp"
+#include <iterator>
+
+namespace cx
+{
+   /// @brief View of a single particle inside particle storage.
+   /// @tparam Storage Particle storage, const for read-only access.
+   template<typename Storage>
+   class BasicParticle
+   {
+   public:
+      // Constructors
+
+      /// @brief Create a new particle view.
+      /// @param storage Particle storage.
+      /// @param index Index of the particle.
+      constexpr BasicParticle(Storage& storage, size_t index)
+         : storage(&storage), i(index) {}
+
+      // Access functions
+
+      /// @brief Get index of the particle.
+      /// @return Index.
+      constexpr size_t index() const
+      {
+         return i;
+      }
+
+      /// @brief Get center position.
+      /// @return Position.
+      constexpr auto& position() const
+      {
+         return storage->position[i];
+      }
+
+      /// @brief Get velocity.
+      /// @return Velocity.
+      constexpr auto& velocity() const
+      {
+         return storage->velocity[i];
+      }
+
+      /// @brief Get acceleration.
+      /// @return Acceleration.
+      constexpr auto& acceleration() const
+      {
+         return storage->acceleration[i];
+      }
+
+      /// @brief Get unscaled size.
+      /// @return Size.
+      constexpr auto& size() const
+      {
+         return storage->size[i];
+      }
+
+      /// @brief Get scale.
+      /// @return Scale.
+      constexpr auto& scale() const
+      {
+         return storage->scale[i];
+      }
+
+      /// @brief Get scale velocity.
+      /// @return Scale velocity.
+      constexpr auto& scale_velocity() const
+      {
+         return storage->scale_velocity[i];
+      }
+
+      /// @brief Get rotation.
+      /// @return Rotation in degrees.
+      constexpr auto& rotation() const
+      {
+         return storage->rotation[i];
+      }
+
+      /// @brief Get rotation velocity.
+      /// @return Rotation velocity.
+      constexpr auto& rot_velocity() const
+      {
+         return storage->rot_velocity[i];
+      }
+
+      /// @brief Get friction.
+      /// @return Friction.
+      constexpr auto& friction() const
+      {
+         return storage->friction[i];
+      }
+
+      /// @brief Get age.
+      /// @return Age in seconds.
+      constexpr auto& age() const
+      {
+         return storage->age[i];
+      }
+
+      /// @brief Get lifetime.
+      /// @return Lifetime in seconds.
+      constexpr auto& lifetime() const
+      {
+         return storage->lifetime[i];
+      }
+
+      /// @brief Get color.
+      /// @return Color.
+      constexpr auto& color() const
+      {
+         return storage->color[i];
+      }
+
+      /// @brief Get texture rectangle.
+      /// @return Texture rectangle.
+      constexpr auto& texture_rect() const
+      {
+         return storage->texture_rect[i];
+      }
+
+   private:
+      Storage* storage;
+      size_t i;
+   };
+
+   /// @brief Iterable range of particles inside particle storage.
+   /// @tparam Storage Particle storage, const for read-only access.
+   template<typename Storage>
+   class BasicParticleRange
+   {
+   public:
+      /// @brief Iterator over particle views.
+      class Iterator
+      {
+      public:
+         using value_type        = BasicParticle<Storage>;
+         using difference_type   = std::ptrdiff_t;
+         using iterator_category = std::forward_iterator_tag;
+
+         constexpr Iterator() = default;
+         constexpr Iterator(Storage* storage, size_t index)
+            : storage(storage), i(index) {}
+
+         constexpr value_type operator*() const { return value_type(*storage, i); }
+         constexpr Iterator& operator++() { ++i; return *this; }
+         constexpr Iterator operator++(int) { Iterator old = *this; ++i; return old; }
+         constexpr bool operator==(const Iterator& other) const { return i == other.i; }
+
+      private:
+         Storage* storage = nullptr;
+         size_t i = 0;
+      };
+
+      // Constructors
+
+      /// @brief Create a new particle range.
+      /// @param storage Particle storage.
+      constexpr BasicParticleRange(Storage& storage)
+         : storage(&storage) {}
+
+      // Access functions
+
+      /// @brief Get first particle iterator.
+      /// @return Iterator.
+      constexpr Iterator begin() const
+      {
+         return Iterator(storage, 0);
+      }
+
+      /// @brief Get past-the-end iterator.
+      /// @return Iterator.
+      constexpr Iterator end() const
+      {
+         return Iterator(storage, storage->count());
+      }
+
+      /// @brief Get particle by index.
+      /// @param index Index.
+      /// @return Particle view.
+      constexpr BasicParticle<Storage> operator[](size_t index) const
+      {
+         return BasicParticle<Storage>(*storage, index);
+      }
+
+      /// @brief Get particle count.
+      /// @return Particle count.
+      constexpr size_t size() const
+      {
+         return storage->count();
+      }
+
+      /// @brief Check if there are no particles.
+      /// @return True if empty.
+      constexpr bool empty() const
+      {
+         return storage->empty();
+      }
+
+   private:
+      Storage* storage;
+   };
+
+   using Particle           = BasicParticle<ParticleStorage>;            ///< @brief Mutable particle view.
+   using ConstParticle      = BasicParticle<const ParticleStorage>;      ///< @brief Read-only particle view.
+   using ParticleRange      = BasicParticleRange<ParticleStorage>;       ///< @brief Mutable particle range.
+   using ConstParticleRange = BasicParticleRange<const ParticleStorage>; ///< @brief Read-only particle range.
+}
+
+#endif
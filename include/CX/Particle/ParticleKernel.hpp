@@ -0,0 +1,48 @@
+#ifndef CX_PARTICLE_PARTICLE_KERNEL_HPP
+#define CX_PARTICLE_PARTICLE_KERNEL_HPP
+
+#include "CX/Particle/ParticleStorage.hpp"
+
+namespace cx
+{
+   /// @brief Instruction sets the particle kernel can run on.
+   enum class SimdLevel
+   {
+      scalar,
+      sse2,
+      avx2
+   };
+
+   /// @brief Get the best instruction set supported by this CPU. Detected once.
+   /// @return Instruction set.
+   SimdLevel get_simd_level();
+
+   /// @brief Integrate age, position, velocity, friction, rotation and scale of every particle.
+   /// @param storage Particle storage.
+   /// @param dt Delta time.
+   void integrate_particles(ParticleStorage& storage, float dt);
+
+   /// @brief Integrate every particle using a specific instruction set.
+   /// Falls back to a lower instruction set if the given one is not supported.
+   /// @param storage Particle storage.
+   /// @param dt Delta time.
+   /// @param level Instruction set.
+   void integrate_particles(ParticleStorage& storage, float dt, SimdLevel level);
+
+   /// @brief Integrate a range of particles, ranges that do not overlap can run in parallel.
+   /// @param storage Particle storage.
+   /// @param dt Delta time.
+   /// @param begin Index of the first particle.
+   /// @param end Index past the last particle.
+   void integrate_particles(ParticleStorage& storage, float dt, size_t begin, size_t end);
+
+   /// @brief Integrate a range of particles using a specific instruction set.
+   /// @param storage Particle storage.
+   /// @param dt Delta time.
+   /// @param begin Index of the first particle.
+   /// @param end Index past the last particle.
+   /// @param level Instruction set.
+   void integrate_particles(ParticleStorage& storage, float dt, size_t begin, size_t end, SimdLevel level);
+}
+
+#endif
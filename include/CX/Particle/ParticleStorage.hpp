@@ -0,0 +1,151 @@
+#ifndef CX_PARTICLE_PARTICLE_STORAGE_HPP
+#define CX_PARTICLE_PARTICLE_STORAGE_HPP
+
+#include "CX/Color.hpp"
+#include "CX/Vector/Vec4.hpp"
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+namespace cx
+{
+   /// @brief Structure-of-arrays storage of particles.
+   /// Every property lives in its own contiguous array, index i of every array belongs to the same particle.
+   struct ParticleStorage
+   {
+      std::vector<Vec2f> position;          ///< @brief Center positions.
+      std::vector<Vec2f> velocity;          ///< @brief Amount to move by each second.
+      std::vector<Vec2f> acceleration;      ///< @brief Acceleration of velocity.
+      std::vector<Vec2f> size;              ///< @brief Unscaled sizes.
+      std::vector<Vec2f> scale;             ///< @brief Scales.
+      std::vector<Vec2f> scale_velocity;    ///< @brief Amount to change scale by each second.
+      std::vector<float> rotation;          ///< @brief Rotations in degrees.
+      std::vector<float> rot_velocity;      ///< @brief Amount to rotate by each second.
+      std::vector<float> rot_velocity_base; ///< @brief Rotation velocity at spawn, scaled by the rotation curve.
+      std::vector<float> friction;          ///< @brief Amount to slow velocity by.
+      std::vector<float> age;               ///< @brief Ages in seconds.
+      std::vector<float> lifetime;          ///< @brief Lifetimes in seconds.
+      std::vector<Color> color;             ///< @brief Colors.
+      std::vector<Vec4i> texture_rect;      ///< @brief Texture rectangles.
+
+      // Size functions
+
+      /// @brief Get particle count.
+      /// @return Particle count.
+      inline size_t count() const
+      {
+         return age.size();
+      }
+
+      /// @brief Check if there are no particles.
+      /// @return True if empty.
+      inline bool empty() const
+      {
+         return age.empty();
+      }
+
+      /// @brief Get count of particles that fit without allocating.
+      /// @return Capacity.
+      inline size_t capacity() const
+      {
+         return age.capacity();
+      }
+
+      /// @brief Reserve memory for particles.
+      /// @param count Particle count.
+      inline void reserve(size_t count)
+      {
+         for_each_array([count](auto& array) { array.reserve(count); });
+      }
+
+      // Update functions
+
+      /// @brief Add a default particle.
+      /// @return Index of the new particle.
+      inline size_t push()
+      {
+         const size_t index = count();
+         for_each_array([](auto& array) { array.emplace_back(); });
+
+         scale.back() = Vec2f(1.f);
+         color.back() = Color(255);
+         return index;
+      }
+
+      /// @brief Add default particles.
+      /// @param count Particle count.
+      /// @return Index of the first new particle.
+      inline size_t push(size_t count)
+      {
+         const size_t index = this->count();
+         for_each_array([index, count](auto& array) { array.resize(index + count); });
+
+         std::fill(scale.begin() + index, scale.end(), Vec2f(1.f));
+         std::fill(color.begin() + index, color.end(), Color(255));
+         return index;
+      }
+
+      /// @brief Reset a particle to default values in place.
+      /// @param index Index of the particle.
+      inline void reset(size_t index)
+      {
+         for_each_array([index](auto& array) { array[index] = typename std::decay_t<decltype(array)>::value_type(); });
+
+         scale[index] = Vec2f(1.f);
+         color[index] = Color(255);
+      }
+
+      /// @brief Remove a particle by moving the last particle in its place.
+      /// @param index Index of the particle.
+      inline void remove(size_t index)
+      {
+         for_each_array([index](auto& array)
+         {
+            array[index] = array.back();
+            array.pop_back();
+         });
+      }
+
+      /// @brief Remove all particles that have outlived their lifetime.
+      inline void remove_dead()
+      {
+         for (size_t i = 0; i < count();)
+         {
+            if (age[i] >= lifetime[i])
+               remove(i);
+            else
+               ++i;
+         }
+      }
+
+      /// @brief Remove all particles.
+      inline void clear()
+      {
+         for_each_array([](auto& array) { array.clear(); });
+      }
+
+   private:
+      /// @brief Call the function with every array.
+      /// @param func Function.
+      template<typename Func>
+      inline void for_each_array(Func&& func)
+      {
+         func(position);
+         func(velocity);
+         func(acceleration);
+         func(size);
+         func(scale);
+         func(scale_velocity);
+         func(rotation);
+         func(rot_velocity);
+         func(rot_velocity_base);
+         func(friction);
+         func(age);
+         func(lifetime);
+         func(color);
+         func(texture_rect);
+      }
+   };
+}
+
+#endif
@@ -1,27 +1,18 @@
 #ifndef CX_PARTICLE_MANAGER_HPP
 #define CX_PARTICLE_MANAGER_HPP
 
-#include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Texture.hpp>
-#include "CX/Color.hpp"
-#include "CX/Vector/Vec4.hpp"
-#include <memory>
+#include <SFML/Graphics/VertexArray.hpp>
+#include "CX/Atlas/TextureRegion.hpp"
+#include "CX/Math/BulkRandom.hpp"
+#include "CX/Particle/LifetimeCurve.hpp"
+#include "CX/Particle/OverflowPolicy.hpp"
+#include "CX/Particle/Particle.hpp"
 
 namespace cx
 {
-   /// @brief Particle struct used in particle manager.
-   struct Particle
-   {
-      sf::RectangleShape particle; ///< @brief Particle.
-      Vec2f velocity;              ///< @brief Amount to move the particle by each second.
-      Vec2f acceleration;          ///< @brief Acceleration of velocity.
-      Vec2f scale_velocity;        ///< @brief Amount to change scale by each second.
-      float rot_velocity = 0.f;    ///< @brief Amount to rotate by each second.
-      float friction = 0.f;        ///< @brief Amount to slow velocity by.
-      float lifetime = 0.f;        ///< @brief Lifetime of the particle.
-      float age = 0.f;             ///< @brief Age of the particle.
-   };
+   class Camera;
 
    /// @brief Handle particles.
    class ParticleManager
@@ -226,10 +217,19 @@ namespace cx
                                   const Vec4i& texture_rect,
                                   size_t pieces);
 
+      /// @brief Set particle texture based properties.
+      /// @param region Particle texture region, such as an image from a texture atlas.
+      /// @param pieces How many pieces should the region be divided in each axis.
+      void set_texture_properties(const TextureRegion& region, size_t pieces);
+
       /// @brief Set particle texture.
       /// @param texture Particle texture.
       void set_texture(const sf::Texture* texture);
 
+      /// @brief Set particle texture and texture rectangle.
+      /// @param region Particle texture region, such as an image from a texture atlas.
+      void set_texture(const TextureRegion& region);
+
       /// @brief Set texture rectangle.
       /// @param texture_rect Texture rectangle.
       void set_texture_rect(const Vec4i& texture_rect);
@@ -247,6 +247,22 @@ namespace cx
       /// @param end_color Color at the end of particle lifetime.
       void set_color(const Color& start_color, const Color& end_color);
 
+      /// @brief Set particle color over lifetime.
+      /// @param stops Gradient stops, time 0 is spawn and 1 is death.
+      void set_color_gradient(const std::vector<CurveKey<Color>>& stops);
+
+      /// @brief Set scale multiplier over lifetime.
+      /// @param keys Curve keys, empty to disable.
+      void set_scale_curve(const std::vector<CurveKey<float>>& keys);
+
+      /// @brief Set alpha multiplier over lifetime.
+      /// @param keys Curve keys from 0 to 1, empty to disable.
+      void set_alpha_curve(const std::vector<CurveKey<float>>& keys);
+
+      /// @brief Set rotation speed multiplier over lifetime.
+      /// @param keys Curve keys, empty to disable.
+      void set_rotation_speed_curve(const std::vector<CurveKey<float>>& keys);
+
       /// @brief Set particle properties.
       /// @param lifetime Particle lifetime in seconds.
       /// @param spawn_rate Particle spawn rate per second.
@@ -302,20 +318,65 @@ namespace cx
       /// @param can_spawn Can the particles spawn by themselves.
       void set_can_spawn(bool can_spawn);
 
+      /// @brief Set pool capacity. Memory for this many particles is allocated up front
+      /// and live particles never exceed it.
+      /// @param capacity Capacity, 0 to use the maximum particle count.
+      void set_capacity(size_t capacity);
+
+      /// @brief Seed the random engine of this emitter, making its particles reproducible.
+      /// Emitters are seeded from the thread random engine when created.
+      /// @param seed Seed.
+      void set_seed(uint64_t seed);
+
+      /// @brief Set camera used for culling and level of detail.
+      /// @param camera Camera, nullptr to always render at full detail.
+      void set_camera(const Camera* camera);
+
+      /// @brief Set whether off screen emitters only keep time and catch up once visible.
+      /// Catching up simulates at most the longest particle lifetime.
+      /// @param lazy_offscreen Lazy off screen update.
+      void set_lazy_offscreen(bool lazy_offscreen);
+
+      /// @brief Set distance based level of detail. Particle count and spawn rate are scaled
+      /// from full at near distance to far scale at far distance from the camera center.
+      /// @param near_distance Distance with full detail.
+      /// @param far_distance Distance with lowest detail.
+      /// @param far_scale Particle count and spawn rate scale at far distance.
+      void set_lod(float near_distance, float far_distance, float far_scale = .25f);
+
+      /// @brief Disable distance based level of detail.
+      void disable_lod();
+
+      /// @brief Set what happens when a particle spawns while the pool is full.
+      /// @param overflow_policy Overflow policy.
+      void set_overflow_policy(OverflowPolicy overflow_policy);
+
       // Getter functions
 
       /// @brief Get all particles.
-      /// @return List of particles.
-      std::vector<std::shared_ptr<Particle>>& get_particles();
+      /// @return Range of particle views.
+      ParticleRange get_particles();
 
       /// @brief Get all particles.
-      /// @return List of particles.
-      const std::vector<std::shared_ptr<Particle>>& get_particles() const;
+      /// @return Range of particle views.
+      ConstParticleRange get_particles() const;
+
+      /// @brief Get particle storage.
+      /// @return Particle storage.
+      ParticleStorage& get_storage();
+
+      /// @brief Get particle storage.
+      /// @return Particle storage.
+      const ParticleStorage& get_storage() const;
 
       /// @brief Get particle count.
       /// @return Particle count.
       size_t size() const;
 
+      /// @brief Get particle vertices, two triangles per particle.
+      /// @return Vertices.
+      const sf::VertexArray& get_vertices() const;
+
       /// @brief Get particle texture.
       /// @return Texture.
       const sf::Texture* get_texture() const;
@@ -412,6 +473,22 @@ namespace cx
       /// @return End color.
       const Color& get_end_color() const;
 
+      /// @brief Get particle color over lifetime.
+      /// @return Color gradient.
+      const LifetimeCurve<Color>& get_color_gradient() const;
+
+      /// @brief Get scale multiplier over lifetime.
+      /// @return Scale curve.
+      const LifetimeCurve<float>& get_scale_curve() const;
+
+      /// @brief Get alpha multiplier over lifetime.
+      /// @return Alpha curve.
+      const LifetimeCurve<float>& get_alpha_curve() const;
+
+      /// @brief Get rotation speed multiplier over lifetime.
+      /// @return Rotation speed curve.
+      const LifetimeCurve<float>& get_rotation_speed_curve() const;
+
       /// @brief Get minimum particle lifetime.
       /// @return Minimum lifetime.
       float get_lifetime_min() const;
@@ -440,11 +517,54 @@ namespace cx
       /// @return True if can spawn.
       bool get_can_spawn() const;
 
+      /// @brief Get camera used for culling and level of detail.
+      /// @return Camera.
+      const Camera* get_camera() const;
+
+      /// @brief Get bounding box of all particles as of the last vertex rebuild.
+      /// @return Bounds.
+      const Vec4f& get_bounds() const;
+
+      /// @brief Check if particles or the spawn area are inside the camera.
+      /// @return True if visible or there is no camera.
+      bool is_visible() const;
+
+      /// @brief Get lazy off screen update property.
+      /// @return True if lazy.
+      bool get_lazy_offscreen() const;
+
+      /// @brief Get current level of detail scale.
+      /// @return Scale from far scale to 1.
+      float get_lod_scale() const;
+
+      /// @brief Get pool capacity.
+      /// @return Capacity.
+      size_t get_capacity() const;
+
+      /// @brief Get overflow policy.
+      /// @return Overflow policy.
+      OverflowPolicy get_overflow_policy() const;
+
+      /// @brief Get highest count of live particles since the last stats reset.
+      /// @return High-water mark.
+      size_t get_high_water_mark() const;
+
+      /// @brief Get count of particles not spawned because the pool was full.
+      /// @return Dropped count.
+      size_t get_dropped_count() const;
+
+      /// @brief Get count of particles replaced because the pool was full.
+      /// @return Recycled count.
+      size_t get_recycled_count() const;
+
       // Update functions
 
       /// @brief Clear all particles.
       void clear();
 
+      /// @brief Reset high-water mark, dropped and recycled counts.
+      void reset_pool_stats();
+
       /// @brief Spawn all particles that can be spawned.
       void spawn();
 
@@ -452,23 +572,28 @@ namespace cx
       /// @param dt Delta time.
       void update(float dt);
 
+      /// @brief Rebuild particle vertices. Called by update.
+      void update_vertices();
+
       // Render functions
 
-      /// @brief Render particles to the screen.
+      /// @brief Render particles to the screen in a single draw call. Skipped if not visible.
       /// @param window Window to draw to.
       void render(sf::RenderWindow& window) const;
 
-      /// @brief Render particles to the screen.
+      /// @brief Render particles to the screen in a single draw call. Skipped if not visible.
       /// @param window Window to draw to.
       /// @param shader Shader.
       void render(sf::RenderWindow& window,
                   const sf::Shader* shader) const;
 
    private:
-      std::vector<std::shared_ptr<Particle>> particles;
+      ParticleStorage particles;
+      sf::VertexArray vertices {sf::Triangles};
 
       // Particle position and spawn
       Vec2f position;
+      Vec2f last_position;
       float spawn_radius_min = 0.f;
       float spawn_radius_max = 0.f;
 
@@ -495,7 +620,7 @@ namespace cx
       float rot_velocity_max = 0.f;
 
       // Particle texture
-      const sf::Texture* texture;
+      const sf::Texture* texture = nullptr;
       Vec4i texture_rect;
       size_t pieces = 0u;
       Vec2f piece_size;
@@ -504,6 +629,12 @@ namespace cx
       Color color_start = Color(255);
       Color color_end   = Color(255);
 
+      // Lifetime curves
+      LifetimeCurve<Color> color_curve;
+      LifetimeCurve<float> scale_curve;
+      LifetimeCurve<float> alpha_curve;
+      LifetimeCurve<float> rotation_curve;
+
       // Particle lifetime and misc
       float lifetime_min    = 5.f;
       float lifetime_max    = 5.f;
@@ -513,6 +644,28 @@ namespace cx
       bool spawn_once       = false;
       bool can_spawn        = true;
 
+      // Particle pool
+      size_t capacity                = 0u;
+      OverflowPolicy overflow_policy = OverflowPolicy::drop_new;
+      size_t high_water_mark         = 0u;
+      size_t dropped_count           = 0u;
+      size_t recycled_count          = 0u;
+      std::vector<size_t> spawn_indices;
+      std::vector<Vec2f> spawn_vectors;
+      std::vector<float> spawn_floats;
+
+      // Culling and level of detail
+      const Camera* camera = nullptr;
+      Vec4f bounds;
+      bool lazy_offscreen  = false;
+      float offscreen_time = 0.f;
+      float lod_near       = 0.f;
+      float lod_far        = 0.f;
+      float lod_far_scale  = 1.f;
+      float lod_scale      = 1.f;
+
+      Pcg32 rng                 = split_random_engine();
+      BulkRandom bulk_rng;
       size_t spawned_count      = 0u;
       float spawn_timer         = 0.f;
       float spawn_rate_fraction = 1.f;
@@ -520,15 +673,68 @@ namespace cx
       /// @brief Create a new particle.
       void create_particle();
 
-      /// @brief Optimized randfu function.
+      /// @brief Create new particles, one property at a time.
+      /// @param count Particle count.
+      /// @param first_delay Time into the frame when the first particle was due.
+      /// @param dt Delta time of the frame, 0 to spawn at the current position without aging.
+      /// @param interval Time between two particles becoming due.
+      void create_particles(size_t count, float first_delay = 0.f, float dt = 0.f, float interval = 0.f);
+
+      /// @brief Reserve particle memory for the pool capacity.
+      void reserve_pool();
+
+      /// @brief Integrate, remove dead and spawn particles without rebuilding vertices.
+      /// @param dt Delta time.
+      void simulate(float dt);
+
+      /// @brief Keep time while lazily off screen, catch up in small steps once visible again.
+      /// @param dt Delta time.
+      /// @return True if the emitter is off screen and should not be updated.
+      bool update_offscreen(float dt);
+
+      /// @brief Update level of detail scale from the camera distance.
+      void update_lod();
+
+      /// @brief Get particle count limit after level of detail.
+      /// @return Particle count.
+      size_t get_lod_count() const;
+
+      /// @brief Spawn every particle owed since the last update.
+      /// @param dt Delta time.
+      void update_spawn(float dt);
+
+      /// @brief Integrate a range of particles and update their colors.
+      /// @param dt Delta time.
+      /// @param begin Index of the first particle.
+      /// @param end Index past the last particle.
+      void update_particles(float dt, size_t begin, size_t end);
+
+      /// @brief Write vertices of a range of particles, 6 per particle.
+      /// @param out First vertex to write to.
+      /// @param begin Index of the first particle.
+      /// @param end Index past the last particle.
+      /// @return Bounding box of the written vertices.
+      Vec4f build_vertices(sf::Vertex* out, size_t begin, size_t end) const;
+
+      /// @brief Get bounding box of two bounding boxes, empty boxes are ignored.
+      /// @param a First bounding box.
+      /// @param b Second bounding box.
+      /// @return Bounding box.
+      static Vec4f merge_bounds(const Vec4f& a, const Vec4f& b);
+
+      friend class ParticleWorld;
+
+      /// @brief Fill a property of every particle being spawned with random values.
+      /// @param column Property array.
       /// @param min Minimum value.
       /// @param max Maximum value.
-      float rand_f(float min, float max);
-      
-      /// @brief Optimized random vector function.
+      void spawn_column(std::vector<float>& column, float min, float max);
+
+      /// @brief Fill a property of every particle being spawned with random values.
+      /// @param column Property array.
       /// @param min Minimum value.
       /// @param max Maximum value.
-      Vec2f rand_v(const Vec2f& min, const Vec2f& max);
+      void spawn_column(std::vector<Vec2f>& column, const Vec2f& min, const Vec2f& max);
    };
 }
 
@@ -0,0 +1,142 @@
+#ifndef CX_PARTICLE_WORLD_HPP
+#define CX_PARTICLE_WORLD_HPP
+
+#include "CX/ParticleManager.hpp"
+#include "CX/ThreadPool.hpp"
+#include <memory>
+
+namespace cx
+{
+   /// @brief Own many particle emitters and update them in parallel.
+   /// Spawning and removal run in emitter order so results do not depend on thread count.
+   /// Emitters owned by a world are rendered through the world, emitters outside their camera are culled.
+   class ParticleWorld
+   {
+   public:
+      // Constructors
+
+      /// @brief Create a particle world using one worker less than hardware threads.
+      ParticleWorld() = default;
+
+      /// @brief Create a new particle world.
+      /// @param thread_count Count of worker threads, 0 to update on the calling thread only.
+      ParticleWorld(size_t thread_count);
+
+      ParticleWorld(const ParticleWorld&) = delete;
+      ParticleWorld& operator=(const ParticleWorld&) = delete;
+
+      // Emitter functions
+
+      /// @brief Add a default emitter.
+      /// @return Added emitter.
+      ParticleManager& add_emitter();
+
+      /// @brief Add a copy of an emitter. The copy is seeded from the thread random engine,
+      /// so it spawns its own pattern, use set_seed on it for a fixed one.
+      /// @param emitter Emitter to copy.
+      /// @return Added emitter.
+      ParticleManager& add_emitter(const ParticleManager& emitter);
+
+      /// @brief Remove an emitter owned by this world.
+      /// @param emitter Emitter.
+      void remove_emitter(const ParticleManager& emitter);
+
+      /// @brief Remove all emitters.
+      void clear();
+
+      // Setter functions
+
+      /// @brief Set maximum count of particles updated by one job.
+      /// Emitters with more particles are split into several jobs.
+      /// @param chunk_size Chunk size.
+      void set_chunk_size(size_t chunk_size);
+
+      // Getter functions
+
+      /// @brief Get emitter by index.
+      /// @param index Index.
+      /// @return Emitter.
+      ParticleManager& get_emitter(size_t index);
+
+      /// @brief Get emitter by index.
+      /// @param index Index.
+      /// @return Emitter.
+      const ParticleManager& get_emitter(size_t index) const;
+
+      /// @brief Get emitter count.
+      /// @return Emitter count.
+      size_t emitter_count() const;
+
+      /// @brief Get particle count of all emitters.
+      /// @return Particle count.
+      size_t particle_count() const;
+
+      /// @brief Get maximum count of particles updated by one job.
+      /// @return Chunk size.
+      size_t get_chunk_size() const;
+
+      /// @brief Get count of draw calls the last update produced.
+      /// @return Draw call count.
+      size_t get_batch_count() const;
+
+      /// @brief Get vertices of a draw call.
+      /// @param index Index of the draw call.
+      /// @return Vertices.
+      const sf::VertexArray& get_vertices(size_t index) const;
+
+      // Update functions
+
+      /// @brief Spawn, update and build vertices of all emitters.
+      /// @param dt Delta time.
+      void update(float dt);
+
+      // Render functions
+
+      /// @brief Render all visible emitters. Neighbouring emitters sharing a texture are drawn together.
+      /// @param window Window to draw to.
+      void render(sf::RenderWindow& window) const;
+
+      /// @brief Render all visible emitters. Neighbouring emitters sharing a texture are drawn together.
+      /// @param window Window to draw to.
+      /// @param shader Shader.
+      void render(sf::RenderWindow& window,
+                  const sf::Shader* shader) const;
+
+   private:
+      /// @brief Vertices of neighbouring emitters sharing a texture.
+      struct Batch
+      {
+         const sf::Texture* texture = nullptr;
+         sf::VertexArray vertices {sf::Triangles};
+         size_t count = 0u;
+         size_t offset = 0u;
+      };
+
+      /// @brief Range of particles of one emitter.
+      struct Job
+      {
+         ParticleManager* emitter;
+         size_t begin;
+         size_t end;
+         sf::Vertex* vertices;
+         Vec4f bounds;
+      };
+
+      static constexpr size_t no_batch = size_t(-1);
+
+      ThreadPool pool;
+      std::vector<std::unique_ptr<ParticleManager>> emitters;
+      std::vector<Batch> batches;
+      std::vector<Job> jobs;
+      std::vector<size_t> batch_indices;
+      std::vector<char> updating;
+      size_t batch_count = 0u;
+      size_t chunk_size = 4096u;
+
+      /// @brief Split emitters into jobs.
+      /// @param with_vertices Whether to point jobs at their batch vertices, else only updating emitters get jobs.
+      void build_jobs(bool with_vertices);
+   };
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define CX_PLANE_PLANE_HPP
 
 #include <SFML/Graphics/VertexArray.hpp>
+#include "CX/Atlas/TextureRegion.hpp"
 #include "CX/Plane/PlaneStyle.hpp"
 #include "CX/UIElement/UIElement.hpp"
 
@@ -97,6 +98,10 @@ namespace cx
       /// @param texture New texture.
       void set_texture(const sf::Texture* texture);
 
+      /// @brief Change texture and texture plane of the plane.
+      /// @param region New texture region, such as an image from a texture atlas.
+      void set_texture(const TextureRegion& region);
+
       /// @brief Change texture plane of the plane.
       /// @param rect New texture plane.
       void set_texture_rect(const Vec4i& rect);
@@ -260,13 +265,18 @@ namespace cx
       // Render functions
 
       /// @brief Render the plane.
-      /// @param window Window to draw to.
-      void render(sf::RenderWindow& window) const override;
+      /// @param target Target to draw to.
+      void render(sf::RenderTarget& target) const override;
 
       /// @brief Render the plane.
-      /// @param window Window to draw to.
+      /// @param target Target to draw to.
       /// @param shader Shader.
-      void render(sf::RenderWindow& window, const sf::Shader* shader) const override;
+      void render(sf::RenderTarget& target, const sf::Shader* shader) const override;
+
+      /// @brief Submit the plane to a render batch.
+      /// @param batch Render batch.
+      /// @param layer Layer.
+      void submit(RenderBatch& batch, int layer = 0) const override;
 
       // Access functions
 
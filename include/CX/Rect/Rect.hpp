@@ -1,8 +1,9 @@
 #ifndef CX_RECT_RECT_HPP
 #define CX_RECT_RECT_HPP
 
-#include <SFML/Graphics/RectangleShape.hpp>
+#include "CX/Atlas/TextureRegion.hpp"
 #include "CX/Rect/RectStyle.hpp"
+#include "CX/Render/Quad.hpp"
 #include "CX/UIElement/UIElement.hpp"
 
 namespace cx
@@ -71,6 +72,10 @@ namespace cx
       /// @param texture New texture.
       void set_texture(const sf::Texture* texture);
 
+      /// @brief Change texture and texture rectangle of the rectangle.
+      /// @param region New texture region, such as an image from a texture atlas.
+      void set_texture(const TextureRegion& region);
+
       /// @brief Change texture rectangle of the rectangle.
       /// @param rect New texture rectangle.
       void set_texture_rect(const Vec4i& rect);
@@ -127,22 +132,27 @@ namespace cx
       // Render functions
 
       /// @brief Render the rectangle.
-      /// @param window Window to draw to.
-      void render(sf::RenderWindow& window) const override;
+      /// @param target Target to draw to.
+      void render(sf::RenderTarget& target) const override;
 
       /// @brief Render the rectangle.
-      /// @param window Window to draw to.
+      /// @param target Target to draw to.
       /// @param shader Shader.
-      void render(sf::RenderWindow& window, const sf::Shader* shader) const override;
+      void render(sf::RenderTarget& target, const sf::Shader* shader) const override;
+
+      /// @brief Submit the rectangle to a render batch.
+      /// @param batch Render batch.
+      /// @param layer Layer.
+      void submit(RenderBatch& batch, int layer = 0) const override;
 
       // Access functions
 
       /// @brief Get the rectangle.
       /// @return Rectangle.
-      sf::RectangleShape& get_rectangle();
+      Quad& get_rectangle();
 
    private:
-      sf::RectangleShape rect;
+      Quad rect;
    };
 }
 
@@ -0,0 +1,17 @@
+#ifndef CX_RENDER_FILL_MODE_HPP
+#define CX_RENDER_FILL_MODE_HPP
+
+namespace cx
+{
+   /// @brief Direction a progress fill grows in, relative to the unrotated element.
+   enum class FillMode : char
+   {
+      left_to_right, ///< @brief Grows from the left edge.
+      right_to_left, ///< @brief Grows from the right edge.
+      top_to_bottom, ///< @brief Grows from the top edge.
+      bottom_to_top, ///< @brief Grows from the bottom edge.
+      radial         ///< @brief Sweeps clockwise around the center, starting at the top.
+   };
+}
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef CX_RENDER_PROGRESS_FILL_HPP
+#define CX_RENDER_PROGRESS_FILL_HPP
+
+#include <SFML/Graphics/Vertex.hpp>
+#include "CX/Render/FillMode.hpp"
+#include "CX/Render/Quad.hpp"
+
+namespace cx
+{
+   /// @brief Most vertices a progress fill can produce.
+   /// A full radial fan has a triangle per rectangle corner and one closing it.
+   static constexpr size_t progress_fill_max_vertices = (4u + 1u) * 3u;
+
+   /// @brief Cut a rectangle to a progress on the CPU, as triangles in world coordinates.
+   /// Texture coordinates are cut along with the positions, so no clipping shader is needed
+   /// and the result can be batched like any other geometry. Rotation comes from the shape transform.
+   /// @param shape Rectangle to fill, its fill color and texture rectangle are used.
+   /// @param progress Progress 0 to 1.
+   /// @param mode Fill direction.
+   /// @param out Vertices, room for at least progress_fill_max_vertices.
+   /// @return Count of vertices written, 0 if nothing is filled.
+   size_t build_progress_fill(const Quad& shape, float progress, FillMode mode, sf::Vertex* out);
+}
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef CX_RENDER_QUAD_HPP
+#define CX_RENDER_QUAD_HPP
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+namespace sf
+{
+   class Texture;
+}
+
+namespace cx
+{
+   /// @brief Textured rectangle with an optional outline, a lighter replacement for sf::RectangleShape.
+   /// Mirrors the interface of sf::RectangleShape, but keeps a fixed layout of 4 fill and
+   /// 10 outline vertices in place of vertex arrays, rebuilt only when drawn after a change.
+   class Quad : public sf::Drawable, public sf::Transformable
+   {
+   public:
+      static constexpr size_t fill_vertex_count = 6u;     ///< @brief Vertices written by getFillTriangles.
+      static constexpr size_t outline_vertex_count = 24u; ///< @brief Most vertices written by getOutlineTriangles.
+
+      // Constructors
+
+      /// @brief Create a new quad.
+      /// @param size Size.
+      explicit Quad(const sf::Vector2f& size = sf::Vector2f());
+
+      // Setter functions
+
+      /// @brief Change size.
+      /// @param size Size.
+      void setSize(const sf::Vector2f& size);
+
+      /// @brief Change texture. Without a texture rect, the rect is set to the whole texture.
+      /// @param texture Texture, null for none.
+      /// @param resetRect Should the rect be set to the whole texture.
+      void setTexture(const sf::Texture* texture, bool resetRect = false);
+
+      /// @brief Change part of the texture shown.
+      /// @param rect Texture rect.
+      void setTextureRect(const sf::IntRect& rect);
+
+      /// @brief Change fill color.
+      /// @param color Color.
+      void setFillColor(const sf::Color& color);
+
+      /// @brief Change outline color.
+      /// @param color Color.
+      void setOutlineColor(const sf::Color& color);
+
+      /// @brief Change outline thickness, negative values grow the outline inwards.
+      /// @param thickness Thickness.
+      void setOutlineThickness(float thickness);
+
+      // Getter functions
+
+      /// @brief Get size.
+      /// @return Size.
+      const sf::Vector2f& getSize() const;
+
+      /// @brief Get texture.
+      /// @return Texture, null if none.
+      const sf::Texture* getTexture() const;
+
+      /// @brief Get part of the texture shown.
+      /// @return Texture rect.
+      const sf::IntRect& getTextureRect() const;
+
+      /// @brief Get fill color.
+      /// @return Color.
+      const sf::Color& getFillColor() const;
+
+      /// @brief Get outline color.
+      /// @return Color.
+      const sf::Color& getOutlineColor() const;
+
+      /// @brief Get outline thickness.
+      /// @return Thickness.
+      float getOutlineThickness() const;
+
+      /// @brief Get count of corners.
+      /// @return Always 4.
+      size_t getPointCount() const;
+
+      /// @brief Get a corner in local coordinates, clockwise from the top left.
+      /// @param index Corner index.
+      /// @return Corner.
+      sf::Vector2f getPoint(size_t index) const;
+
+      /// @brief Get bounds with the outline, in local coordinates.
+      /// @return Bounds.
+      sf::FloatRect getLocalBounds() const;
+
+      /// @brief Get bounds with the outline, in world coordinates.
+      /// @return Bounds.
+      sf::FloatRect getGlobalBounds() const;
+
+      // Vertex functions
+
+      /// @brief Write the fill as two triangles in world coordinates.
+      /// @param out Vertices, fill_vertex_count of them.
+      void getFillTriangles(sf::Vertex* out) const;
+
+      /// @brief Write the outline as triangles in world coordinates.
+      /// @param out Vertices, room for outline_vertex_count of them.
+      /// @return Count of vertices written, 0 without an outline.
+      size_t getOutlineTriangles(sf::Vertex* out) const;
+
+   private:
+      sf::Vector2f size;
+      const sf::Texture* texture = nullptr;
+      sf::IntRect texture_rect;
+      sf::Color fill_color = sf::Color(255, 255, 255);
+      sf::Color outline_color = sf::Color(255, 255, 255);
+      float outline_thickness = 0.f;
+
+      mutable sf::Vertex fill[4];
+      mutable sf::Vertex outline[10];
+      mutable bool dirty = true;
+
+      /// @brief Rebuild local vertices if anything changed.
+      void update() const;
+
+      /// @brief Draw the quad.
+      /// @param target Target to draw to.
+      /// @param states Render states.
+      void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+   };
+}
+
+#endif
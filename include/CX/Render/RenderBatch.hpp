@@ -0,0 +1,174 @@
+#ifndef CX_RENDER_RENDER_BATCH_HPP
+#define CX_RENDER_RENDER_BATCH_HPP
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Shape.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include "CX/Render/Quad.hpp"
+#include "CX/Render/RenderStats.hpp"
+#include "CX/Vector/Vec2.hpp"
+#include <vector>
+
+namespace cx
+{
+   class GlyphRun;
+   class UIElement;
+
+   /// @brief Collect shapes and vertices, then draw them with as few draw calls as possible.
+   /// Submissions are sorted by layer, lower layers are drawn first. Inside a layer a submission is
+   /// moved back to an earlier one with the same shader and texture when it overlaps nothing drawn
+   /// in between, so overlapping parts keep painter's order and each group is merged into one draw call.
+   /// Drawables are never moved and nothing is moved past them.
+   /// Submitted drawables, textures and shaders must stay alive until flushed.
+   class RenderBatch
+   {
+   public:
+      // Constructors
+
+      /// @brief Create an empty render batch.
+      RenderBatch() = default;
+
+      // Submit functions
+
+      /// @brief Submit an element.
+      /// @param element Element.
+      /// @param layer Layer.
+      void submit(const UIElement& element, int layer = 0);
+
+      /// @brief Submit a convex shape, including its outline.
+      /// @param shape Shape.
+      /// @param layer Layer.
+      /// @param shader Shader.
+      void submit(const sf::Shape& shape, int layer = 0, const sf::Shader* shader = nullptr);
+
+      /// @brief Submit a quad, including its outline.
+      /// @param quad Quad.
+      /// @param layer Layer.
+      /// @param shader Shader.
+      void submit(const Quad& quad, int layer = 0, const sf::Shader* shader = nullptr);
+
+      /// @brief Submit a text through its cached glyph quads, so texts sharing a font page are merged.
+      /// @param text Text.
+      /// @param glyphs Glyph quads of the text, rebuilt if the text changed.
+      /// @param layer Layer.
+      /// @param shader Shader.
+      void submit(const sf::Text& text, GlyphRun& glyphs, int layer = 0, const sf::Shader* shader = nullptr);
+
+      /// @brief Submit vertices. Points and lines are drawn on their own.
+      /// @param vertices Vertices.
+      /// @param texture Texture.
+      /// @param layer Layer.
+      /// @param shader Shader.
+      void submit(const sf::VertexArray& vertices, const sf::Texture* texture = nullptr,
+                  int layer = 0, const sf::Shader* shader = nullptr);
+
+      /// @brief Submit triangles in world coordinates.
+      /// @param triangles Vertices, 3 per triangle.
+      /// @param count Vertex count.
+      /// @param texture Texture.
+      /// @param layer Layer.
+      /// @param shader Shader.
+      void submit(const sf::Vertex* triangles, size_t count, const sf::Texture* texture = nullptr,
+                  int layer = 0, const sf::Shader* shader = nullptr);
+
+      /// @brief Submit a drawable that can not be merged, it gets its own draw call.
+      /// @param drawable Drawable.
+      /// @param layer Layer.
+      /// @param states Render states.
+      void submit(const sf::Drawable& drawable, int layer, const sf::RenderStates& states);
+
+      // Render functions
+
+      /// @brief Draw all submissions and clear the batch.
+      /// @param target Target to draw to.
+      void flush(sf::RenderTarget& target);
+
+      /// @brief Remove all submissions without drawing.
+      void clear();
+
+      // Getter functions
+
+      /// @brief Get count of submissions waiting to be flushed.
+      /// @return Submission count.
+      size_t size() const;
+
+      /// @brief Get counts of the last flush.
+      /// @return Render stats.
+      const RenderStats& get_stats() const;
+
+   private:
+      /// @brief Submitted geometry or drawable.
+      struct Command
+      {
+         int layer;
+         const sf::Shader* shader;
+         const sf::Texture* texture;
+         size_t order;
+         size_t first;
+         size_t count;
+         const sf::Drawable* drawable;
+         sf::RenderStates states;
+         Vec2f low;
+         Vec2f high;
+         size_t group;
+      };
+
+      /// @brief Commands of one layer drawn together in one draw call.
+      struct Group
+      {
+         int layer;
+         const sf::Shader* shader;
+         const sf::Texture* texture;
+         bool drawable;
+         size_t last_bounds;
+      };
+
+      /// @brief Bounds covering some commands of a group, linked to the previous bounds of the same group.
+      struct Bounds
+      {
+         Vec2f low;
+         Vec2f high;
+         size_t previous;
+      };
+
+      static constexpr size_t max_lookback = 32u;    ///< @brief Most groups a command is moved back past.
+      static constexpr size_t no_bounds = size_t(-1); ///< @brief Index of no bounds.
+
+      std::vector<Command> commands;
+      std::vector<Group> groups;
+      std::vector<Bounds> bounds;
+      std::vector<sf::Vertex> vertices;
+      std::vector<sf::Vertex> merged;
+      size_t submissions = 0u;
+      RenderStats stats;
+
+      /// @brief Start a geometry command, or extend the last one if it has the same state.
+      /// @param texture Texture.
+      /// @param layer Layer.
+      /// @param shader Shader.
+      void begin_geometry(const sf::Texture* texture, int layer, const sf::Shader* shader);
+
+      /// @brief Add a triangle to the current geometry command.
+      /// @param a First vertex.
+      /// @param b Second vertex.
+      /// @param c Third vertex.
+      void add_triangle(const sf::Vertex& a, const sf::Vertex& b, const sf::Vertex& c);
+
+      /// @brief Assign every command to a group, sorted commands of a layer must be in submission order.
+      void group_commands();
+
+      /// @brief Check if a command overlaps any command of a group.
+      /// @param group Group.
+      /// @param command Command.
+      /// @return True if they overlap.
+      bool overlaps(const Group& group, const Command& command) const;
+
+      /// @brief Add bounds of a command to a group, growing its last bounds if that adds little empty area.
+      /// @param group Group.
+      /// @param command Command.
+      void add_bounds(Group& group, const Command& command);
+   };
+}
+
+#endif
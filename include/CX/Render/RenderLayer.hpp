@@ -0,0 +1,159 @@
+#ifndef CX_RENDER_RENDER_LAYER_HPP
+#define CX_RENDER_RENDER_LAYER_HPP
+
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include "CX/Color.hpp"
+#include "CX/Render/RenderBatch.hpp"
+#include "CX/Vector/Vec4.hpp"
+#include <vector>
+
+namespace cx
+{
+   class UIElement;
+
+   /// @brief Keep a group of mostly static elements drawn into a texture.
+   /// Every update checks members for changes to bounds, color, hover state and revision,
+   /// and only redraws the parts of the texture covered by changed members.
+   /// Members are not owned and must outlive the layer or be removed first.
+   class RenderLayer
+   {
+   public:
+      // Constructors
+
+      /// @brief Create an empty layer, call create before use.
+      RenderLayer() = default;
+
+      /// @brief Create a new layer.
+      /// @param area Area of the world covered by the layer.
+      RenderLayer(const Vec4f& area);
+
+      // Constructors after creation
+
+      /// @brief Create a new layer, members are kept.
+      /// @param area Area of the world covered by the layer.
+      void create(const Vec4f& area);
+
+      // Member functions
+
+      /// @brief Add an element. Elements are drawn in order of their layer, then in the order they were added.
+      /// @param element Element.
+      /// @param layer Layer inside the render layer, use higher layers for elements on top.
+      void add(const UIElement& element, int layer = 0);
+
+      /// @brief Remove an element.
+      /// @param element Element.
+      void remove(const UIElement& element);
+
+      /// @brief Remove all elements.
+      void clear();
+
+      /// @brief Redraw the whole layer on the next update.
+      void mark_dirty();
+
+      /// @brief Redraw the area of an element on the next update.
+      /// Needed after changing an element through its access functions.
+      /// @param element Element.
+      void mark_dirty(const UIElement& element);
+
+      // Setter functions
+
+      /// @brief Change color the layer is cleared to.
+      /// @param color Clear color.
+      void set_clear_color(const Color& color);
+
+      /// @brief Change extra space redrawn around changed elements, to cover outlines and text.
+      /// @param margin Margin in pixels.
+      void set_margin(float margin);
+
+      // Getter functions
+
+      /// @brief Get area of the world covered by the layer.
+      /// @return Area.
+      const Vec4f& get_area() const;
+
+      /// @brief Get count of elements.
+      /// @return Element count.
+      size_t size() const;
+
+      /// @brief Get cached texture.
+      /// @return Texture.
+      const sf::Texture& get_texture() const;
+
+      /// @brief Get count of regions redrawn by the last update, 0 if nothing changed.
+      /// @return Region count.
+      size_t get_redraw_count() const;
+
+      // Update functions
+
+      /// @brief Check members for changes and redraw the changed regions.
+      void update();
+
+      // Render functions
+
+      /// @brief Render the cached texture.
+      /// @param window Window to draw to.
+      void render(sf::RenderWindow& window) const;
+
+      /// @brief Render the cached texture.
+      /// @param window Window to draw to.
+      /// @param shader Shader.
+      void render(sf::RenderWindow& window, const sf::Shader* shader) const;
+
+      /// @brief Submit the cached texture to a render batch.
+      /// @param batch Render batch.
+      /// @param layer Layer.
+      void submit(RenderBatch& batch, int layer = 0) const;
+
+   private:
+      /// @brief What a member looked like when it was last drawn.
+      struct Snapshot
+      {
+         Vec4f bounds;
+         Color color;
+         uint32_t revision = 0u;
+         bool hovering = false;
+         bool mouse_down = false;
+
+         bool operator==(const Snapshot& other) const;
+      };
+
+      /// @brief Element with its state.
+      struct Member
+      {
+         const UIElement* element;
+         int layer;
+         Snapshot snapshot;
+      };
+
+      sf::RenderTexture texture;
+      RenderBatch batch;
+      Vec4f area;
+      Color clear_color = Color(0, 0, 0, 0);
+      float margin = 4.f;
+      bool full_redraw = true;
+      size_t redraw_count = 0u;
+
+      std::vector<Member> members;
+      std::vector<Vec4f> dirty;
+
+      /// @brief Take a snapshot of an element.
+      /// @param element Element.
+      /// @return Snapshot.
+      Snapshot take_snapshot(const UIElement& element) const;
+
+      /// @brief Add a dirty region, merging it with the ones it overlaps.
+      /// @param region Region in world coordinates.
+      void add_dirty(const Vec4f& region);
+
+      /// @brief Redraw a region of the texture.
+      /// @param region Region in world coordinates.
+      void redraw(const Vec4f& region);
+
+      /// @brief Create vertices of the cached texture quad.
+      /// @param vertices Vertices, 6 of them.
+      void build_quad(sf::Vertex* vertices) const;
+   };
+}
+
+#endif
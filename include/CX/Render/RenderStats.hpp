@@ -0,0 +1,17 @@
+#ifndef CX_RENDER_RENDER_STATS_HPP
+#define CX_RENDER_RENDER_STATS_HPP
+
+#include <cstddef>
+
+namespace cx
+{
+   /// @brief Counts of a render batch flush.
+   struct RenderStats
+   {
+      size_t submissions = 0u; ///< @brief Submitted shapes, vertex arrays and drawables.
+      size_t draw_calls  = 0u; ///< @brief Draw calls issued.
+      size_t vertices    = 0u; ///< @brief Vertices drawn by merged draw calls.
+   };
+}
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef CX_RENDER_SHADERS_HPP
+#define CX_RENDER_SHADERS_HPP
+
+#include <SFML/Graphics/Shader.hpp>
+
+namespace cx::shaders
+{
+   /// @brief Get the clipping shader shared by every bar and slider.
+   /// Compiled once from source embedded in the library, on first use.
+   /// Discards texture pixels past the 'progress' uniform, set it before every draw.
+   /// @return Shader, nullptr if shaders are not supported.
+   sf::Shader* get_clipping_shader();
+
+   /// @brief Destroy the shared shaders while the window is still open, they are recompiled on next use.
+   /// Shaders that are not released are left to the operating system at exit,
+   /// since destroying them after the window and its context are gone can crash.
+   void release_shaders();
+}
+
+#endif
@@ -0,0 +1,192 @@
+#ifndef CX_SCENE_SCENE_HPP
+#define CX_SCENE_SCENE_HPP
+
+#include <SFML/Graphics/RenderWindow.hpp>
+#include "CX/Render/RenderBatch.hpp"
+#include "CX/Vector/Vec4.hpp"
+#include "CX/Vector/Vec5.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace cx
+{
+   class Camera;
+   class UIElement;
+
+   /// @brief Keep elements in a uniform grid so only the visible ones are found and drawn.
+   /// Every element is indexed by the box around its rotated bounds, so queries never miss
+   /// a visible element but may return one just outside a rotated camera.
+   /// Moved elements are re-indexed one at a time with update, or all at once with refresh.
+   /// Members are not owned and must outlive the scene or be removed first.
+   class Scene
+   {
+   public:
+      // Constructors
+
+      /// @brief Create a new scene.
+      /// @param cell_size Size of grid cells, about the size of a common element works best.
+      Scene(float cell_size = 256.f);
+
+      // Member functions
+
+      /// @brief Add an element. Elements are drawn in order of their layer, then in order of adding.
+      /// @param element Element.
+      /// @param layer Layer, use higher layers for elements on top.
+      void add(UIElement& element, int layer = 0);
+
+      /// @brief Remove an element.
+      /// @param element Element.
+      void remove(const UIElement& element);
+
+      /// @brief Remove all elements.
+      void clear();
+
+      /// @brief Check if an element is in the scene.
+      /// @param element Element.
+      /// @return True if added.
+      bool contains(const UIElement& element) const;
+
+      /// @brief Re-index an element after it moved, resized or rotated.
+      /// @param element Element.
+      void update(const UIElement& element);
+
+      /// @brief Re-index every element whose bounds changed since it was indexed.
+      void refresh();
+
+      // Setter functions
+
+      /// @brief Change size of grid cells, re-indexes every element.
+      /// @param cell_size Cell size.
+      void set_cell_size(float cell_size);
+
+      /// @brief Change layer of an element.
+      /// @param element Element.
+      /// @param layer Layer.
+      void set_layer(const UIElement& element, int layer);
+
+      // Getter functions
+
+      /// @brief Get size of grid cells.
+      /// @return Cell size.
+      float get_cell_size() const;
+
+      /// @brief Get count of elements.
+      /// @return Element count.
+      size_t size() const;
+
+      /// @brief Get count of grid cells holding elements.
+      /// @return Cell count.
+      size_t cell_count() const;
+
+      // Query functions
+
+      /// @brief Find elements visible to a camera.
+      /// @param camera Camera.
+      /// @return Visible elements in draw order, valid until the next query.
+      const std::vector<UIElement*>& query(const Camera& camera);
+
+      /// @brief Find elements overlapping an area.
+      /// @param area Area.
+      /// @return Overlapping elements in draw order, valid until the next query.
+      const std::vector<UIElement*>& query(const Vec4f& area);
+
+      /// @brief Find elements overlapping a rotated area.
+      /// @param area Area.
+      /// @return Overlapping elements in draw order, valid until the next query.
+      const std::vector<UIElement*>& query(const Vec5f& area);
+
+      // Render functions
+
+      /// @brief Render elements visible to a camera.
+      /// @param window Window to draw to.
+      /// @param camera Camera.
+      void render(sf::RenderWindow& window, const Camera& camera);
+
+      /// @brief Render elements visible to a camera.
+      /// @param window Window to draw to.
+      /// @param camera Camera.
+      /// @param shader Shader.
+      void render(sf::RenderWindow& window, const Camera& camera, const sf::Shader* shader);
+
+      /// @brief Submit elements visible to a camera to a render batch.
+      /// @param batch Render batch.
+      /// @param camera Camera.
+      /// @param layer Layer added to the layer of every element.
+      void submit(RenderBatch& batch, const Camera& camera, int layer = 0);
+
+   private:
+      /// @brief Cells covered by an element, inclusive.
+      struct CellRange
+      {
+         int32_t left = 0;
+         int32_t top = 0;
+         int32_t right = -1;
+         int32_t bottom = -1;
+      };
+
+      /// @brief Element with its index state.
+      struct Member
+      {
+         UIElement* element = nullptr;
+         int layer = 0;
+         uint64_t order = 0u;
+         Vec4f box;
+         CellRange cells;
+         uint32_t stamp = 0u;
+         bool oversized = false;
+      };
+
+      /// @brief Elements covering more cells than this are kept in one list instead.
+      static constexpr int64_t max_cells = 64;
+
+      float cell_size;
+      uint64_t next_order = 0u;
+      uint32_t stamp = 0u;
+
+      std::vector<Member> members;
+      std::vector<uint32_t> free_members;
+      std::unordered_map<const UIElement*, uint32_t> lookup;
+      std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+      std::vector<uint32_t> oversized;
+      std::vector<uint32_t> hits;
+      std::vector<UIElement*> visible;
+
+      /// @brief Get the box around the rotated bounds of an element.
+      /// @param element Element.
+      /// @return Box.
+      static Vec4f get_box(const UIElement& element);
+
+      /// @brief Get key of a cell.
+      /// @param x Cell column.
+      /// @param y Cell row.
+      /// @return Key.
+      static uint64_t cell_key(int32_t x, int32_t y);
+
+      /// @brief Get cells covered by a box.
+      /// @param box Box.
+      /// @return Cell range.
+      CellRange get_cells(const Vec4f& box) const;
+
+      /// @brief Put a member into the cells covering its box.
+      /// @param index Member index.
+      void insert(uint32_t index);
+
+      /// @brief Take a member out of its cells.
+      /// @param index Member index.
+      void erase(uint32_t index);
+
+      /// @brief Update box of a member and move it between cells if needed.
+      /// @param index Member index.
+      void reindex(uint32_t index);
+
+      /// @brief Collect members whose box overlaps an area and which pass a test.
+      /// @param box Box around the area.
+      /// @param test Precise test on the box of a member.
+      /// @return Found elements in draw order.
+      template<typename Test>
+      const std::vector<UIElement*>& collect(const Vec4f& box, Test&& test);
+   };
+}
+
+#endif
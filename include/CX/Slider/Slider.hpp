@@ -1,8 +1,8 @@
 #ifndef CX_SLIDER_SLIDER_HPP
 #define CX_SLIDER_SLIDER_HPP
 
-#include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/Shader.hpp>
+#include "CX/Render/Quad.hpp"
 #include "CX/Slider/SliderStyle.hpp"
 #include "CX/UIElement/UIElement.hpp"
 
@@ -451,33 +451,37 @@ namespace cx
       // Render functions
 
       /// @brief Render the slider.
-      /// @param window Window to draw to.
-      void render(sf::RenderWindow& window) const override;
+      /// @param target Target to draw to.
+      void render(sf::RenderTarget& target) const override;
 
       /// @brief Render the slider.
-      /// @param window Window to draw to.
+      /// @param target Target to draw to.
       /// @param shader Shader.
-      void render(sf::RenderWindow& window, const sf::Shader* shader) const override;
+      void render(sf::RenderTarget& target, const sf::Shader* shader) const override;
+
+      /// @brief Submit the slider to a render batch.
+      /// @param batch Render batch.
+      /// @param layer Layer.
+      void submit(RenderBatch& batch, int layer = 0) const override;
 
       // Access functions
 
       /// @brief Get knob.
       /// @return Knob.
-      sf::RectangleShape& get_knob();
+      Quad& get_knob();
 
       /// @brief Get foreground.
       /// @return Foreground.
-      sf::RectangleShape& get_foreground();
+      Quad& get_foreground();
 
       /// @brief Get background.
       /// @return Background.
-      sf::RectangleShape& get_background();
+      Quad& get_background();
 
    private:
-      sf::Shader clip_shader;
-      sf::RectangleShape knob;
-      sf::RectangleShape foreground;
-      sf::RectangleShape background;
+      Quad knob;
+      Quad foreground;
+      Quad background;
       float slider_step     = 1.f;
       float slider_min      = 0.f;
       float slider_max      = 100.f;
@@ -493,6 +497,11 @@ namespace cx
 
       /// @brief Set the foreground and knob based on progress.
       void reposition_knob();
+
+      /// @brief Draw the foreground cut to the progress.
+      /// @param target Target to draw to.
+      /// @param shader Shader.
+      void render_foreground(sf::RenderTarget& target, const sf::Shader* shader) const;
    };
 }
 
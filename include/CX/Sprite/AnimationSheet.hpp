@@ -0,0 +1,111 @@
+#ifndef CX_SPRITE_ANIMATION_SHEET_HPP
+#define CX_SPRITE_ANIMATION_SHEET_HPP
+
+#include "CX/Sprite/Animation.hpp"
+#include "CX/Vector/Vec4.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cx
+{
+   /// @brief Handle of an animation inside an animation sheet.
+   using AnimationId = uint32_t;
+
+   /// @brief Handle of no animation.
+   constexpr AnimationId no_animation = AnimationId(-1);
+
+   /// @brief Compiled animation, a range of frames inside its sheet.
+   struct AnimationClip
+   {
+      uint32_t first {};  ///< @brief Index of the first frame.
+      uint32_t length {}; ///< @brief Animation length in frames.
+      float speed {};     ///< @brief Time between frames.
+      bool looping {};    ///< @brief Should animation loop.
+      bool reversed {};   ///< @brief Should animation be reversed.
+   };
+
+   /// @brief Animations compiled into a table of frame rects, addressed by handles.
+   /// Names are only needed to find handles, playing an animation is just indexing.
+   /// Share one sheet between all sprites using the same texture.
+   class AnimationSheet
+   {
+   public:
+      // Constructors
+
+      /// @brief Create an empty sheet.
+      AnimationSheet() = default;
+
+      // Animation functions
+
+      /// @brief Compile an animation of frames laid out in a row.
+      /// An existing animation with the same name is kept.
+      /// @param identifier Animation identifier.
+      /// @param animation Animation.
+      /// @return Handle of the animation.
+      AnimationId add(const std::string& identifier, const Animation& animation);
+
+      /// @brief Add an animation from its frame rects.
+      /// An existing animation with the same name is kept.
+      /// @param identifier Animation identifier.
+      /// @param frames Frame rects in play order.
+      /// @param speed Time between frames.
+      /// @param looping Should animation loop.
+      /// @param reversed Should animation be reversed.
+      /// @return Handle of the animation.
+      AnimationId add(const std::string& identifier,
+                      std::span<const Vec4i> frames,
+                      float speed,
+                      bool looping = true,
+                      bool reversed = false);
+
+      /// @brief Remove all animations.
+      void clear();
+
+      // Getter functions
+
+      /// @brief Find handle of an animation.
+      /// @param identifier Animation identifier.
+      /// @return Handle, no_animation if not found.
+      AnimationId find(const std::string& identifier) const;
+
+      /// @brief Check if a handle belongs to an animation of the sheet.
+      /// @param id Handle.
+      /// @return True if valid.
+      bool contains(AnimationId id) const;
+
+      /// @brief Get an animation.
+      /// @param id Handle, must be valid.
+      /// @return Animation.
+      const AnimationClip& get_clip(AnimationId id) const;
+
+      /// @brief Get a frame rect of an animation.
+      /// @param id Handle, must be valid.
+      /// @param index Frame index, must be less than the animation length.
+      /// @return Frame rect.
+      const Vec4i& get_frame(AnimationId id, size_t index) const;
+
+      /// @brief Get name of an animation.
+      /// @param id Handle.
+      /// @return Name, empty if the handle is not valid.
+      const std::string& get_name(AnimationId id) const;
+
+      /// @brief Get frame rects of every animation.
+      /// @return Frame rects.
+      const std::vector<Vec4i>& get_frames() const;
+
+      /// @brief Get count of animations.
+      /// @return Animation count.
+      size_t size() const;
+
+   private:
+      std::vector<AnimationClip> clips;
+      std::vector<Vec4i> frames;
+      std::vector<std::string> names;
+      std::unordered_map<std::string, AnimationId> ids;
+   };
+}
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef CX_SPRITE_ANIMATION_SYSTEM_HPP
+#define CX_SPRITE_ANIMATION_SYSTEM_HPP
+
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include "CX/Color.hpp"
+#include "CX/Render/RenderBatch.hpp"
+#include "CX/Sprite/AnimationSheet.hpp"
+#include <memory>
+
+namespace cx
+{
+   /// @brief Animate many sprites sharing one sheet and texture, drawn in one call.
+   /// States live in contiguous arrays and are advanced together, then changed
+   /// frames and quads are written straight into one vertex buffer.
+   /// Sprites are addressed by handles which stay valid until they are removed.
+   class AnimationSystem
+   {
+   public:
+      using Handle = uint32_t;
+
+      static constexpr Handle no_handle = Handle(-1); ///< @brief Handle of no sprite.
+
+      // Constructors
+
+      /// @brief Create an empty system, set a sheet before adding sprites.
+      AnimationSystem() = default;
+
+      /// @brief Create a new system.
+      /// @param sheet Animation sheet.
+      /// @param texture Texture the frames are taken from.
+      AnimationSystem(std::shared_ptr<const AnimationSheet> sheet, const sf::Texture* texture = nullptr);
+
+      // Sprite functions
+
+      /// @brief Add a sprite.
+      /// @param position Center position.
+      /// @param size Size.
+      /// @param animation Animation to play, no_animation to add it stopped.
+      /// @return Handle of the sprite.
+      Handle add(const Vec2f& position, const Vec2f& size, AnimationId animation = no_animation);
+
+      /// @brief Remove a sprite, does nothing if the handle is not in the system.
+      /// @param handle Handle.
+      void remove(Handle handle);
+
+      /// @brief Remove all sprites.
+      void clear();
+
+      /// @brief Reserve memory for sprites.
+      /// @param count Sprite count.
+      void reserve(size_t count);
+
+      /// @brief Check if a handle belongs to a sprite of the system.
+      /// @param handle Handle.
+      /// @return True if valid.
+      bool contains(Handle handle) const;
+
+      // Animation functions
+
+      /// @brief Play an animation.
+      /// @param handle Handle.
+      /// @param animation Animation, no_animation to stop.
+      /// @param reset Should it restart if the animation is already playing.
+      void play(Handle handle, AnimationId animation, bool reset = false);
+
+      /// @brief Pause the animation of a sprite.
+      /// @param handle Handle.
+      void pause(Handle handle);
+
+      /// @brief Resume the animation of a sprite.
+      /// @param handle Handle.
+      void resume(Handle handle);
+
+      // Setter functions
+
+      /// @brief Change animation sheet, every sprite restarts its animation if the new sheet has it.
+      /// @param sheet Animation sheet.
+      void set_sheet(std::shared_ptr<const AnimationSheet> sheet);
+
+      /// @brief Change texture.
+      /// @param texture Texture.
+      void set_texture(const sf::Texture* texture);
+
+      /// @brief Change animation played after a non-looping animation ends.
+      /// Without one the sprite stops on the last frame.
+      /// @param handle Handle.
+      /// @param animation Animation.
+      void set_default_animation(Handle handle, AnimationId animation);
+
+      /// @brief Change speed multiplier of a sprite.
+      /// @param handle Handle.
+      /// @param multiplier Speed multiplier.
+      void set_speed_multiplier(Handle handle, float multiplier);
+
+      /// @brief Change center position of a sprite.
+      /// @param handle Handle.
+      /// @param position Position.
+      void set_position(Handle handle, const Vec2f& position);
+
+      /// @brief Change size of a sprite.
+      /// @param handle Handle.
+      /// @param size Size.
+      void set_size(Handle handle, const Vec2f& size);
+
+      /// @brief Change rotation of a sprite.
+      /// @param handle Handle.
+      /// @param angle Rotation in degrees.
+      void set_rotation(Handle handle, float angle);
+
+      /// @brief Change color of a sprite.
+      /// @param handle Handle.
+      /// @param color Color.
+      void set_color(Handle handle, const Color& color);
+
+      // Getter functions
+
+      /// @brief Get count of sprites.
+      /// @return Sprite count.
+      size_t size() const;
+
+      /// @brief Get animation sheet.
+      /// @return Animation sheet.
+      const std::shared_ptr<const AnimationSheet>& get_sheet() const;
+
+      /// @brief Get texture.
+      /// @return Texture.
+      const sf::Texture* get_texture() const;
+
+      /// @brief Get animation of a sprite.
+      /// @param handle Handle.
+      /// @return Animation, no_animation if stopped.
+      AnimationId get_animation(Handle handle) const;
+
+      /// @brief Get index of the frame shown by a sprite inside its animation.
+      /// @param handle Handle.
+      /// @return Frame index.
+      size_t get_frame_index(Handle handle) const;
+
+      /// @brief Check if the animation of a sprite is playing.
+      /// @param handle Handle.
+      /// @return True if playing.
+      bool is_playing(Handle handle) const;
+
+      /// @brief Get center position of a sprite.
+      /// @param handle Handle.
+      /// @return Position.
+      const Vec2f& get_position(Handle handle) const;
+
+      /// @brief Get vertices of every sprite, 6 per sprite.
+      /// @return Vertices.
+      const sf::VertexArray& get_vertices() const;
+
+      // Update functions
+
+      /// @brief Advance every animation and rewrite changed vertices.
+      /// Call once per frame before rendering, also after changing sprites.
+      /// @param dt Delta time.
+      void update(float dt);
+
+      // Render functions
+
+      /// @brief Render every sprite.
+      /// @param window Window to draw to.
+      void render(sf::RenderWindow& window) const;
+
+      /// @brief Render every sprite.
+      /// @param window Window to draw to.
+      /// @param shader Shader.
+      void render(sf::RenderWindow& window, const sf::Shader* shader) const;
+
+      /// @brief Submit every sprite to a render batch.
+      /// @param batch Render batch.
+      /// @param layer Layer.
+      void submit(RenderBatch& batch, int layer = 0) const;
+
+   private:
+      /// @brief Structure-of-arrays states of the sprites, index i of every array belongs to the same sprite.
+      struct States
+      {
+         std::vector<Handle> handle;
+         std::vector<AnimationId> animation;
+         std::vector<AnimationId> idle;
+         std::vector<uint32_t> first;
+         std::vector<uint32_t> length;
+         std::vector<uint32_t> step;
+         std::vector<uint32_t> advanced;
+         std::vector<float> elapsed;
+         std::vector<float> period;
+         std::vector<float> rate;
+         std::vector<float> speed_mult;
+         std::vector<uint8_t> playing;
+         std::vector<uint8_t> looping;
+         std::vector<uint8_t> reversed;
+         std::vector<uint8_t> ended;
+         std::vector<uint8_t> frame_dirty;
+         std::vector<uint8_t> quad_dirty;
+         std::vector<Vec2f> position;
+         std::vector<Vec2f> size;
+         std::vector<float> rotation;
+         std::vector<Color> color;
+
+         /// @brief Call a function with every array.
+         /// @param func Function.
+         template<typename Func>
+         void for_each_array(Func&& func)
+         {
+            func(handle); func(animation); func(idle); func(first); func(length); func(step);
+            func(advanced); func(elapsed); func(period); func(rate); func(speed_mult);
+            func(playing); func(looping); func(reversed); func(ended); func(frame_dirty);
+            func(quad_dirty); func(position); func(size); func(rotation); func(color);
+         }
+      };
+
+      std::shared_ptr<const AnimationSheet> sheet;
+      const sf::Texture* texture = nullptr;
+      sf::VertexArray vertices {sf::Triangles};
+
+      States states;
+      std::vector<uint32_t> slots;
+      std::vector<Handle> free_handles;
+
+      static constexpr uint32_t no_slot = uint32_t(-1);
+
+      /// @brief Get index of a sprite, the handle must be in the system.
+      /// @param handle Handle.
+      /// @return Sprite index.
+      size_t get_index(Handle handle) const;
+
+      /// @brief Start an animation of a sprite from its first frame.
+      /// @param i Sprite index.
+      /// @param animation Animation.
+      void start(size_t i, AnimationId animation);
+
+      /// @brief Update frame rate of a sprite from its animation and speed multiplier.
+      /// @param i Sprite index.
+      void update_rate(size_t i);
+
+      /// @brief Write the quad of a sprite.
+      /// @param i Sprite index.
+      void write_quad(size_t i);
+
+      /// @brief Write texture coordinates of the frame shown by a sprite.
+      /// @param i Sprite index.
+      void write_frame(size_t i);
+   };
+}
+
+#endif
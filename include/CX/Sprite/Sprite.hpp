@@ -1,10 +1,12 @@
 #ifndef CX_SPRITE_SPRITE_HPP
 #define CX_SPRITE_SPRITE_HPP
 
-#include <SFML/Graphics/RectangleShape.hpp>
-#include "CX/Sprite/Animation.hpp"
+#include "CX/Atlas/TextureRegion.hpp"
+#include "CX/Render/Quad.hpp"
+#include "CX/Sprite/AnimationSheet.hpp"
 #include "CX/Sprite/SpriteStyle.hpp"
 #include "CX/UIElement/UIElement.hpp"
+#include <memory>
 
 namespace cx
 {
@@ -76,6 +78,10 @@ namespace cx
       /// @param texture New texture.
       void set_texture(const sf::Texture* texture);
 
+      /// @brief Change texture and texture rectangle of the sprite.
+      /// @param region New texture region, such as an image from a texture atlas.
+      void set_texture(const TextureRegion& region);
+
       /// @brief Change texture rectangle of the sprite.
       /// @param rect New texture rectangle.
       void set_texture_rect(const Vec4i& rect);
@@ -154,22 +160,37 @@ namespace cx
       void advance_frame();
 
       /// @brief Add new animation to the list.
+      /// A sheet shared with other sprites is copied first.
       /// @param identifier Animation identifier.
       /// @param animation Animation.
       /// @param default_animation Should animation be default.
-      void add_animation(const std::string& identifier,
-                         const Animation& animation,
-                         bool default_animation = false);
+      /// @return Handle of the animation.
+      AnimationId add_animation(const std::string& identifier,
+                                const Animation& animation,
+                                bool default_animation = false);
+
+      /// @brief Use a sheet of animations, stops the playing animation.
+      /// @param sheet Animation sheet, may be shared between sprites.
+      void set_animation_sheet(std::shared_ptr<const AnimationSheet> sheet);
 
       /// @brief Set default animation.
       /// @param identifier Animation identifier.
       void set_default_animation(const std::string& identifier);
 
+      /// @brief Set default animation.
+      /// @param id Animation handle.
+      void set_default_animation(AnimationId id);
+
       /// @brief Play animation.
       /// @param identifier Animation identifier.
       /// @param reset Should it reset if animation is already playing.
       void play_animation(const std::string& identifier, bool reset = false);
 
+      /// @brief Play animation.
+      /// @param id Animation handle.
+      /// @param reset Should it reset if animation is already playing.
+      void play_animation(AnimationId id, bool reset = false);
+
       /// @brief Check if animation is finished.
       /// @return True if finished.
       bool is_animation_finished() const;
@@ -206,37 +227,51 @@ namespace cx
       /// @return Name.
       const std::string& get_default_animation() const;
 
+      /// @brief Get handle of the playing animation.
+      /// @return Handle, no_animation if nothing is playing.
+      AnimationId get_playing_animation_id() const;
+
+      /// @brief Get handle of the default animation.
+      /// @return Handle, no_animation if there is none.
+      AnimationId get_default_animation_id() const;
+
+      /// @brief Get sheet of animations.
+      /// @return Animation sheet, null if there are no animations.
+      const std::shared_ptr<const AnimationSheet>& get_animation_sheet() const;
+
       /// @brief Clear all animations.
       void clear_animations();
 
       // Render functions
 
       /// @brief Render the sprite.
-      /// @param window Window to draw to.
-      void render(sf::RenderWindow& window) const override;
+      /// @param target Target to draw to.
+      void render(sf::RenderTarget& target) const override;
 
       /// @brief Render the sprite.
-      /// @param window Window to draw to.
+      /// @param target Target to draw to.
       /// @param shader Shader.
-      void render(sf::RenderWindow& window,
+      void render(sf::RenderTarget& target,
                   const sf::Shader* shader) const override;
 
+      /// @brief Submit the sprite to a render batch.
+      /// @param batch Render batch.
+      /// @param layer Layer.
+      void submit(RenderBatch& batch, int layer = 0) const override;
+
       // Access functions
 
       /// @brief Get sprite.
       /// @return Sprite.
-      sf::RectangleShape& get_sprite();
-
-      /// @brief Get animations.
-      /// @return Animations.
-      std::unordered_map<std::string, Animation>& get_animations();
+      Quad& get_sprite();
 
    private:
-      sf::RectangleShape rect;
+      Quad rect;
 
-      std::unordered_map<std::string, Animation> animations;
-      std::string current_animation;
-      std::string idle;
+      std::shared_ptr<const AnimationSheet> sheet;
+      std::shared_ptr<AnimationSheet> owned_sheet; ///< @brief Same sheet as sheet when this sprite created it.
+      AnimationId current_animation = no_animation;
+      AnimationId idle              = no_animation;
 
       bool playing      = false;
       size_t index      = 0;
@@ -12,6 +12,8 @@ namespace sf
 
 namespace cx
 {
+   class AnimationSheet;
+
    /// @brief Save styles between sprites.
    struct SpriteStyle
    {
@@ -32,6 +34,9 @@ namespace cx
       /// @brief Color of the sprite.
       Color color = Color(255);
 
+      /// @brief Animations of the sprite, shared by every sprite using the style.
+      std::shared_ptr<const AnimationSheet> animations;
+
       /// @brief Access first style.
       /// @return First style.
       static SpriteStyle& style1()
@@ -0,0 +1,84 @@
+#ifndef CX_TEXT_GLYPH_RUN_HPP
+#define CX_TEXT_GLYPH_RUN_HPP
+
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace cx
+{
+   /// @brief Cached glyph quads of a text, so many texts sharing a font page can be drawn together.
+   /// Quads are laid out the same way sf::Text lays them out and are only rebuilt when
+   /// the string, font or any property affecting them changed.
+   class GlyphRun
+   {
+   public:
+      // Constructors
+
+      /// @brief Create an empty glyph run.
+      GlyphRun() = default;
+
+      // Update functions
+
+      /// @brief Rebuild glyph quads if the text changed since the last update.
+      /// @param text Text.
+      /// @return True if rebuilt.
+      bool update(const sf::Text& text);
+
+      /// @brief Rebuild glyph quads on the next update.
+      void invalidate();
+
+      // Getter functions
+
+      /// @brief Get glyph quads in local coordinates of the text, 6 vertices per quad.
+      /// Outline quads come first, so the fill is drawn over them.
+      /// @return Vertices.
+      const std::vector<sf::Vertex>& get_vertices() const;
+
+      /// @brief Get count of outline vertices at the start of the vertices.
+      /// @return Vertex count.
+      size_t get_outline_count() const;
+
+      /// @brief Get font page the quads are taken from.
+      /// @return Texture, null if there is nothing to draw.
+      const sf::Texture* get_texture() const;
+
+      /// @brief Get how many times the quads were rebuilt.
+      /// @return Rebuild count.
+      size_t get_rebuild_count() const;
+
+   private:
+      /// @brief Properties of the text the quads were built from.
+      /// The string is kept as its length and hash, so checking it needs no copy.
+      struct Key
+      {
+         size_t length = 0u;
+         uint64_t hash = 0u;
+         const sf::Font* font = nullptr;
+         unsigned size = 0u;
+         sf::Uint32 style = 0u;
+         float letter_spacing = 0.f;
+         float line_spacing = 0.f;
+         float outline_thickness = 0.f;
+         sf::Color fill_color;
+         sf::Color outline_color;
+
+         bool operator==(const Key& other) const;
+      };
+
+      Key key;
+      bool built = false;
+      std::vector<sf::Vertex> vertices;
+      std::vector<sf::Vertex> fill;
+      size_t outline_count = 0u;
+      const sf::Texture* texture = nullptr;
+      size_t rebuild_count = 0u;
+
+      /// @brief Lay out the glyph quads of a text.
+      /// @param string String of the text, the rest is taken from the key.
+      void build(const sf::String& string);
+   };
+}
+
+#endif
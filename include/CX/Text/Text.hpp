@@ -3,6 +3,7 @@
 
 #include <SFML/Graphics/Text.hpp>
 #include "CX/Text/FontStyle.hpp"
+#include "CX/Text/GlyphRun.hpp"
 #include "CX/Text/TextStyle.hpp"
 #include "CX/UIElement/UIElement.hpp"
 
@@ -211,13 +212,18 @@ namespace cx
       // Render functions
 
       /// @brief Render the text.
-      /// @param window Window to draw to.
-      void render(sf::RenderWindow& window) const override;
+      /// @param target Target to draw to.
+      void render(sf::RenderTarget& target) const override;
 
       /// @brief Render the text.
-      /// @param window Window to draw to.
+      /// @param target Target to draw to.
       /// @param shader Shader.
-      void render(sf::RenderWindow& window, const sf::Shader* shader) const override;
+      void render(sf::RenderTarget& target, const sf::Shader* shader) const override;
+
+      /// @brief Submit the text to a render batch.
+      /// @param batch Render batch.
+      /// @param layer Layer.
+      void submit(RenderBatch& batch, int layer = 0) const override;
 
       // Access functions
 
@@ -227,6 +233,7 @@ namespace cx
 
    private:
       sf::Text text;
+      mutable GlyphRun glyphs;
 
       /// @brief Recenter the text.
       void recenter();
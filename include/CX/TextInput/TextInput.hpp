@@ -1,11 +1,12 @@
 #ifndef CX_TEXTINPUT_TEXTINPUT_HPP
 #define CX_TEXTINPUT_TEXTINPUT_HPP
 
-#include <SFML/Graphics/RectangleShape.hpp>
 #include <SFML/Graphics/Text.hpp>
 #include "CX/EventHandler/Controller.hpp"
 #include "CX/EventHandler/Key.hpp"
+#include "CX/Render/Quad.hpp"
 #include "CX/Text/FontStyle.hpp"
+#include "CX/Text/GlyphRun.hpp"
 #include "CX/TextInput/TextInputStyle.hpp"
 #include "CX/UIElement/UIElement.hpp"
 
@@ -289,19 +290,24 @@ namespace cx
       // Render functions
 
       /// @brief Render the input.
-      /// @param window Window to draw to.
-      void render(sf::RenderWindow& window) const override;
+      /// @param target Target to draw to.
+      void render(sf::RenderTarget& target) const override;
 
       /// @brief Render the input.
-      /// @param window Window to draw to.
+      /// @param target Target to draw to.
       /// @param shader Shader.
-      void render(sf::RenderWindow& window, const sf::Shader* shader) const override;
+      void render(sf::RenderTarget& target, const sf::Shader* shader) const override;
+
+      /// @brief Submit the input to a render batch.
+      /// @param batch Render batch.
+      /// @param layer Layer.
+      void submit(RenderBatch& batch, int layer = 0) const override;
 
    // Access functions
 
    /// @brief Get background.
    /// @return Background.
-   sf::RectangleShape& get_background();
+   Quad& get_background();
 
    /// @brief Get text.
    /// @return Text.
@@ -319,8 +325,9 @@ namespace cx
       Key enter_key        = Key::enter;
       Controller enter_btn = Controller::a;
 
-      sf::RectangleShape rect;
+      Quad rect;
       sf::Text text;
+      mutable GlyphRun glyphs;
 
       /// @brief Recenter the text.
       void recenter();
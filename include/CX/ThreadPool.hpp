@@ -0,0 +1,74 @@
+#ifndef CX_THREAD_POOL_HPP
+#define CX_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cx
+{
+   /// @brief Fixed set of worker threads running submitted tasks.
+   class ThreadPool
+   {
+   public:
+      // Constructors
+
+      /// @brief Create a thread pool with one worker less than hardware threads.
+      ThreadPool();
+
+      /// @brief Create a new thread pool.
+      /// @param thread_count Count of worker threads, tasks run on the calling thread if 0.
+      ThreadPool(size_t thread_count);
+
+      /// @brief Finish all queued tasks and join the workers.
+      ~ThreadPool();
+
+      ThreadPool(const ThreadPool&) = delete;
+      ThreadPool& operator=(const ThreadPool&) = delete;
+
+      // Getter functions
+
+      /// @brief Get count of worker threads.
+      /// @return Thread count.
+      size_t get_thread_count() const;
+
+      /// @brief Get count of tasks waiting or running.
+      /// @return Task count.
+      size_t get_pending_count() const;
+
+      // Task functions
+
+      /// @brief Queue a task to run on a worker.
+      /// @param task Task.
+      void submit(std::function<void()> task);
+
+      /// @brief Split [0, count) into chunks and run them in parallel, returns once all are done.
+      /// The calling thread runs chunks too. The first exception thrown by a chunk is rethrown.
+      /// @param count Count of items.
+      /// @param chunk_size Maximum count of items per chunk.
+      /// @param func Function taking the first and past-the-end index of a chunk.
+      void parallel_for(size_t count, size_t chunk_size,
+                        const std::function<void(size_t, size_t)>& func);
+
+      /// @brief Wait until every queued task has finished.
+      void wait();
+
+   private:
+      std::vector<std::thread> workers;
+      std::deque<std::function<void()>> tasks;
+
+      mutable std::mutex mutex;
+      std::condition_variable task_condition;
+      std::condition_variable done_condition;
+      size_t running = 0u;
+      bool stopping = false;
+
+      /// @brief Worker thread loop.
+      void work();
+   };
+}
+
+#endif
@@ -10,6 +10,8 @@
 
 namespace cx
 {
+   class RenderBatch;
+
    /// @brief Modify and display UI elements.
    class UIElement
    {
@@ -287,6 +289,11 @@ namespace cx
       /// @return Opacity.
       unsigned char get_opacity() const;
 
+      /// @brief Get revision of the element, it changes every time the element is modified.
+      /// Changes made through access functions are not counted.
+      /// @return Revision.
+      uint32_t get_revision() const;
+
       // Update functions
 
       /// @brief Flip the element horizontally.
@@ -375,13 +382,19 @@ namespace cx
       // Render functions
 
       /// @brief Render the element.
-      /// @param window Window to draw to.
-      virtual void render(sf::RenderWindow& window) const = 0;
+      /// @param target Target to draw to.
+      virtual void render(sf::RenderTarget& target) const = 0;
 
       /// @brief Render the element.
-      /// @param window Window to draw to.
+      /// @param target Target to draw to.
       /// @param shader Shader.
-      virtual void render(sf::RenderWindow& window, const sf::Shader* shader) const = 0;
+      virtual void render(sf::RenderTarget& target, const sf::Shader* shader) const = 0;
+
+      /// @brief Submit the element to a render batch, drawn on the next flush.
+      /// By default the element gets its own draw call through render.
+      /// @param batch Render batch.
+      /// @param layer Layer.
+      virtual void submit(RenderBatch& batch, int layer = 0) const;
 
    protected:
       bool was_hover  = false;
@@ -389,6 +402,7 @@ namespace cx
       bool clicked    = false;
       bool mouse_down = false;
       bool mouse_up   = false;
+      uint32_t revision = 0u;
 
       using func = std::function<void(UIElement&)>;
       std::shared_ptr<func> on_update_func = std::make_shared<func>([](UIElement&){});
@@ -397,6 +411,21 @@ namespace cx
       /// @param state Mouse state.
       /// @param local Should local boundaries be used.
       void update_state(const MouseState& state, bool local = false);
+
+      /// @brief Bump the revision after a modification.
+      void mark_changed();
+
+   private:
+      /// @brief Draws an element through render, for elements without their own submit.
+      struct ElementDrawable : sf::Drawable
+      {
+         const UIElement* element = nullptr;
+
+         void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+      };
+
+      /// @brief Set on every submit, so copies of the element never draw the original.
+      mutable ElementDrawable drawable;
    };
 }
 
@@ -0,0 +1,100 @@
+#include "CX/Sprite/AnimationSheet.hpp"
+
+namespace cx
+{
+   static const std::string empty_string;
+
+   // Animation functions
+
+   AnimationId AnimationSheet::add(const std::string& identifier, const Animation& animation)
+   {
+      if (const auto found = ids.find(identifier); found != ids.end())
+         return found->second;
+
+      std::vector<Vec4i> rects;
+      rects.reserve(animation.length);
+
+      for (unsigned i = 0; i < animation.length; ++i)
+      {
+         rects.emplace_back(
+            int(animation.posX + (animation.gap + animation.sizeX) * i),
+            int(animation.posY),
+            int(animation.sizeX),
+            int(animation.sizeY)
+         );
+      }
+
+      return add(identifier, rects, animation.speed, animation.looping, animation.reversed);
+   }
+
+   AnimationId AnimationSheet::add(const std::string& identifier,
+                                   std::span<const Vec4i> frames,
+                                   float speed,
+                                   bool looping,
+                                   bool reversed)
+   {
+      if (const auto found = ids.find(identifier); found != ids.end())
+         return found->second;
+
+      const AnimationId id = static_cast<AnimationId>(clips.size());
+
+      clips.push_back(AnimationClip {
+         static_cast<uint32_t>(this->frames.size()),
+         static_cast<uint32_t>(frames.size()),
+         speed,
+         looping,
+         reversed
+      });
+      this->frames.insert(this->frames.end(), frames.begin(), frames.end());
+      names.push_back(identifier);
+      ids.emplace(identifier, id);
+
+      return id;
+   }
+
+   void AnimationSheet::clear()
+   {
+      clips.clear();
+      frames.clear();
+      names.clear();
+      ids.clear();
+   }
+
+   // Getter functions
+
+   AnimationId AnimationSheet::find(const std::string& identifier) const
+   {
+      const auto found = ids.find(identifier);
+      return found == ids.end() ? no_animation : found->second;
+   }
+
+   bool AnimationSheet::contains(AnimationId id) const
+   {
+      return id < clips.size();
+   }
+
+   const AnimationClip& AnimationSheet::get_clip(AnimationId id) const
+   {
+      return clips[id];
+   }
+
+   const Vec4i& AnimationSheet::get_frame(AnimationId id, size_t index) const
+   {
+      return frames[clips[id].first + index];
+   }
+
+   const std::string& AnimationSheet::get_name(AnimationId id) const
+   {
+      return contains(id) ? names[id] : empty_string;
+   }
+
+   const std::vector<Vec4i>& AnimationSheet::get_frames() const
+   {
+      return frames;
+   }
+
+   size_t AnimationSheet::size() const
+   {
+      return clips.size();
+   }
+}
@@ -0,0 +1,414 @@
+#include "CX/Sprite/AnimationSystem.hpp"
+
+#include "CX/Math/Angle.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace cx
+{
+   // Constructors
+
+   AnimationSystem::AnimationSystem(std::shared_ptr<const AnimationSheet> sheet, const sf::Texture* texture)
+      : sheet(std::move(sheet)), texture(texture) {}
+
+   // Sprite functions
+
+   AnimationSystem::Handle AnimationSystem::add(const Vec2f& position, const Vec2f& size, AnimationId animation)
+   {
+      Handle handle;
+      if (free_handles.empty())
+      {
+         handle = static_cast<Handle>(slots.size());
+         slots.push_back(no_slot);
+      }
+      else
+      {
+         handle = free_handles.back();
+         free_handles.pop_back();
+      }
+
+      const size_t i = states.handle.size();
+      states.for_each_array([](auto& array) { array.emplace_back(); });
+
+      states.handle[i] = handle;
+      states.animation[i] = no_animation;
+      states.idle[i] = no_animation;
+      states.speed_mult[i] = 1.f;
+      states.position[i] = position;
+      states.size[i] = size;
+      states.color[i] = Color(255);
+      states.quad_dirty[i] = 1u;
+
+      slots[handle] = static_cast<uint32_t>(i);
+      vertices.resize(states.handle.size() * 6u);
+      start(i, animation);
+
+      return handle;
+   }
+
+   void AnimationSystem::remove(Handle handle)
+   {
+      if (!contains(handle))
+         return;
+
+      // Move the last sprite into the gap to keep the arrays dense
+      const size_t i = slots[handle];
+      const size_t last = states.handle.size() - 1u;
+
+      if (i != last)
+      {
+         states.for_each_array([i, last](auto& array) { array[i] = std::move(array[last]); });
+         slots[states.handle[i]] = static_cast<uint32_t>(i);
+         states.quad_dirty[i] = 1u;
+         states.frame_dirty[i] = 1u;
+      }
+
+      states.for_each_array([](auto& array) { array.pop_back(); });
+      slots[handle] = no_slot;
+      free_handles.push_back(handle);
+      vertices.resize(states.handle.size() * 6u);
+   }
+
+   void AnimationSystem::clear()
+   {
+      states.for_each_array([](auto& array) { array.clear(); });
+      slots.clear();
+      free_handles.clear();
+      vertices.clear();
+   }
+
+   void AnimationSystem::reserve(size_t count)
+   {
+      states.for_each_array([count](auto& array) { array.reserve(count); });
+   }
+
+   bool AnimationSystem::contains(Handle handle) const
+   {
+      return handle < slots.size() && slots[handle] != no_slot;
+   }
+
+   // Animation functions
+
+   void AnimationSystem::play(Handle handle, AnimationId animation, bool reset)
+   {
+      const size_t i = get_index(handle);
+
+      if (!reset && animation == states.animation[i] && states.playing[i])
+         return;
+
+      start(i, animation);
+   }
+
+   void AnimationSystem::pause(Handle handle)
+   {
+      states.playing[get_index(handle)] = 0u;
+   }
+
+   void AnimationSystem::resume(Handle handle)
+   {
+      const size_t i = get_index(handle);
+      states.playing[i] = states.animation[i] != no_animation;
+   }
+
+   // Setter functions
+
+   void AnimationSystem::set_sheet(std::shared_ptr<const AnimationSheet> sheet)
+   {
+      this->sheet = std::move(sheet);
+
+      for (size_t i = 0; i < states.handle.size(); ++i)
+         start(i, states.animation[i]);
+   }
+
+   void AnimationSystem::set_texture(const sf::Texture* texture)
+   {
+      this->texture = texture;
+   }
+
+   void AnimationSystem::set_default_animation(Handle handle, AnimationId animation)
+   {
+      states.idle[get_index(handle)] = animation;
+   }
+
+   void AnimationSystem::set_speed_multiplier(Handle handle, float multiplier)
+   {
+      const size_t i = get_index(handle);
+      states.speed_mult[i] = multiplier;
+      update_rate(i);
+   }
+
+   void AnimationSystem::set_position(Handle handle, const Vec2f& position)
+   {
+      const size_t i = get_index(handle);
+      states.position[i] = position;
+      states.quad_dirty[i] = 1u;
+   }
+
+   void AnimationSystem::set_size(Handle handle, const Vec2f& size)
+   {
+      const size_t i = get_index(handle);
+      states.size[i] = size;
+      states.quad_dirty[i] = 1u;
+   }
+
+   void AnimationSystem::set_rotation(Handle handle, float angle)
+   {
+      const size_t i = get_index(handle);
+      states.rotation[i] = angle;
+      states.quad_dirty[i] = 1u;
+   }
+
+   void AnimationSystem::set_color(Handle handle, const Color& color)
+   {
+      const size_t i = get_index(handle);
+      states.color[i] = color;
+      states.quad_dirty[i] = 1u;
+   }
+
+   // Getter functions
+
+   size_t AnimationSystem::size() const
+   {
+      return states.handle.size();
+   }
+
+   const std::shared_ptr<const AnimationSheet>& AnimationSystem::get_sheet() const
+   {
+      return sheet;
+   }
+
+   const sf::Texture* AnimationSystem::get_texture() const
+   {
+      return texture;
+   }
+
+   AnimationId AnimationSystem::get_animation(Handle handle) const
+   {
+      return states.animation[get_index(handle)];
+   }
+
+   size_t AnimationSystem::get_frame_index(Handle handle) const
+   {
+      const size_t i = get_index(handle);
+      return states.reversed[i] ? states.length[i] - 1u - states.step[i] : states.step[i];
+   }
+
+   bool AnimationSystem::is_playing(Handle handle) const
+   {
+      return states.playing[get_index(handle)] != 0u;
+   }
+
+   const Vec2f& AnimationSystem::get_position(Handle handle) const
+   {
+      return states.position[get_index(handle)];
+   }
+
+   const sf::VertexArray& AnimationSystem::get_vertices() const
+   {
+      return vertices;
+   }
+
+   // Update functions
+
+   void AnimationSystem::update(float dt)
+   {
+      const size_t count = states.handle.size();
+
+      // Plain loops over raw arrays so the compiler can vectorize them
+      float* const elapsed = states.elapsed.data();
+      const float* const period = states.period.data();
+      const float* const rate = states.rate.data();
+      const uint8_t* const playing = states.playing.data();
+      uint32_t* const advanced = states.advanced.data();
+
+      // Accumulate time and count frames to advance, a long hitch cannot step forever
+      constexpr float max_steps = 65536.f;
+
+      for (size_t i = 0; i < count; ++i)
+      {
+         const float time = elapsed[i] + (playing[i] ? dt : 0.f);
+         const uint32_t steps = static_cast<uint32_t>(std::min(time * rate[i], max_steps));
+         advanced[i] = steps;
+         elapsed[i] = time - float(steps) * period[i];
+      }
+
+      // Step frames, wrapping looping animations and holding the others on their last frame
+      uint32_t* const step = states.step.data();
+      const uint32_t* const length = states.length.data();
+      const uint8_t* const looping = states.looping.data();
+      uint8_t* const ended = states.ended.data();
+      uint8_t* const frame_dirty = states.frame_dirty.data();
+      uint8_t any_ended = 0u;
+
+      for (size_t i = 0; i < count; ++i)
+      {
+         const uint32_t next = step[i] + advanced[i];
+         const uint32_t last = length[i] - 1u;
+         const bool over = next > last;
+
+         step[i] = over ? (looping[i] ? next % length[i] : last) : next;
+         ended[i] = over && !looping[i];
+         frame_dirty[i] |= advanced[i] != 0u;
+         any_ended |= ended[i];
+      }
+
+      // Finished animations go back to the default one or stop
+      if (any_ended)
+      {
+         for (size_t i = 0; i < count; ++i)
+         {
+            if (!ended[i])
+               continue;
+
+            ended[i] = 0u;
+            if (states.idle[i] != no_animation)
+               start(i, states.idle[i]);
+            else
+            {
+               states.playing[i] = 0u;
+               states.elapsed[i] = 0.f;
+            }
+         }
+      }
+
+      for (size_t i = 0; i < count; ++i)
+      {
+         if (states.quad_dirty[i])
+         {
+            write_quad(i);
+            states.quad_dirty[i] = 0u;
+         }
+
+         if (frame_dirty[i])
+         {
+            write_frame(i);
+            frame_dirty[i] = 0u;
+         }
+      }
+   }
+
+   // Render functions
+
+   void AnimationSystem::render(sf::RenderWindow& window) const
+   {
+      render(window, nullptr);
+   }
+
+   void AnimationSystem::render(sf::RenderWindow& window, const sf::Shader* shader) const
+   {
+      if (vertices.getVertexCount() == 0u)
+         return;
+
+      sf::RenderStates render_states;
+      render_states.texture = texture;
+      render_states.shader = shader;
+      window.draw(vertices, render_states);
+   }
+
+   void AnimationSystem::submit(RenderBatch& batch, int layer) const
+   {
+      if (vertices.getVertexCount() != 0u)
+         batch.submit(vertices, texture, layer);
+   }
+
+   // Private functions
+
+   size_t AnimationSystem::get_index(Handle handle) const
+   {
+      assert(contains(handle));
+      return slots[handle];
+   }
+
+   void AnimationSystem::start(size_t i, AnimationId animation)
+   {
+      states.step[i] = 0u;
+      states.elapsed[i] = 0.f;
+      states.ended[i] = 0u;
+      states.frame_dirty[i] = 1u;
+
+      if (!sheet || !sheet->contains(animation) || sheet->get_clip(animation).length == 0u)
+      {
+         states.animation[i] = no_animation;
+         states.first[i] = 0u;
+         states.length[i] = 1u;
+         states.looping[i] = 0u;
+         states.reversed[i] = 0u;
+         states.playing[i] = 0u;
+         update_rate(i);
+         return;
+      }
+
+      const AnimationClip& clip = sheet->get_clip(animation);
+      states.animation[i] = animation;
+      states.first[i] = clip.first;
+      states.length[i] = clip.length;
+      states.looping[i] = clip.looping;
+      states.reversed[i] = clip.reversed;
+      states.playing[i] = 1u;
+      update_rate(i);
+   }
+
+   void AnimationSystem::update_rate(size_t i)
+   {
+      const float speed = states.animation[i] == no_animation ? 0.f : sheet->get_clip(states.animation[i]).speed;
+
+      // Frames per second, 0 never advances
+      states.rate[i] = (speed > 0.f && states.speed_mult[i] > 0.f) ? states.speed_mult[i] / speed : 0.f;
+      states.period[i] = states.rate[i] > 0.f ? 1.f / states.rate[i] : 0.f;
+   }
+
+   void AnimationSystem::write_quad(size_t i)
+   {
+      const Vec2f half = states.size[i] * .5f;
+      const float angle = Rad::convert(states.rotation[i]);
+      const float cos = std::cos(angle);
+      const float sin = std::sin(angle);
+
+      // Rotated half axes of the quad
+      const Vec2f axis_x (half.x * cos, half.x * sin);
+      const Vec2f axis_y (-half.y * sin, half.y * cos);
+      const Vec2f& center = states.position[i];
+
+      const Vec2f top_left     = center - axis_x - axis_y;
+      const Vec2f top_right    = center + axis_x - axis_y;
+      const Vec2f bottom_right = center + axis_x + axis_y;
+      const Vec2f bottom_left  = center - axis_x + axis_y;
+      const sf::Color color    = states.color[i];
+
+      sf::Vertex* quad = &vertices[i * 6u];
+
+      quad[0].position = top_left;
+      quad[1].position = top_right;
+      quad[2].position = bottom_right;
+      quad[3].position = top_left;
+      quad[4].position = bottom_right;
+      quad[5].position = bottom_left;
+
+      for (size_t v = 0; v < 6u; ++v)
+         quad[v].color = color;
+   }
+
+   void AnimationSystem::write_frame(size_t i)
+   {
+      if (states.animation[i] == no_animation)
+         return;
+
+      const uint32_t frame = states.reversed[i] ? states.length[i] - 1u - states.step[i] : states.step[i];
+      const Vec4i& rect = sheet->get_frames()[states.first[i] + frame];
+
+      const sf::Vector2f tex_top_left     (float(rect.x), float(rect.y));
+      const sf::Vector2f tex_top_right    (float(rect.x + rect.w), float(rect.y));
+      const sf::Vector2f tex_bottom_right (float(rect.x + rect.w), float(rect.y + rect.h));
+      const sf::Vector2f tex_bottom_left  (float(rect.x), float(rect.y + rect.h));
+
+      sf::Vertex* quad = &vertices[i * 6u];
+
+      quad[0].texCoords = tex_top_left;
+      quad[1].texCoords = tex_top_right;
+      quad[2].texCoords = tex_bottom_right;
+      quad[3].texCoords = tex_top_left;
+      quad[4].texCoords = tex_bottom_right;
+      quad[5].texCoords = tex_bottom_left;
+   }
+}
@@ -0,0 +1,90 @@
+#include "CX/Asset/AssetId.hpp"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace cx
+{
+   namespace
+   {
+      /// @brief Every name interned so far.
+      struct NameTable
+      {
+         std::deque<std::string> names;                       // Stable, so the keys can view into it
+         std::unordered_map<std::string_view, AssetId::index_t> indices;
+         std::shared_mutex mutex;
+      };
+
+      NameTable& get_table()
+      {
+         static NameTable table;
+         return table;
+      }
+   }
+
+   // Constructors
+
+   AssetId::AssetId(std::string_view name)
+   {
+      NameTable& table = get_table();
+
+      {
+         std::shared_lock<std::shared_mutex> lock(table.mutex);
+
+         if (const auto it = table.indices.find(name); it != table.indices.end())
+         {
+            index = it->second;
+            return;
+         }
+      }
+
+      std::unique_lock<std::shared_mutex> lock(table.mutex);
+
+      // Another thread may have interned it between the locks
+      if (const auto it = table.indices.find(name); it != table.indices.end())
+      {
+         index = it->second;
+         return;
+      }
+
+      // Keyed by a view of the stored copy, not of the caller's string
+      index = index_t(table.names.size());
+      table.indices.emplace(table.names.emplace_back(name), index);
+   }
+
+   // Lookup functions
+
+   AssetId AssetId::find(std::string_view name)
+   {
+      NameTable& table = get_table();
+      std::shared_lock<std::shared_mutex> lock(table.mutex);
+
+      AssetId id;
+      if (const auto it = table.indices.find(name); it != table.indices.end())
+         id.index = it->second;
+      return id;
+   }
+
+   // Getter functions
+
+   const std::string& AssetId::get_name() const
+   {
+      static const std::string empty;
+
+      if (!is_valid())
+         return empty;
+
+      NameTable& table = get_table();
+      std::shared_lock<std::shared_mutex> lock(table.mutex);
+      return table.names[index];
+   }
+
+   size_t AssetId::get_count()
+   {
+      NameTable& table = get_table();
+      std::shared_lock<std::shared_mutex> lock(table.mutex);
+      return table.names.size();
+   }
+}
@@ -1,14 +1,36 @@
 #include "CX/AssetManager.hpp"
 
+#include <SFML/System/Clock.hpp>
 #include "CX/Errors.hpp"
+#include <algorithm>
 #include <format>
 #include <iostream>
-#include <thread>
+#include <optional>
 
 namespace cx
 {
    using Callback = std::function<void(bool)>;
 
+   namespace
+   {
+      /// @brief Get name of a path inside the root directory as stored in packs, without touching the file system.
+      /// @param root Root directory.
+      /// @param path Full path.
+      /// @return Name with forward slashes, empty for the root itself, nothing if the path is outside the root.
+      std::optional<std::string> get_pack_name(const fs::path& root, const fs::path& path)
+      {
+         const fs::path relative = path.lexically_normal().lexically_relative(root.lexically_normal());
+
+         if (relative.empty() || *relative.begin() == "..")
+            return std::nullopt;
+
+         std::string name = relative.generic_string();
+         if (name == ".")
+            name.clear();
+         return name;
+      }
+   }
+
    // Constructors
 
    AssetManager::AssetManager(const fs::path& root_directory)
@@ -21,6 +43,32 @@ namespace cx
          throw std::runtime_error(std::format(errors::asset::path_not_dir, root_directory.string()));
    }
 
+   AssetManager::~AssetManager()
+   {
+      stopping.store(true, std::memory_order_release);
+
+      {
+         std::lock_guard<std::mutex> lock(request_mutex);
+
+         for (auto& request : requests)
+            request.load->cancel();
+         requests.clear();
+      }
+
+      // Joins the loader threads while everything they use still exists
+      loader.reset();
+
+      std::lock_guard<std::mutex> lock(upload_mutex);
+
+      for (auto& pending : uploads)
+      {
+         if (pending.load)
+            std::const_pointer_cast<AssetLoad>(pending.load)->cancel();
+         else
+            pending.complete(nullptr);
+      }
+   }
+
    // File functions
 
    bool AssetManager::is_path_valid(const fs::path& path, bool relative_to_root) const
@@ -59,6 +107,44 @@ namespace cx
       return root;
    }
 
+   // Pack functions
+
+   void AssetManager::mount_pack(const fs::path& path, bool relative_to_root)
+   {
+      const fs::path full_path ((relative_to_root ? root / path : path));
+      auto pack = std::make_shared<const AssetPack>(full_path);
+
+      std::unique_lock<std::shared_mutex> lock(pack_mutex);
+      packs.push_back(std::move(pack));
+   }
+
+   void AssetManager::unmount_packs()
+   {
+      std::unique_lock<std::shared_mutex> lock(pack_mutex);
+      packs.clear();
+   }
+
+   AssetManager::PackedFile AssetManager::find_packed(const fs::path& path) const
+   {
+      std::shared_lock<std::shared_mutex> lock(pack_mutex);
+
+      if (packs.empty())
+         return {};
+
+      const std::optional<std::string> name = get_pack_name(root, path);
+
+      if (!name || name->empty())
+         return {};
+
+      for (auto it = packs.rbegin(); it != packs.rend(); ++it)
+      {
+         if (const AssetPack::Entry* entry = (*it)->find(*name))
+            return {*it, (*it)->get_data(*entry)};
+      }
+
+      return {};
+   }
+
    // Load functions
 
    const AssetManager::texture_t& AssetManager::load_texture(const std::string& identifier,
@@ -70,16 +156,10 @@ namespace cx
 
       const fs::path full_path ((relative_to_root ? root / path : path));
 
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
-
       sf::Texture texture;
+      open_asset(texture, full_path);
 
-      if (!texture.loadFromFile(full_path))
-         throw std::runtime_error(std::format(errors::asset::cannot_load_asset, full_path.string()));
-
-      textures.insert({identifier, std::make_shared<sf::Texture>(std::move(texture))});
-      return textures[identifier];
+      return textures.insert(AssetId(identifier), std::make_shared<sf::Texture>(std::move(texture)));
    }
 
    const AssetManager::sound_t& AssetManager::load_sound(const std::string& identifier,
@@ -91,16 +171,10 @@ namespace cx
 
       const fs::path full_path ((relative_to_root ? root / path : path));
 
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
-
       sf::SoundBuffer sound;
+      open_asset(sound, full_path);
 
-      if (!sound.loadFromFile(full_path))
-         throw std::runtime_error(std::format(errors::asset::cannot_load_asset, full_path.string()));
-
-      sounds.insert({identifier, std::make_shared<sf::SoundBuffer>(std::move(sound))});
-      return sounds[identifier];
+      return sounds.insert(AssetId(identifier), std::make_shared<sf::SoundBuffer>(std::move(sound)));
    }
 
    const AssetManager::music_t& AssetManager::load_song(const std::string& identifier,
@@ -111,18 +185,9 @@ namespace cx
          return music[identifier];
 
       const fs::path full_path ((relative_to_root ? root / path : path));
+      check_song(full_path);
 
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
-
-      if (!fs::is_regular_file(full_path))
-         throw std::runtime_error(std::format(errors::asset::cannot_load_asset, full_path.string()));
-
-      if (!music_extensions.contains(full_path.extension().string()))
-         throw std::runtime_error(std::format(errors::asset::invalid_extension, full_path.string(), full_path.extension().string()));
-
-      music.insert({identifier, std::make_shared<fs::path>(std::move(full_path))});
-      return music[identifier];
+      return music.insert(AssetId(identifier), std::make_shared<fs::path>(std::move(full_path)));
    }
 
    const AssetManager::font_t& AssetManager::load_font(const std::string& identifier,
@@ -133,17 +198,7 @@ namespace cx
          return fonts[identifier];
 
       const fs::path full_path ((relative_to_root ? root / path : path));
-
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
-
-      sf::Font font;
-
-      if (!font.loadFromFile(full_path))
-         throw std::runtime_error(std::format(errors::asset::cannot_load_asset, full_path.string()));
-
-      fonts.insert({identifier, std::make_shared<sf::Font>(std::move(font))});
-      return fonts[identifier];
+      return fonts.insert(AssetId(identifier), open_font(full_path));
    }
 
    const AssetManager::texture_t& AssetManager::load_texture(const fs::path& path, bool relative_to_root)
@@ -155,16 +210,10 @@ namespace cx
 
       const fs::path full_path ((relative_to_root ? root / path : path));
 
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
-
       sf::Texture texture;
+      open_asset(texture, full_path);
 
-      if (!texture.loadFromFile(full_path))
-         throw std::runtime_error(std::format(errors::asset::cannot_load_asset, full_path.string()));
-
-      textures.insert({identifier, std::make_shared<sf::Texture>(std::move(texture))});
-      return textures[identifier];
+      return textures.insert(AssetId(identifier), std::make_shared<sf::Texture>(std::move(texture)));
    }
 
    const AssetManager::sound_t& AssetManager::load_sound(const fs::path& path, bool relative_to_root)
@@ -176,17 +225,10 @@ namespace cx
 
       const fs::path full_path ((relative_to_root ? root / path : path));
 
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(
-            errors::asset::path_does_not_exist, full_path.string()));
-
       sf::SoundBuffer sound;
+      open_asset(sound, full_path);
 
-      if (!sound.loadFromFile(full_path))
-         throw std::runtime_error(std::format(errors::asset::cannot_load_asset, full_path.string()));
-
-      sounds.insert({identifier, std::make_shared<sf::SoundBuffer>(std::move(sound))});
-      return sounds[identifier];
+      return sounds.insert(AssetId(identifier), std::make_shared<sf::SoundBuffer>(std::move(sound)));
    }
 
    const AssetManager::music_t& AssetManager::load_song(const fs::path& path, bool relative_to_root)
@@ -197,18 +239,9 @@ namespace cx
          return music[identifier];
 
       const fs::path full_path ((relative_to_root ? root / path : path));
+      check_song(full_path);
 
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
-
-      if (!fs::is_regular_file(full_path))
-         throw std::runtime_error(std::format(errors::asset::cannot_load_asset, full_path.string()));
-
-      if (!music_extensions.contains(full_path.extension().string()))
-         throw std::runtime_error(std::format(errors::asset::invalid_extension, full_path.string(), full_path.extension().string()));
-
-      music.insert({identifier, std::make_shared<fs::path>(std::move(full_path))});
-      return music[identifier];
+      return music.insert(AssetId(identifier), std::make_shared<fs::path>(std::move(full_path)));
    }
 
    const AssetManager::font_t& AssetManager::load_font(const fs::path& path, bool relative_to_root)
@@ -219,17 +252,7 @@ namespace cx
          return fonts[identifier];
 
       const fs::path full_path ((relative_to_root ? root / path : path));
-
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
-
-      sf::Font font;
-
-      if (!font.loadFromFile(full_path))
-         throw std::runtime_error(std::format(errors::asset::cannot_load_asset, full_path.string()));
-
-      fonts.insert({identifier, std::make_shared<sf::Font>(std::move(font))});
-      return fonts[identifier];
+      return fonts.insert(AssetId(identifier), open_font(full_path));
    }
 
    void AssetManager::load_texture_dir(const fs::path& directory,
@@ -238,27 +261,17 @@ namespace cx
    {
       const fs::path full_path ((relative_to_root ? root / directory : directory));
 
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
-
-      if (!fs::is_directory(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_not_dir, full_path.string()));
-
-      for (const auto& file : fs::directory_iterator(full_path))
+      for (const auto& path : collect_files(full_path, AssetPack::texture, texture_extensions, recursive))
       {
-         if (file.is_directory() && recursive)
-            load_texture_dir(file.path(), false);
+         const std::string identifier (path.stem().string());
 
-         if (!file.is_regular_file() || !texture_extensions.contains(file.path().extension()))
+         if (textures.contains(identifier))
             continue;
 
          sf::Texture texture;
+         open_asset(texture, path);
 
-         if (!texture.loadFromFile(file.path()))
-            throw std::runtime_error(std::format(errors::asset::cannot_load_asset, file.path().string()));
-
-         if (!textures.contains(file.path().stem()))
-            textures.insert({file.path().stem(), std::make_shared<sf::Texture>(std::move(texture))});
+         textures.insert(AssetId(identifier), std::make_shared<sf::Texture>(std::move(texture)));
       }
    }
 
@@ -266,29 +279,19 @@ namespace cx
                                      bool relative_to_root,
                                      bool recursive)
    {
-      const fs::path full_path ((relative_to_root ? root / directory: directory));
-
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
-
-      if (!fs::is_directory(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_not_dir, full_path.string()));
+      const fs::path full_path ((relative_to_root ? root / directory : directory));
 
-      for (const auto& file : fs::directory_iterator(full_path))
+      for (const auto& path : collect_files(full_path, AssetPack::sound, sound_extensions, recursive))
       {
-         if (file.is_directory() && recursive)
-            load_sound_dir(file.path(), false);
+         const std::string identifier (path.stem().string());
 
-         if (!file.is_regular_file() || !sound_extensions.contains(file.path().extension()))
+         if (sounds.contains(identifier))
             continue;
 
          sf::SoundBuffer sound;
+         open_asset(sound, path);
 
-         if (!sound.loadFromFile(file.path()))
-            throw std::runtime_error(std::format(errors::asset::cannot_load_asset, file.path().string()));
-
-         if (!sounds.contains(file.path().stem()))
-            sounds.insert({file.path().stem(), std::make_shared<sf::SoundBuffer>(std::move(sound))});
+         sounds.insert(AssetId(identifier), std::make_shared<sf::SoundBuffer>(std::move(sound)));
       }
    }
 
@@ -298,22 +301,10 @@ namespace cx
    {
       const fs::path full_path ((relative_to_root ? root / directory : directory));
 
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
-
-      if (!fs::is_directory(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_not_dir, full_path.string()));
-
-      for (const auto& file : fs::directory_iterator(full_path))
+      for (const auto& path : collect_files(full_path, AssetPack::song, music_extensions, recursive))
       {
-         if (file.is_directory() && recursive)
-            load_song_dir(file.path(), false);
-
-         if (!file.is_regular_file() || !music_extensions.contains(file.path().extension()))
-            continue;
-
-         if (!music.contains(file.path().stem()))
-            music.insert({file.path().stem(), std::make_shared<fs::path>(file.path())});
+         if (!music.contains(path.stem().string()))
+            music.insert(AssetId(path.stem().string()), std::make_shared<fs::path>(path));
       }
    }
 
@@ -323,236 +314,353 @@ namespace cx
    {
       const fs::path full_path ((relative_to_root ? root / directory : directory));
 
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
+      for (const auto& path : collect_files(full_path, AssetPack::font, font_extensions, recursive))
+      {
+         if (!fonts.contains(path.stem().string()))
+            fonts.insert(AssetId(path.stem().string()), open_font(path));
+      }
+   }
+
+   // Load async functions
+
+   AssetHandle<sf::Texture> AssetManager::load_texture_async(const std::string& identifier,
+                                                             const fs::path& path,
+                                                             bool relative_to_root,
+                                                             int priority,
+                                                             const Callback& on_finished)
+   {
+      const fs::path full_path ((relative_to_root ? root / path : path));
 
-      if (!fs::is_directory(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_not_dir, full_path.string()));
+      auto state = std::make_shared<AssetHandle<sf::Texture>::State>();
+      state->set_priority(priority);
+      state->on_finished = on_finished;
 
-      for (const auto& file : fs::directory_iterator(full_path))
+      // Only decodes, the texture is created by update on the thread owning the window
+      submit_request(state, [this, state, identifier, full_path]()
       {
-         if (file.is_directory() && recursive)
-            load_font_dir(file.path(), false);
+         try
+         {
+            {
+               std::lock_guard<std::mutex> lock(texture_mutex);
 
-         if (!file.is_regular_file() || !font_extensions.contains(file.path().extension()))
-            continue;
+               if (const texture_t* texture = textures.find(identifier))
+               {
+                  state->asset = *texture;
+                  complete_load(*state, true);
+                  return;
+               }
+            }
 
-         sf::Font font;
+            sf::Image image;
+            open_asset(image, full_path);
 
-         if (!font.loadFromFile(file.path()))
-            throw std::runtime_error(std::format(errors::asset::cannot_load_asset, file.path().string()));
+            const auto complete = [this, state](const texture_t& texture)
+            {
+               state->asset = texture;
+               complete_load(*state, texture != nullptr);
+            };
 
-         if (!fonts.contains(file.path().stem()))
-            fonts.insert({file.path().stem(), std::make_shared<sf::Font>(std::move(font))});
-      }
+            std::lock_guard<std::mutex> lock(upload_mutex);
+            uploads.push_back({identifier, full_path, std::move(image), complete, state});
+         }
+         catch (const std::exception& e)
+         {
+            std::cerr << "Error in 'AssetManager::load_texture_async': " << e.what() << std::endl;
+            complete_load(*state, false);
+         }
+      });
+
+      return AssetHandle<sf::Texture>(std::move(state));
    }
 
-   void AssetManager::load_texture_dir_async(const Callback& on_finished,
-                                             const fs::path& directory,
-                                             bool relative_to_root,
-                                             bool recursive)
+   AssetHandle<sf::SoundBuffer> AssetManager::load_sound_async(const std::string& identifier,
+                                                               const fs::path& path,
+                                                               bool relative_to_root,
+                                                               int priority,
+                                                               const Callback& on_finished)
    {
-      const fs::path full_path ((relative_to_root ? root / directory : directory));
+      const fs::path full_path ((relative_to_root ? root / path : path));
 
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
+      return load_async<sf::SoundBuffer>(sounds, sound_mutex, identifier, full_path, priority, on_finished,
+                                         [this](const fs::path& file)
+      {
+         auto sound = std::make_shared<sf::SoundBuffer>();
+         open_asset(*sound, file);
+         return sound;
+      });
+   }
 
-      if (!fs::is_directory(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_not_dir, full_path.string()));
+   AssetHandle<fs::path> AssetManager::load_song_async(const std::string& identifier,
+                                                       const fs::path& path,
+                                                       bool relative_to_root,
+                                                       int priority,
+                                                       const Callback& on_finished)
+   {
+      const fs::path full_path ((relative_to_root ? root / path : path));
 
-      std::thread([=, this]()
+      return load_async<fs::path>(music, music_mutex, identifier, full_path, priority, on_finished,
+                                  [this](const fs::path& file)
       {
-         try
-         {
-            std::function<void(const fs::path&, bool)> load_files = [&](const fs::path& dir, bool rec)
-            {
-               for (const auto& file : fs::directory_iterator(dir))
-               {
-                  if (file.is_directory() && rec)
-                     load_files(file.path(), false);
-
-                  // Skip files with other extensions
-                  if (!file.is_regular_file() || !texture_extensions.contains(file.path().extension()))
-                     continue;
+         check_song(file);
+         return std::make_shared<fs::path>(file);
+      });
+   }
 
-                  sf::Texture texture;
+   AssetHandle<sf::Font> AssetManager::load_font_async(const std::string& identifier,
+                                                       const fs::path& path,
+                                                       bool relative_to_root,
+                                                       int priority,
+                                                       const Callback& on_finished)
+   {
+      const fs::path full_path ((relative_to_root ? root / path : path));
 
-                  if (!texture.loadFromFile(file.path()))
-                     throw std::runtime_error(std::format(errors::asset::cannot_load_asset, file.path().string()));
+      return load_async<sf::Font>(fonts, font_mutex, identifier, full_path, priority, on_finished,
+                                  [this](const fs::path& file) { return open_font(file); });
+   }
 
-                  std::lock_guard<std::mutex> lock(texture_mutex);
+   // Load directory async functions
 
-                  if (!textures.contains(file.path().stem()))
-                     textures.insert({file.path().stem(), std::make_shared<sf::Texture>(std::move(texture))});
-               }
-            };
+   AssetManager::progress_t AssetManager::load_texture_dir_async(const Callback& on_finished,
+                                                                 const fs::path& directory,
+                                                                 bool relative_to_root,
+                                                                 bool recursive)
+   {
+      const fs::path full_path ((relative_to_root ? root / directory : directory));
 
-            load_files(full_path, recursive);
+      // Only decodes, the texture is created by update on the thread owning the window
+      return load_dir_async(on_finished, full_path, recursive, AssetPack::texture, texture_extensions, [this](const fs::path& path, const job_t& job)
+      {
+         std::string identifier (path.stem().string());
 
-            if (on_finished)
-               on_finished(true);
-         }
-         catch (const std::exception& e)
          {
-            std::cerr << "Error in 'AssetManager::load_texture_dir_async': " << e.what() << std::endl;
-            if (on_finished)
-               on_finished(false);
+            std::lock_guard<std::mutex> lock(texture_mutex);
+            if (textures.contains(identifier))
+               return true;
          }
-      }).detach();
+
+         sf::Image image;
+         open_asset(image, path);
+
+         std::lock_guard<std::mutex> lock(upload_mutex);
+         uploads.push_back({std::move(identifier), path, std::move(image),
+                            [job](const texture_t& texture) { job->complete(texture != nullptr); }, nullptr});
+         return false;
+      });
    }
 
-   void AssetManager::load_sound_dir_async(const Callback& on_finished,
-                                           const fs::path& directory,
-                                           bool relative_to_root,
-                                           bool recursive)
+   AssetManager::progress_t AssetManager::load_sound_dir_async(const Callback& on_finished,
+                                                               const fs::path& directory,
+                                                               bool relative_to_root,
+                                                               bool recursive)
    {
       const fs::path full_path ((relative_to_root ? root / directory : directory));
 
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
+      return load_dir_async(on_finished, full_path, recursive, AssetPack::sound, sound_extensions, [this](const fs::path& path, const job_t&)
+      {
+         sf::SoundBuffer sound;
+         open_asset(sound, path);
+
+         std::lock_guard<std::mutex> lock(sound_mutex);
 
-      if (!fs::is_directory(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_not_dir, full_path.string()));
+         if (!sounds.contains(path.stem().string()))
+            sounds.insert(AssetId(path.stem().string()), std::make_shared<sf::SoundBuffer>(std::move(sound)));
 
-      std::thread([=, this]()
+         return true;
+      });
+   }
+
+   AssetManager::progress_t AssetManager::load_song_dir_async(const Callback& on_finished,
+                                                              const fs::path& directory,
+                                                              bool relative_to_root,
+                                                              bool recursive)
+   {
+      const fs::path full_path ((relative_to_root ? root / directory : directory));
+
+      return load_dir_async(on_finished, full_path, recursive, AssetPack::song, music_extensions, [this](const fs::path& path, const job_t&)
       {
-         try
-         {
-            std::function<void(const fs::path&, bool)> load_files = [&](const fs::path& dir, bool rec)
-            {
-               for (const auto& file : fs::directory_iterator(dir))
-               {
-                  if (file.is_directory() && rec)
-                     load_files(file.path(), false);
+         std::lock_guard<std::mutex> lock(music_mutex);
 
-                  if (!file.is_regular_file() || !sound_extensions.contains(file.path().extension()))
-                     continue;
+         if (!music.contains(path.stem().string()))
+            music.insert(AssetId(path.stem().string()), std::make_shared<fs::path>(path));
 
-                  sf::SoundBuffer sound;
+         return true;
+      });
+   }
 
-                  if (!sound.loadFromFile(file.path()))
-                     throw std::runtime_error(std::format(errors::asset::cannot_load_asset, file.path().string()));
+   AssetManager::progress_t AssetManager::load_font_dir_async(const Callback& on_finished,
+                                                              const fs::path& directory,
+                                                              bool relative_to_root,
+                                                              bool recursive)
+   {
+      const fs::path full_path ((relative_to_root ? root / directory : directory));
 
-                  std::lock_guard<std::mutex> lock(sound_mutex);
+      return load_dir_async(on_finished, full_path, recursive, AssetPack::font, font_extensions, [this](const fs::path& path, const job_t&)
+      {
+         font_t font = open_font(path);
 
-                  if (!sounds.contains(file.path().stem()))
-                     sounds.insert({file.path().stem(), std::make_shared<sf::SoundBuffer>(std::move(sound))});
-               }
-            };
+         std::lock_guard<std::mutex> lock(font_mutex);
 
-            load_files(full_path, recursive);
+         if (!fonts.contains(path.stem().string()))
+            fonts.insert(AssetId(path.stem().string()), std::move(font));
 
-            if (on_finished)
-               on_finished(true);
-         }
-         catch (const std::exception& e)
-         {
-            std::cerr << "Error in 'AssetManager::loadDirtAsync': " << e.what() << std::endl;
-            if (on_finished)
-               on_finished(false);
-         }
-      }).detach();
+         return true;
+      });
    }
 
-   void AssetManager::load_song_dir_async(const Callback& on_finished,
-                                          const fs::path& directory,
-                                          bool relative_to_root,
-                                          bool recursive)
+   // Loader functions
+
+   void AssetManager::set_loader_thread_count(size_t thread_count)
    {
-      const fs::path full_path ((relative_to_root ? root / directory : directory));
+      // Running loads finish on the old threads before the new ones take over
+      wait_for_loads();
+      loader.reset();
+      loader = std::make_unique<ThreadPool>(std::max<size_t>(thread_count, 1u));
+   }
 
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
+   size_t AssetManager::get_loader_thread_count() const
+   {
+      return loader ? loader->get_thread_count() : 0u;
+   }
+
+   void AssetManager::wait_for_loads()
+   {
+      if (loader)
+         loader->wait();
+   }
+
+   // Upload functions
+
+   size_t AssetManager::update()
+   {
+      const size_t count = upload_textures(true);
 
-      if (!fs::is_directory(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_not_dir, full_path.string()));
+      // Swapped out first, callbacks may start new loads
+      std::vector<std::function<void()>> ready;
 
-      std::thread([=, this]()
       {
-         try
-         {
-            std::function<void(const fs::path&, bool)> load_files = [&](const fs::path& dir, bool rec)
-            {
-               for (const auto& file : fs::directory_iterator(dir))
-               {
-                  if (file.is_directory() && rec)
-                     load_files(file.path(), false);
+         std::lock_guard<std::mutex> lock(callback_mutex);
+         ready.swap(callbacks);
+      }
 
-                  if (!file.is_regular_file() || !music_extensions.contains(file.path().extension()))
-                     continue;
+      for (const auto& callback : ready)
+         callback();
 
-                  std::lock_guard<std::mutex> lock(music_mutex);
+      return count;
+   }
 
-                  if (!music.contains(file.path().stem()))
-                     music.insert({file.path().stem(), std::make_shared<fs::path>(std::move(file.path()))});
-               }
-            };
+   size_t AssetManager::flush_uploads()
+   {
+      return upload_textures(false);
+   }
 
-            load_files(full_path, recursive);
+   void AssetManager::set_upload_budget(sf::Time time, size_t bytes)
+   {
+      upload_time_budget = time;
+      upload_byte_budget = bytes;
+   }
 
-            if (on_finished)
-               on_finished(true);
-         }
-         catch (const std::exception& e)
-         {
-            std::cerr << "Error in 'AssetManager::loadDirtAsync': " << e.what() << std::endl;
-            if (on_finished)
-               on_finished(false);
-         }
-      }).detach();
+   sf::Time AssetManager::get_upload_time_budget() const
+   {
+      return upload_time_budget;
+   }
+
+   size_t AssetManager::get_upload_byte_budget() const
+   {
+      return upload_byte_budget;
+   }
+
+   size_t AssetManager::get_pending_upload_count() const
+   {
+      std::lock_guard<std::mutex> lock(upload_mutex);
+      return uploads.size();
    }
 
-   void AssetManager::load_font_dir_async(const Callback& on_finished,
-                                          const fs::path& directory,
-                                          bool relative_to_root,
-                                          bool recursive)
+   // Atlas functions
+
+   const AssetManager::atlas_t& AssetManager::load_texture_atlas(const std::string& identifier,
+                                                                 const fs::path& directory,
+                                                                 const fs::path& layout_path,
+                                                                 bool relative_to_root,
+                                                                 bool recursive,
+                                                                 unsigned page_size,
+                                                                 unsigned padding)
    {
+      if (atlases.contains(identifier))
+         return atlases[identifier];
+
       const fs::path full_path ((relative_to_root ? root / directory : directory));
 
-      if (!fs::exists(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
+      // Sorted so the layout does not depend on directory order
+      std::vector<fs::path> paths = collect_files(full_path, AssetPack::texture, texture_extensions, recursive);
+      std::sort(paths.begin(), paths.end());
 
-      if (!fs::is_directory(full_path))
-         throw std::runtime_error(std::format(errors::asset::path_not_dir, full_path.string()));
+      return load_texture_atlas(identifier, paths, relative_to_root && !layout_path.empty() ? root / layout_path : layout_path,
+                                false, page_size, padding);
+   }
+
+   const AssetManager::atlas_t& AssetManager::load_texture_atlas(const std::string& identifier,
+                                                                 const std::vector<fs::path>& paths,
+                                                                 const fs::path& layout_path,
+                                                                 bool relative_to_root,
+                                                                 unsigned page_size,
+                                                                 unsigned padding)
+   {
+      if (atlases.contains(identifier))
+         return atlases[identifier];
 
-      std::thread([=, this]()
+      auto atlas = std::make_shared<TextureAtlas>(page_size, padding);
+
+      for (const auto& path : paths)
       {
-         try
-         {
-            std::function<void(const fs::path&, bool)> load_files = [&](const fs::path& dir, bool rec)
-            {
-               for (const auto& file : fs::directory_iterator(dir))
-               {
-                  if (file.is_directory() && rec)
-                     load_files(file.path(), false);
+         const fs::path full_path ((relative_to_root ? root / path : path));
 
-                  if (!file.is_regular_file() || !font_extensions.contains(file.path().extension()))
-                     continue;
+         if (!find_packed(full_path) && !fs::exists(full_path))
+            throw std::runtime_error(std::format(errors::asset::path_does_not_exist, full_path.string()));
 
-                  sf::Font font;
+         atlas->add(full_path.stem().string(), full_path);
+      }
 
-                  if (!font.loadFromFile(file.path()))
-                     throw std::runtime_error(std::format(errors::asset::cannot_load_asset, file.path().string()));
+      // Packed images are decoded straight from the mapped pack
+      atlas->build(relative_to_root && !layout_path.empty() ? root / layout_path : layout_path,
+                   [this](sf::Image& image, const fs::path& path) { open_asset(image, path); });
 
-                  std::lock_guard<std::mutex> lock(font_mutex);
+      atlas_order.push_back(atlas);
+      atlases.insert({identifier, std::move(atlas)});
+      return atlases[identifier];
+   }
 
-                  if (!fonts.contains(file.path().stem()))
-                     fonts.insert({file.path().stem(), std::make_shared<sf::Font>(std::move(font))});
-               }
-            };
+   const AssetManager::atlas_t& AssetManager::get_texture_atlas(std::string_view identifier) const
+   {
+      const auto it = atlases.find(identifier);
 
-            load_files(full_path, recursive);
+      if (it == atlases.end())
+         throw std::runtime_error(std::format(errors::asset::asset_does_not_exist, identifier));
+      return it->second;
+   }
 
-            if (on_finished)
-               on_finished(true);
-         }
-         catch (const std::exception& e)
-         {
-            std::cerr << "Error in 'AssetManager::loadDirtAsync': " << e.what() << std::endl;
-            if (on_finished)
-               on_finished(false);
-         }
-      }).detach();
+   TextureRegion AssetManager::get_texture_region(const std::string& identifier)
+   {
+      for (const auto& atlas : atlas_order)
+      {
+         if (atlas->contains(identifier))
+            return atlas->get_region(identifier);
+      }
+
+      return TextureRegion(get_texture(identifier).get());
+   }
+
+   bool AssetManager::find_texture_atlas(std::string_view identifier) const
+   {
+      return atlases.contains(identifier);
+   }
+
+   void AssetManager::unload_texture_atlas(std::string_view identifier)
+   {
+      if (const auto it = atlases.find(identifier); it != atlases.end())
+      {
+         std::erase(atlas_order, it->second);
+         atlases.erase(it);
+      }
    }
 
    // Insert functions
@@ -560,17 +668,17 @@ namespace cx
    const AssetManager::texture_t& AssetManager::insert_texture(const std::string& identifier,
                                                                const sf::Texture& texture)
    {
-      if (!textures.contains(identifier))
-         textures.insert({identifier, std::make_shared<sf::Texture>(std::move(texture))});
-      return textures[identifier];
+      if (const texture_t* existing = textures.find(identifier))
+         return *existing;
+      return textures.insert(AssetId(identifier), std::make_shared<sf::Texture>(std::move(texture)));
    }
 
    const AssetManager::sound_t& AssetManager::insert_sound(const std::string& identifier,
                                                            const sf::SoundBuffer& sound)
    {
-      if (!sounds.contains(identifier))
-         sounds.insert({identifier, std::make_shared<sf::SoundBuffer>(std::move(sound))});
-      return sounds[identifier];
+      if (const sound_t* existing = sounds.find(identifier))
+         return *existing;
+      return sounds.insert(AssetId(identifier), std::make_shared<sf::SoundBuffer>(std::move(sound)));
    }
 
    const AssetManager::music_t& AssetManager::insert_song(const std::string& identifier,
@@ -588,46 +696,89 @@ namespace cx
       if (!music_extensions.contains(song.extension()))
          throw std::runtime_error(std::format(errors::asset::invalid_extension, identifier, song.extension().string()));
 
-      music.insert({identifier, std::make_shared<fs::path>(std::move(song))});
-      return music[identifier];
+      return music.insert(AssetId(identifier), std::make_shared<fs::path>(std::move(song)));
    }
 
    const AssetManager::font_t& AssetManager::insert_font(const std::string& identifier,
                                                          const sf::Font& font)
    {
-      if (!fonts.contains(identifier))
-         fonts.insert({identifier, std::make_shared<sf::Font>(std::move(font))});
-      return fonts[identifier];
+      if (const font_t* existing = fonts.find(identifier))
+         return *existing;
+      return fonts.insert(AssetId(identifier), std::make_shared<sf::Font>(std::move(font)));
    }
 
    // Get functions
 
-   const AssetManager::texture_t& AssetManager::get_texture(const std::string& identifier)
+   const AssetManager::texture_t& AssetManager::get_texture(std::string_view identifier) const
    {
-      if (!textures.contains(identifier))
+      const texture_t* texture = textures.find(identifier);
+
+      if (!texture)
          throw std::runtime_error(std::format(errors::asset::asset_does_not_exist, identifier));
-      return textures[identifier];
+      return *texture;
    }
 
-   const AssetManager::sound_t& AssetManager::get_sound(const std::string& identifier)
+   const AssetManager::texture_t& AssetManager::get_texture(AssetId id) const
    {
-      if (!sounds.contains(identifier))
+      const texture_t* texture = textures.find(id);
+
+      if (!texture)
+         throw std::runtime_error(std::format(errors::asset::asset_does_not_exist, id.get_name()));
+      return *texture;
+   }
+
+   const AssetManager::sound_t& AssetManager::get_sound(std::string_view identifier) const
+   {
+      const sound_t* sound = sounds.find(identifier);
+
+      if (!sound)
          throw std::runtime_error(std::format(errors::asset::asset_does_not_exist, identifier));
-      return sounds[identifier];
+      return *sound;
    }
 
-   const AssetManager::music_t& AssetManager::get_song(const std::string& identifier)
+   const AssetManager::sound_t& AssetManager::get_sound(AssetId id) const
    {
-      if (!music.contains(identifier))
+      const sound_t* sound = sounds.find(id);
+
+      if (!sound)
+         throw std::runtime_error(std::format(errors::asset::asset_does_not_exist, id.get_name()));
+      return *sound;
+   }
+
+   const AssetManager::music_t& AssetManager::get_song(std::string_view identifier) const
+   {
+      const music_t* song = music.find(identifier);
+
+      if (!song)
          throw std::runtime_error(std::format(errors::asset::asset_does_not_exist, identifier));
-      return music[identifier];
+      return *song;
    }
 
-   const AssetManager::font_t& AssetManager::get_font(const std::string& identifier)
+   const AssetManager::music_t& AssetManager::get_song(AssetId id) const
    {
-      if (!fonts.contains(identifier))
+      const music_t* song = music.find(id);
+
+      if (!song)
+         throw std::runtime_error(std::format(errors::asset::asset_does_not_exist, id.get_name()));
+      return *song;
+   }
+
+   const AssetManager::font_t& AssetManager::get_font(std::string_view identifier) const
+   {
+      const font_t* font = fonts.find(identifier);
+
+      if (!font)
          throw std::runtime_error(std::format(errors::asset::asset_does_not_exist, identifier));
-      return fonts[identifier];
+      return *font;
+   }
+
+   const AssetManager::font_t& AssetManager::get_font(AssetId id) const
+   {
+      const font_t* font = fonts.find(id);
+
+      if (!font)
+         throw std::runtime_error(std::format(errors::asset::asset_does_not_exist, id.get_name()));
+      return *font;
    }
 
    // Update functions
@@ -693,7 +844,7 @@ namespace cx
          throw std::runtime_error(std::format(errors::asset::cannot_rename_asset, old_identifier, new_identifier));
 
       const auto& oldValue {textures[old_identifier]};
-      textures.insert({new_identifier, std::move(oldValue)});
+      textures.insert(AssetId(new_identifier), std::move(oldValue));
       textures.erase(old_identifier);
    }
 
@@ -707,7 +858,7 @@ namespace cx
          throw std::runtime_error(std::format(errors::asset::cannot_rename_asset, old_identifier, new_identifier));
 
       const auto& oldValue {sounds[old_identifier]};
-      sounds.insert({new_identifier, std::move(oldValue)});
+      sounds.insert(AssetId(new_identifier), std::move(oldValue));
       sounds.erase(old_identifier);
    }
 
@@ -721,7 +872,7 @@ namespace cx
          throw std::runtime_error(std::format(errors::asset::cannot_rename_asset, old_identifier, new_identifier));
 
       const auto& oldValue {music[old_identifier]};
-      music.insert({new_identifier, std::move(oldValue)});
+      music.insert(AssetId(new_identifier), std::move(oldValue));
       music.erase(old_identifier);
    }
 
@@ -735,50 +886,70 @@ namespace cx
          throw std::runtime_error(std::format(errors::asset::cannot_rename_asset, old_identifier, new_identifier));
 
       const auto& oldValue {fonts[old_identifier]};
-      fonts.insert({new_identifier, std::move(oldValue)});
+      fonts.insert(AssetId(new_identifier), std::move(oldValue));
       fonts.erase(old_identifier);
    }
 
    // Find functions
 
-   bool AssetManager::find_texture(const std::string& identifier) const
+   bool AssetManager::find_texture(std::string_view identifier) const
    {
       return textures.contains(identifier);
    }
 
-   bool AssetManager::find_sound(const std::string& identifier) const
+   bool AssetManager::find_texture(AssetId id) const
+   {
+      return textures.contains(id);
+   }
+
+   bool AssetManager::find_sound(std::string_view identifier) const
    {
       return sounds.contains(identifier);
    }
 
-   bool AssetManager::find_song(const std::string& identifier) const
+   bool AssetManager::find_sound(AssetId id) const
+   {
+      return sounds.contains(id);
+   }
+
+   bool AssetManager::find_song(std::string_view identifier) const
    {
       return music.contains(identifier);
    }
 
-   bool AssetManager::find_font(const std::string& identifier) const
+   bool AssetManager::find_song(AssetId id) const
+   {
+      return music.contains(id);
+   }
+
+   bool AssetManager::find_font(std::string_view identifier) const
    {
       return fonts.contains(identifier);
    }
 
+   bool AssetManager::find_font(AssetId id) const
+   {
+      return fonts.contains(id);
+   }
+
    // Unload functions
 
-   void AssetManager::unload_texture(const std::string& identifier)
+   void AssetManager::unload_texture(std::string_view identifier)
    {
       textures.erase(identifier);
    }
 
-   void AssetManager::unload_sound(const std::string& identifier)
+   void AssetManager::unload_sound(std::string_view identifier)
    {
       sounds.erase(identifier);
    }
 
-   void AssetManager::unload_song(const std::string& identifier)
+   void AssetManager::unload_song(std::string_view identifier)
    {
       music.erase(identifier);
    }
 
-   void AssetManager::unload_font(const std::string& identifier)
+   void AssetManager::unload_font(std::string_view identifier)
    {
       fonts.erase(identifier);
    }
@@ -809,5 +980,424 @@ namespace cx
       sounds.clear();
       music.clear();
       fonts.clear();
+      atlases.clear();
+      atlas_order.clear();
+   }
+
+   // Private functions
+
+   void AssetManager::LoadJob::complete(bool success) const
+   {
+      if (!progress->add_done(success))
+         return;
+
+      progress->finish();
+      if (on_finished)
+         on_finished(progress->get_failed() == 0u);
+   }
+
+   ThreadPool& AssetManager::get_loader()
+   {
+      if (!loader)
+         loader = std::make_unique<ThreadPool>();
+      return *loader;
+   }
+
+   void AssetManager::find_files(const fs::path& directory,
+                                 const std::unordered_set<std::string>& extensions,
+                                 bool recursive,
+                                 std::vector<fs::path>& paths)
+   {
+      for (const auto& file : fs::directory_iterator(directory))
+      {
+         if (file.is_directory() && recursive)
+            find_files(file.path(), extensions, recursive, paths);
+
+         if (file.is_regular_file() && extensions.contains(file.path().extension()))
+            paths.push_back(file.path());
+      }
+   }
+
+   bool AssetManager::find_packed_files(const fs::path& directory,
+                                        AssetPack::Kind kind,
+                                        bool recursive,
+                                        std::vector<fs::path>& paths) const
+   {
+      std::shared_lock<std::shared_mutex> lock(pack_mutex);
+
+      if (packs.empty())
+         return false;
+
+      const std::optional<std::string> name = get_pack_name(root, directory);
+
+      if (!name)
+         return false;
+
+      const size_t first = paths.size();
+      const size_t prefix_length = name->empty() ? 0u : name->size() + 1u;
+      bool found = false;
+
+      for (const auto& pack : packs)
+      {
+         const std::span<const AssetPack::Entry> entries = pack->find_directory(*name);
+         found = found || !entries.empty();
+
+         for (const auto& entry : entries)
+         {
+            const std::string_view file = pack->get_name(entry);
+
+            if (!(entry.kinds & kind) || (!recursive && file.find('/', prefix_length) != std::string_view::npos))
+               continue;
+
+            paths.push_back(root / file);
+         }
+      }
+
+      // Files in more than one pack are loaded once, from the pack mounted last
+      std::sort(paths.begin() + std::ptrdiff_t(first), paths.end());
+      paths.erase(std::unique(paths.begin() + std::ptrdiff_t(first), paths.end()), paths.end());
+
+      return found;
+   }
+
+   std::vector<fs::path> AssetManager::collect_files(const fs::path& directory,
+                                                     AssetPack::Kind kind,
+                                                     const std::unordered_set<std::string>& extensions,
+                                                     bool recursive) const
+   {
+      std::vector<fs::path> paths;
+
+      if (find_packed_files(directory, kind, recursive, paths))
+         return paths;
+
+      if (!fs::exists(directory))
+         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, directory.string()));
+
+      if (!fs::is_directory(directory))
+         throw std::runtime_error(std::format(errors::asset::path_not_dir, directory.string()));
+
+      find_files(directory, extensions, recursive, paths);
+      return paths;
+   }
+
+   template<typename T>
+   void AssetManager::open_asset(T& asset, const fs::path& path) const
+   {
+      // Decoded straight from the mapped pack, without opening the file
+      if (const PackedFile packed = find_packed(path))
+      {
+         if (!asset.loadFromMemory(packed.data.data(), packed.data.size()))
+            throw std::runtime_error(std::format(errors::asset::cannot_load_asset, path.string()));
+         return;
+      }
+
+      if (!fs::exists(path))
+         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, path.string()));
+
+      if (!asset.loadFromFile(path))
+         throw std::runtime_error(std::format(errors::asset::cannot_load_asset, path.string()));
+   }
+
+   AssetManager::font_t AssetManager::open_font(const fs::path& path) const
+   {
+      if (const PackedFile packed = find_packed(path))
+      {
+         // The font reads glyphs from the pack as they are needed, so the pack stays mapped while it lives
+         font_t font (new sf::Font(), [pack = packed.pack](sf::Font* font) { delete font; });
+
+         if (!font->loadFromMemory(packed.data.data(), packed.data.size()))
+            throw std::runtime_error(std::format(errors::asset::cannot_load_asset, path.string()));
+         return font;
+      }
+
+      if (!fs::exists(path))
+         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, path.string()));
+
+      auto font = std::make_shared<sf::Font>();
+
+      if (!font->loadFromFile(path))
+         throw std::runtime_error(std::format(errors::asset::cannot_load_asset, path.string()));
+      return font;
+   }
+
+   void AssetManager::check_song(const fs::path& path) const
+   {
+      // Songs are streamed when played, a packed one only needs the right extension
+      if (!find_packed(path))
+      {
+         if (!fs::exists(path))
+            throw std::runtime_error(std::format(errors::asset::path_does_not_exist, path.string()));
+
+         if (!fs::is_regular_file(path))
+            throw std::runtime_error(std::format(errors::asset::cannot_load_asset, path.string()));
+      }
+
+      if (!music_extensions.contains(path.extension().string()))
+         throw std::runtime_error(std::format(errors::asset::invalid_extension, path.string(), path.extension().string()));
+   }
+
+   AssetManager::progress_t AssetManager::load_dir_async(const Callback& on_finished,
+                                                         const fs::path& directory,
+                                                         bool recursive,
+                                                         AssetPack::Kind kind,
+                                                         const std::unordered_set<std::string>& extensions,
+                                                         std::function<bool(const fs::path&, const job_t&)> load)
+   {
+      // A packed directory is listed from the index, so there is nothing to walk
+      std::vector<fs::path> packed_paths;
+      const bool packed = find_packed_files(directory, kind, recursive, packed_paths);
+
+      if (!packed && !fs::exists(directory))
+         throw std::runtime_error(std::format(errors::asset::path_does_not_exist, directory.string()));
+
+      if (!packed && !fs::is_directory(directory))
+         throw std::runtime_error(std::format(errors::asset::path_not_dir, directory.string()));
+
+      // Completion is reported by update, on the thread owning the window
+      Callback deliver;
+      if (on_finished)
+         deliver = [this, on_finished](bool success) { post([on_finished, success] { on_finished(success); }); };
+
+      auto progress = std::make_shared<LoadProgress>();
+      const job_t job = std::make_shared<const LoadJob>(LoadJob {progress, deliver});
+      ThreadPool& pool = get_loader();
+
+      // Walking is one task, so a deep tree does not hold up files already found elsewhere
+      pool.submit([=, this, &pool, &extensions, paths = std::move(packed_paths), load = std::move(load)]() mutable
+      {
+         const auto fail_walk = [&progress, &deliver]()
+         {
+            progress->walk_failed.store(true, std::memory_order_release);
+            progress->set_total(0u);
+            progress->finish();
+            if (deliver)
+               deliver(false);
+         };
+
+         // Skipped when shutting down, a deep tree would only be walked to cancel every file
+         if (stopping.load(std::memory_order_acquire))
+         {
+            fail_walk();
+            return;
+         }
+
+         try
+         {
+            if (!packed)
+               find_files(directory, extensions, recursive, paths);
+         }
+         catch (const std::exception& e)
+         {
+            std::cerr << "Error in 'AssetManager::load_dir_async': " << e.what() << std::endl;
+            fail_walk();
+            return;
+         }
+
+         progress->set_total(paths.size());
+
+         if (paths.empty())
+         {
+            progress->finish();
+            if (deliver)
+               deliver(true);
+            return;
+         }
+
+         // Shared by the file tasks, the last file done reports completion
+         const auto shared_load = std::make_shared<const std::function<bool(const fs::path&, const job_t&)>>(std::move(load));
+
+         for (auto& path : paths)
+         {
+            pool.submit([=, this, path = std::move(path)]()
+            {
+               // Skipped when shutting down, so only loads already running hold it up
+               if (stopping.load(std::memory_order_acquire))
+               {
+                  job->complete(false);
+                  return;
+               }
+
+               try
+               {
+                  if ((*shared_load)(path, job))
+                     job->complete(true);
+               }
+               catch (const std::exception& e)
+               {
+                  std::cerr << "Error in 'AssetManager::load_dir_async': " << e.what() << std::endl;
+                  job->complete(false);
+               }
+            });
+         }
+      });
+
+      return progress;
+   }
+
+   size_t AssetManager::upload_textures(bool budgeted)
+   {
+      sf::Clock clock;
+      size_t count = 0u;
+      size_t bytes = 0u;
+
+      while (true)
+      {
+         PendingUpload pending;
+
+         {
+            std::lock_guard<std::mutex> lock(upload_mutex);
+
+            if (uploads.empty())
+               break;
+
+            // The first image always goes, so a single large one cannot stall the queue
+            if (budgeted && count != 0u)
+            {
+               const sf::Vector2u size = uploads.front().image.getSize();
+               const size_t next = size_t(size.x) * size_t(size.y) * 4u;
+
+               if (upload_byte_budget != 0u && bytes + next > upload_byte_budget)
+                  break;
+
+               if (upload_time_budget != sf::Time::Zero && clock.getElapsedTime() >= upload_time_budget)
+                  break;
+            }
+
+            pending = std::move(uploads.front());
+            uploads.pop_front();
+         }
+
+         // Cancelled while waiting
+         if (pending.load && pending.load->is_finished())
+            continue;
+
+         const sf::Vector2u size = pending.image.getSize();
+         bytes += size_t(size.x) * size_t(size.y) * 4u;
+         ++count;
+
+         sf::Texture texture;
+         texture_t created;
+
+         if (texture.loadFromImage(pending.image))
+         {
+            std::lock_guard<std::mutex> lock(texture_mutex);
+
+            // Keeps a texture loaded with the same identifier in the meantime
+            created = textures.insert(AssetId(pending.identifier), std::make_shared<sf::Texture>(std::move(texture)));
+         }
+         else
+         {
+            std::cerr << "Error in 'AssetManager::update': "
+                      << std::format(errors::asset::cannot_load_asset, pending.path.string()) << std::endl;
+         }
+
+         pending.complete(created);
+      }
+
+      return count;
+   }
+
+   void AssetManager::submit_request(std::shared_ptr<AssetLoad> load, std::function<void()> run)
+   {
+      {
+         std::lock_guard<std::mutex> lock(request_mutex);
+         requests.push_back({std::move(load), std::move(run), request_count++});
+      }
+
+      // Each task runs whichever request is best once a thread is free, not the one submitted with it
+      get_loader().submit([this] { run_next_request(); });
+   }
+
+   void AssetManager::run_next_request()
+   {
+      std::function<void()> run;
+
+      {
+         std::lock_guard<std::mutex> lock(request_mutex);
+
+         // Cancelled requests are dropped here instead of searched for on cancel
+         std::erase_if(requests, [](const LoadRequest& request) { return request.load->is_finished(); });
+
+         if (requests.empty())
+            return;
+
+         // Scanned on every run so priorities changed after submitting count, ties go first come first served
+         const auto best = std::max_element(requests.begin(), requests.end(),
+            [](const LoadRequest& a, const LoadRequest& b)
+            {
+               const int a_priority = a.load->get_priority();
+               const int b_priority = b.load->get_priority();
+               return a_priority < b_priority || (a_priority == b_priority && a.order > b.order);
+            });
+
+         run = std::move(best->run);
+         requests.erase(best);
+      }
+
+      run();
+   }
+
+   template<typename T>
+   AssetHandle<T> AssetManager::load_async(AssetTable<T>& assets,
+                                           std::mutex& mutex,
+                                           const std::string& identifier,
+                                           const fs::path& path,
+                                           int priority,
+                                           const Callback& on_finished,
+                                           std::function<std::shared_ptr<T>(const fs::path&)> open)
+   {
+      auto state = std::make_shared<typename AssetHandle<T>::State>();
+      state->set_priority(priority);
+      state->on_finished = on_finished;
+
+      submit_request(state, [this, state, &assets, &mutex, identifier, path, open = std::move(open)]()
+      {
+         try
+         {
+            std::shared_ptr<T> asset;
+
+            {
+               std::lock_guard<std::mutex> lock(mutex);
+
+               if (const auto* found = assets.find(identifier))
+                  asset = *found;
+            }
+
+            if (!asset)
+            {
+               // Opened outside the lock, so loads of one type run in parallel
+               auto opened = open(path);
+
+               std::lock_guard<std::mutex> lock(mutex);
+               asset = assets.insert(AssetId(identifier), std::move(opened));
+            }
+
+            state->asset = std::move(asset);
+         }
+         catch (const std::exception& e)
+         {
+            std::cerr << "Error in 'AssetManager::load_async': " << e.what() << std::endl;
+            complete_load(*state, false);
+            return;
+         }
+
+         complete_load(*state, true);
+      });
+
+      return AssetHandle<T>(std::move(state));
+   }
+
+   void AssetManager::complete_load(AssetLoad& load, bool success)
+   {
+      if (!load.finish(success ? AssetStatus::ready : AssetStatus::failed) || !load.on_finished)
+         return;
+
+      post([callback = load.on_finished, success] { callback(success); });
+   }
+
+   void AssetManager::post(std::function<void()> callback)
+   {
+      std::lock_guard<std::mutex> lock(callback_mutex);
+      callbacks.push_back(std::move(callback));
    }
 }
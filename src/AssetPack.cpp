@@ -0,0 +1,351 @@
+#include "CX/Asset/AssetPack.hpp"
+
+#include "CX/Asset/AssetExtensions.hpp"
+#include "CX/Config.hpp"
+#include "CX/Errors.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef CX_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace cx
+{
+   static_assert(std::endian::native == std::endian::little, "Packs are read in place, which needs a little endian platform");
+
+   namespace
+   {
+      /// @brief Get kinds of asset a file can be loaded as.
+      /// @param path Path.
+      /// @return Kind flags, 0 if it is no asset.
+      uint8_t get_kinds(const fs::path& path)
+      {
+         const std::string extension = path.extension().string();
+         uint8_t kinds = 0u;
+
+         if (extensions::texture.contains(extension)) kinds |= AssetPack::texture;
+         if (extensions::sound.contains(extension))   kinds |= AssetPack::sound;
+         if (extensions::music.contains(extension))   kinds |= AssetPack::song;
+         if (extensions::font.contains(extension))    kinds |= AssetPack::font;
+
+         return kinds;
+      }
+
+      /// @brief Round an offset up to the data alignment.
+      /// @param offset Offset.
+      /// @return Aligned offset.
+      uint64_t align(uint64_t offset)
+      {
+         return (offset + AssetPack::data_alignment - 1u) / AssetPack::data_alignment * AssetPack::data_alignment;
+      }
+   }
+
+   // Constructors
+
+   AssetPack::AssetPack(const fs::path& path)
+   {
+      open(path);
+   }
+
+   AssetPack::AssetPack(AssetPack&& other) noexcept
+      : path(std::move(other.path)),
+        data(std::exchange(other.data, nullptr)),
+        data_size(std::exchange(other.data_size, 0u)),
+        entries(std::exchange(other.entries, {})),
+        names(std::exchange(other.names, {})) {}
+
+   AssetPack& AssetPack::operator=(AssetPack&& other) noexcept
+   {
+      if (this != &other)
+      {
+         close();
+         path = std::move(other.path);
+         data = std::exchange(other.data, nullptr);
+         data_size = std::exchange(other.data_size, 0u);
+         entries = std::exchange(other.entries, {});
+         names = std::exchange(other.names, {});
+      }
+
+      return *this;
+   }
+
+   AssetPack::~AssetPack()
+   {
+      close();
+   }
+
+   // File functions
+
+   void AssetPack::open(const fs::path& path)
+   {
+      close();
+
+      std::error_code error;
+      const uintmax_t size = fs::file_size(path, error);
+
+      if (error || size < sizeof(Header))
+         throw std::runtime_error(std::format(errors::pack::invalid_pack, path.string()));
+
+#ifdef CX_WINDOWS
+      const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (file == INVALID_HANDLE_VALUE)
+         throw std::runtime_error(std::format(errors::pack::cannot_open_pack, path.string()));
+
+      const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+      // The view keeps the file mapped on its own
+      if (mapping)
+         CloseHandle(mapping);
+      CloseHandle(file);
+
+      if (!view)
+         throw std::runtime_error(std::format(errors::pack::cannot_open_pack, path.string()));
+#else
+      const int file = ::open(path.c_str(), O_RDONLY);
+      if (file < 0)
+         throw std::runtime_error(std::format(errors::pack::cannot_open_pack, path.string()));
+
+      void* view = mmap(nullptr, size_t(size), PROT_READ, MAP_PRIVATE, file, 0);
+
+      // The mapping keeps the file open on its own
+      ::close(file);
+
+      if (view == MAP_FAILED)
+         throw std::runtime_error(std::format(errors::pack::cannot_open_pack, path.string()));
+#endif
+
+      this->path = path;
+      data = static_cast<const std::byte*>(view);
+      data_size = size_t(size);
+
+      try
+      {
+         parse();
+      }
+      catch (...)
+      {
+         close();
+         throw;
+      }
+   }
+
+   void AssetPack::close()
+   {
+      if (!data)
+         return;
+
+#ifdef CX_WINDOWS
+      UnmapViewOfFile(data);
+#else
+      munmap(const_cast<std::byte*>(data), data_size);
+#endif
+
+      data = nullptr;
+      data_size = 0u;
+      entries = {};
+      names = {};
+   }
+
+   size_t AssetPack::write(const fs::path& directory, const fs::path& path)
+   {
+      struct File
+      {
+         std::string name;
+         fs::path path;
+         uint64_t size;
+         uint8_t kinds;
+      };
+
+      std::vector<File> files;
+
+      for (const auto& file : fs::recursive_directory_iterator(directory))
+      {
+         if (!file.is_regular_file())
+            continue;
+
+         const uint8_t kinds = get_kinds(file.path());
+         if (kinds != 0u)
+            files.push_back({fs::relative(file.path(), directory).generic_string(), file.path(), file.file_size(), kinds});
+      }
+
+      // Sorted so names can be found by binary search
+      std::sort(files.begin(), files.end(), [](const File& a, const File& b) { return a.name < b.name; });
+
+      std::string names;
+      std::vector<Entry> index (files.size());
+
+      for (size_t i = 0; i < files.size(); ++i)
+      {
+         index[i].name_offset = uint32_t(names.size());
+         index[i].name_length = uint32_t(files[i].name.size());
+         index[i].kinds = files[i].kinds;
+         names += files[i].name;
+      }
+
+      Header header {};
+      header.magic = magic;
+      header.version = version;
+      header.entry_count = uint32_t(files.size());
+      header.names_offset = sizeof(Header) + sizeof(Entry) * files.size();
+      header.names_size = names.size();
+
+      uint64_t offset = align(header.names_offset + header.names_size);
+
+      for (size_t i = 0; i < files.size(); ++i)
+      {
+         index[i].offset = offset;
+         index[i].size = files[i].size;
+         offset = align(offset + files[i].size);
+      }
+
+      std::ofstream out (path, std::ios::binary | std::ios::trunc);
+      if (!out)
+         throw std::runtime_error(std::format(errors::pack::cannot_write_pack, path.string()));
+
+      out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+      out.write(reinterpret_cast<const char*>(index.data()), std::streamsize(sizeof(Entry) * index.size()));
+      out.write(names.data(), std::streamsize(names.size()));
+
+      const char padding[data_alignment] {};
+      uint64_t written = header.names_offset + header.names_size;
+
+      for (size_t i = 0; i < files.size(); ++i)
+      {
+         out.write(padding, std::streamsize(index[i].offset - written));
+
+         std::ifstream in (files[i].path, std::ios::binary);
+         if (!in)
+            throw std::runtime_error(std::format(errors::pack::cannot_write_pack, path.string()));
+
+         // Inserting an empty stream buffer sets failbit, so empty files are not copied at all
+         if (files[i].size != 0u && !(out << in.rdbuf()))
+            throw std::runtime_error(std::format(errors::pack::cannot_write_pack, path.string()));
+
+         written = index[i].offset + index[i].size;
+      }
+
+      if (!out.flush())
+         throw std::runtime_error(std::format(errors::pack::cannot_write_pack, path.string()));
+
+      return files.size();
+   }
+
+   // Getter functions
+
+   bool AssetPack::is_open() const
+   {
+      return data != nullptr;
+   }
+
+   const fs::path& AssetPack::get_path() const
+   {
+      return path;
+   }
+
+   size_t AssetPack::size() const
+   {
+      return entries.size();
+   }
+
+   std::span<const AssetPack::Entry> AssetPack::get_entries() const
+   {
+      return entries;
+   }
+
+   const AssetPack::Entry* AssetPack::find(std::string_view name) const
+   {
+      const auto it = std::lower_bound(entries.begin(), entries.end(), name, [this](const Entry& entry, std::string_view value)
+      {
+         return get_name(entry) < value;
+      });
+
+      return it != entries.end() && get_name(*it) == name ? &*it : nullptr;
+   }
+
+   std::span<const AssetPack::Entry> AssetPack::find_directory(std::string_view directory) const
+   {
+      if (directory.empty())
+         return entries;
+
+      std::string prefix (directory);
+      if (prefix.back() != '/')
+         prefix += '/';
+
+      const auto by_name = [this](const Entry& entry, std::string_view value) { return get_name(entry) < value; };
+      const auto first = std::lower_bound(entries.begin(), entries.end(), prefix, by_name);
+      auto last = first;
+
+      while (last != entries.end() && get_name(*last).starts_with(prefix))
+         ++last;
+
+      return entries.subspan(size_t(first - entries.begin()), size_t(last - first));
+   }
+
+   std::string_view AssetPack::get_name(const Entry& entry) const
+   {
+      return names.substr(entry.name_offset, entry.name_length);
+   }
+
+   std::span<const std::byte> AssetPack::get_data(const Entry& entry) const
+   {
+      return std::span<const std::byte>(data + entry.offset, size_t(entry.size));
+   }
+
+   // Private functions
+
+   void AssetPack::parse()
+   {
+      Header header;
+      std::memcpy(&header, data, sizeof(Header));
+
+      const auto invalid = [this]()
+      {
+         return std::runtime_error(std::format(errors::pack::invalid_pack, path.string()));
+      };
+
+      if (header.magic != magic || header.version != version)
+         throw invalid();
+
+      // Checked once here, so every later access can trust the index
+      if (header.entry_count > (data_size - sizeof(Header)) / sizeof(Entry))
+         throw invalid();
+
+      const uint64_t index_end = sizeof(Header) + uint64_t(header.entry_count) * sizeof(Entry);
+
+      if (header.names_offset < index_end || header.names_offset > data_size ||
+          header.names_size > data_size - header.names_offset)
+         throw invalid();
+
+      entries = std::span<const Entry>(reinterpret_cast<const Entry*>(data + sizeof(Header)), header.entry_count);
+      names = std::string_view(reinterpret_cast<const char*>(data + header.names_offset), size_t(header.names_size));
+
+      for (size_t i = 0; i < entries.size(); ++i)
+      {
+         const Entry& entry = entries[i];
+
+         if (entry.offset > data_size || entry.size > data_size - entry.offset ||
+             entry.name_offset > names.size() || entry.name_length > names.size() - entry.name_offset)
+            throw invalid();
+
+         if (i != 0u && !(get_name(entries[i - 1u]) < get_name(entry)))
+            throw invalid();
+      }
+   }
+}
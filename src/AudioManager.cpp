@@ -40,9 +40,7 @@ namespace cx
       const std::string& identifier {song_pool.at(music_index)};
       ++music_index;
 
-      if (!current_song.openFromFile(*asset.get_song(identifier)))
-         throw std::runtime_error(
-            std::format(errors::audio::song_cannot_be_played, identifier));
+      open_song(identifier);
 
       current_song.setVolume(music_volume);
       current_song.play();
@@ -56,8 +54,8 @@ namespace cx
                                  float min_pitch,
                                  float max_pitch)
    {
-      saved_sounds[std::move(identifier)] = AudioManagerSound{
-         {std::move(song_identifier)},
+      saved_sounds[identifier] = AudioManagerSound{
+         {AssetId(song_identifier)},
          max_duplicates,
          min_pitch,
          max_pitch
@@ -70,60 +68,40 @@ namespace cx
                                  float min_pitch,
                                  float max_pitch)
    {
-      saved_sounds[std::move(identifier)] = AudioManagerSound{
-         std::move(song_identifiers),
+      // Interned once here, so playing does not hash the names again
+      std::vector<AssetId> ids;
+      ids.reserve(song_identifiers.size());
+
+      for (const auto& song_identifier : song_identifiers)
+         ids.emplace_back(song_identifier);
+
+      saved_sounds[identifier] = AudioManagerSound{
+         std::move(ids),
          max_duplicates,
          min_pitch,
          max_pitch
       };
    }
 
-   void AudioManager::play_saved_sound(const std::string& identifier)
+   void AudioManager::play_saved_sound(std::string_view identifier)
    {
-      if (!saved_sounds.contains(identifier))
+      const auto it = saved_sounds.find(identifier);
+
+      if (it == saved_sounds.end())
          throw std::runtime_error(
             std::format(errors::audio::sound_is_not_saved, identifier));
 
-      const AudioManagerSound& sound {saved_sounds.at(identifier)};
+      const AudioManagerSound& sound {it->second};
 
       if (sound.identifiers.empty())
          return;
 
-      const std::string& soundIdentifier {
-         (sound.identifiers.size() == 1 ? sound.identifiers.at(0) : 
+      const AssetId sound_id {
+         (sound.identifiers.size() == 1 ? sound.identifiers.front() :
          sound.identifiers.at(randiu(size_t(0), sound.identifiers.size() - 1)))
       };
 
-      if (!asset.find_sound(soundIdentifier))
-         throw std::runtime_error(std::format(
-            errors::audio::sound_doesnot_exist, soundIdentifier));
-      
-      std::lock_guard<std::mutex> lock(soundMutex);
-
-      // Check for duplicates
-      unsigned char total {};
-
-      for (const auto& sound : active_sounds)
-         if (sound->getBuffer() == asset.get_sound(soundIdentifier).get())
-            ++total;
-      
-      if (sound.duplicate_count <= total)
-         return;
-      
-      // Create a new sound
-      auto newSound {std::make_shared<sf::Sound>()};
-      newSound->setBuffer(*asset.get_sound(soundIdentifier));
-      newSound->setVolume(sound_volume);
-
-      if (sound.min_pitch == sound.max_pitch)
-         newSound->setPitch(sound.min_pitch);
-      else
-         newSound->setPitch(randfu(min(sound.min_pitch, sound.max_pitch),
-            max(sound.min_pitch, sound.max_pitch)));
-
-      newSound->play();
-
-      active_sounds.push_back(newSound);
+      play_sound(sound_id, sound.duplicate_count, sound.min_pitch, sound.max_pitch);
    }
 
    void AudioManager::play_sound(const std::string& identifier,
@@ -131,36 +109,25 @@ namespace cx
                                  float min_pitch,
                                  float max_pitch)
    {
-      if (!asset.find_sound(identifier))
+      const AssetId id {AssetId::find(identifier)};
+
+      if (!asset.find_sound(id))
          throw std::runtime_error(std::format(
             errors::audio::sound_doesnot_exist, identifier));
-      
-      std::lock_guard<std::mutex> lock(soundMutex);
 
-      // Check for duplicates
-      unsigned char total {};
-
-      for (const auto& sound : active_sounds)
-         if (sound->getBuffer() == asset.get_sound(identifier).get())
-            ++total;
-      
-      if (max_duplicates <= total)
-         return;
-      
-      // Create a new sound
-      auto sound {std::make_shared<sf::Sound>()};
-      sound->setBuffer(*asset.get_sound(identifier));
-      sound->setVolume(sound_volume);
-
-      if (min_pitch == max_pitch)
-         sound->setPitch(min_pitch);
-      else
-         sound->setPitch(randfu(min(min_pitch, max_pitch),
-            max(min_pitch, max_pitch)));
+      play_buffer(*asset.get_sound(id), max_duplicates, min_pitch, max_pitch);
+   }
 
-      sound->play();
+   void AudioManager::play_sound(AssetId id,
+                                 unsigned char max_duplicates,
+                                 float min_pitch,
+                                 float max_pitch)
+   {
+      if (!asset.find_sound(id))
+         throw std::runtime_error(std::format(
+            errors::audio::sound_doesnot_exist, id.get_name()));
 
-      active_sounds.push_back(sound);
+      play_buffer(*asset.get_sound(id), max_duplicates, min_pitch, max_pitch);
    }
 
    void
@@ -175,36 +142,7 @@ namespace cx
       const std::string& identifier {identifiers.at(randiu(size_t(0),
          identifiers.size() - 1))};
 
-      if (!asset.find_sound(identifier))
-         throw std::runtime_error(std::format(
-            errors::audio::sound_doesnot_exist, identifier));
-      
-      std::lock_guard<std::mutex> lock(soundMutex);
-
-      // Check for duplicates
-      unsigned char total {};
-
-      for (const auto& sound : active_sounds)
-         if (sound->getBuffer() == asset.get_sound(identifier).get())
-            ++total;
-      
-      if (max_duplicates <= total)
-         return;
-      
-      // Create a new sound
-      auto sound {std::make_shared<sf::Sound>()};
-      sound->setBuffer(*asset.get_sound(identifier));
-      sound->setVolume(sound_volume);
-
-      if (min_pitch == max_pitch)
-         sound->setPitch(min_pitch);
-      else
-         sound->setPitch(randfu(min(min_pitch, max_pitch),
-            max(min_pitch, max_pitch)));
-
-      sound->play();
-
-      active_sounds.push_back(sound);
+      play_sound(identifier, max_duplicates, min_pitch, max_pitch);
    }
 
    void AudioManager::toggle_paused_sounds()
@@ -275,9 +213,7 @@ namespace cx
       if (current_song.getStatus() == sf::Music::Playing)
          current_song.stop();
 
-      if (!current_song.openFromFile(*asset.get_song(identifier)))
-         throw std::runtime_error(std::format(
-            errors::audio::song_cannot_be_played, identifier));
+      open_song(identifier);
 
       current_song.setVolume(music_volume);
       current_song.setLoop(looping);
@@ -359,7 +295,7 @@ namespace cx
 
    // Contains functions
 
-   bool AudioManager::contains_saved_sound(const std::string& name) const
+   bool AudioManager::contains_saved_sound(std::string_view name) const
    {
       return saved_sounds.contains(name);
    }
@@ -371,4 +307,55 @@ namespace cx
             return true;
       return false;
    }
+
+   // Private functions
+
+   void AudioManager::play_buffer(const sf::SoundBuffer& buffer,
+                                  unsigned char max_duplicates,
+                                  float min_pitch,
+                                  float max_pitch)
+   {
+      std::lock_guard<std::mutex> lock(soundMutex);
+
+      // Check for duplicates
+      unsigned char total {};
+
+      for (const auto& sound : active_sounds)
+         if (sound->getBuffer() == &buffer)
+            ++total;
+
+      if (max_duplicates <= total)
+         return;
+
+      // Create a new sound
+      auto sound {std::make_shared<sf::Sound>()};
+      sound->setBuffer(buffer);
+      sound->setVolume(sound_volume);
+
+      if (min_pitch == max_pitch)
+         sound->setPitch(min_pitch);
+      else
+         sound->setPitch(randfu(min(min_pitch, max_pitch),
+            max(min_pitch, max_pitch)));
+
+      sound->play();
+
+      active_sounds.push_back(sound);
+   }
+
+   void AudioManager::open_song(const std::string& identifier)
+   {
+      const fs::path& path = *asset.get_song(identifier);
+
+      // Stopped first, the old song may still stream from the data about to be released
+      current_song.stop();
+      song_data = asset.find_packed(path);
+
+      const bool opened = song_data
+         ? current_song.openFromMemory(song_data.data.data(), song_data.data.size())
+         : current_song.openFromFile(path);
+
+      if (!opened)
+         throw std::runtime_error(std::format(errors::audio::song_cannot_be_played, identifier));
+   }
 }
@@ -1,6 +1,8 @@
 #include "CX/Bar/Bar.hpp"
 
-#include "CX/Config.hpp" // IWYU pragma: export
+#include "CX/Render/ProgressFill.hpp"
+#include "CX/Render/RenderBatch.hpp"
+#include "CX/Render/Shaders.hpp"
 
 namespace cx
 {
@@ -12,21 +14,11 @@ namespace cx
 
    // Constructors
 
-   Bar::Bar()
-   {
-      if (!clip_shader.loadFromFile(CX_SHADER_PATH "clipping_shader.frag", sf::Shader::Fragment))
-         throw std::runtime_error("Could not load clipping_shader.frag!");
-
-      clip_shader.setUniform("texture", sf::Shader::CurrentTexture);
-      clip_shader.setUniform("progress", bar_progress);
-   }
+   Bar::Bar() {}
 
    Bar::Bar(const BarStyle& style,
             float progress)
    {
-      if (!clip_shader.loadFromFile(CX_SHADER_PATH "clipping_shader.frag", sf::Shader::Fragment))
-         throw std::runtime_error("Could not load clipping_shader.frag!");
-
       background.setSize(style.size);
       background.setOrigin(style.size * .5f);
       background.setFillColor(style.bg_color);
@@ -46,9 +38,6 @@ namespace cx
             const Color& fg_color,
             const Color& bg_color)
    {
-      if (!clip_shader.loadFromFile(CX_SHADER_PATH "clipping_shader.frag", sf::Shader::Fragment))
-         throw std::runtime_error("Could not load clipping_shader.frag!");
-
       background.setSize(size);
       background.setOrigin(size * .5f);
       background.setPosition(position);
@@ -67,9 +56,7 @@ namespace cx
    void Bar::create(const BarStyle& style,
                     float progress)
    {
-      if (!clip_shader.loadFromFile(CX_SHADER_PATH "clipping_shader.frag", sf::Shader::Fragment))
-         throw std::runtime_error("Could not load clipping_shader.frag!");
-
+      mark_changed();
       background.setSize(style.size);
       background.setOrigin(style.size * .5f);
       background.setFillColor(style.bg_color);
@@ -89,9 +76,7 @@ namespace cx
                     const Color& fg_color,
                     const Color& bg_color)
    {
-      if (!clip_shader.loadFromFile(CX_SHADER_PATH "clipping_shader.frag", sf::Shader::Fragment))
-         throw std::runtime_error("Could not load clipping_shader.frag!");
-
+      mark_changed();
       background.setSize(size);
       background.setOrigin(size * .5f);
       background.setPosition(position);
@@ -109,36 +94,42 @@ namespace cx
 
    void Bar::set_center(const Vec2f& position)
    {
+      mark_changed();
       background.setPosition(position);
       foreground.setPosition(position);
    }
 
    void Bar::set_scale(const Vec2f& scale)
    {
+      mark_changed();
       background.setScale(scale);
       foreground.setScale(scale);
    }
 
    void Bar::set_size(const Vec2f& size)
    {
+      mark_changed();
       background.setSize(size);
       updateBar();
    }
 
    void Bar::set_rotation(float angle)
    {
+      mark_changed();
       background.setRotation(angle);
       foreground.setRotation(angle);
    }
 
    void Bar::set_texture(const sf::Texture* texture)
    {
+      mark_changed();
       foreground.setTexture(texture);
       updateBar();
    }
 
    void Bar::set_bg_texture(const sf::Texture* texture)
    {
+      mark_changed();
       background.setTexture(texture);
       updateBar();
    }
@@ -146,6 +137,7 @@ namespace cx
    void Bar::set_texture(const sf::Texture* fg_texture,
                          const sf::Texture* bg_texture)
    {
+      mark_changed();
       foreground.setTexture(fg_texture);
       background.setTexture(bg_texture);
       updateBar();
@@ -153,54 +145,75 @@ namespace cx
 
    void Bar::set_texture_rect(const Vec4i& texture_rect)
    {
+      mark_changed();
       foreground.setTextureRect(texture_rect);
    }
 
    void Bar::set_bg_texture_rect(const Vec4i& texture_rect)
    {
+      mark_changed();
       background.setTextureRect(texture_rect);
    }
 
    void Bar::set_texture_rect(const Vec4i& fg_texture_rect,
                               const Vec4i& bg_texture_rect)
    {
+      mark_changed();
       foreground.setTextureRect(fg_texture_rect);
       background.setTextureRect(bg_texture_rect);
    }
 
    void Bar::set_color(const Color& color)
    {
+      mark_changed();
       foreground.setFillColor(color);
    }
 
    void Bar::set_bg_color(const Color& color)
    {
+      mark_changed();
       background.setFillColor(color);
    }
 
    void Bar::set_color(const Color& fg_color, const Color& bg_color)
    {
+      mark_changed();
       foreground.setFillColor(fg_color);
       background.setFillColor(bg_color);
    }
 
    void Bar::set_bg_opacity(unsigned char opacity)
    {
+      mark_changed();
       background.setFillColor(Color(get_bg_color(), opacity));
    }
 
    void Bar::set_progress(float progress)
    {
+      mark_changed();
       bar_progress = std::clamp(progress, 0.f, 1.f);
       updateBar();
    }
 
    void Bar::set_progress_percent(char percent)
    {
+      mark_changed();
       bar_progress = std::clamp(float(percent) * .01f, 0.f, 1.f);
       updateBar();
    }
 
+   void Bar::set_fill_mode(FillMode mode)
+   {
+      mark_changed();
+      fill_mode = mode;
+   }
+
+   void Bar::set_shader_clipping(bool enabled)
+   {
+      mark_changed();
+      shader_clipping = enabled;
+   }
+
    // Getter functions
 
    ElementType Bar::get_element_type() const
@@ -278,52 +291,70 @@ namespace cx
       return char(bar_progress * 100.f);
    }
 
+   FillMode Bar::get_fill_mode() const
+   {
+      return fill_mode;
+   }
+
+   bool Bar::is_shader_clipping() const
+   {
+      return shader_clipping;
+   }
+
    // Update functions
 
    void Bar::increment_progress(float value)
    {
+      mark_changed();
       bar_progress = std::clamp(bar_progress + value, 0.f, 1.f);
       updateBar();
    }
 
    void Bar::increment_progress_percent(char percent)
    {
+      mark_changed();
       bar_progress = std::clamp(bar_progress + float(percent) * .01f, 0.f, 1.f);
       updateBar();
    }
 
    void Bar::decrement_progress(float value)
    {
+      mark_changed();
       bar_progress = std::clamp(bar_progress - value, 0.f, 1.f);
       updateBar();
    }
 
    void Bar::decrement_progress_percent(char percent)
    {
+      mark_changed();
       bar_progress = std::clamp(bar_progress - float(percent) * .01f, 0.f, 1.f);
       updateBar();
    }
 
    void Bar::update_progress(float value, bool condition)
    {
+      mark_changed();
       bar_progress = std::clamp(bar_progress + (condition ? value : -value), 0.f, 1.f);
       updateBar();
    }
 
    void Bar::update_progress_percent(char percent, bool condition)
    {
+      mark_changed();
       bar_progress = std::clamp(bar_progress + float(condition ? percent : -percent) * .01f, 0.f, 1.f);
       updateBar();
    }
 
    void Bar::update_progress(float positive, float negative, bool condition)
    {
+      mark_changed();
       bar_progress = std::clamp(bar_progress + (condition ? positive : -negative), 0.f, 1.f);
       updateBar();
    }
 
    void Bar::update_progress_percent(char positive, char negative, bool condition)
    {
+      mark_changed();
       bar_progress = std::clamp(bar_progress + float(condition ? positive : -negative) * .01f, 0.f, 1.f);
       updateBar();
    }
@@ -335,34 +366,37 @@ namespace cx
 
    // Render functions
 
-   void Bar::render(sf::RenderWindow& window) const
+   void Bar::render(sf::RenderTarget& target) const
+   {
+      target.draw(background);
+
+      render_foreground(target, nullptr);
+   }
+
+   void Bar::render(sf::RenderTarget& target, const sf::Shader* shader) const
    {
-      window.draw(background);
+      target.draw(background, shader);
 
-      if (bar_progress > 0.f && foreground.getTexture() != nullptr)
-         window.draw(foreground, &clip_shader);
-      else if (bar_progress > 0.f)
-         window.draw(foreground);
+      render_foreground(target, shader);
    }
 
-   void Bar::render(sf::RenderWindow& window, const sf::Shader* shader) const
+   void Bar::submit(RenderBatch& batch, int layer) const
    {
-      window.draw(background, shader);
+      batch.submit(background, layer);
 
-      if (bar_progress > 0.f && foreground.getTexture() != nullptr)
-         window.draw(foreground, &clip_shader);
-      else if (bar_progress > 0.f)
-         window.draw(foreground, shader);
+      sf::Vertex vertices[progress_fill_max_vertices];
+      const size_t count = build_progress_fill(foreground, bar_progress, fill_mode, vertices);
+      batch.submit(vertices, count, foreground.getTexture(), layer);
    }
 
    // Access functions
    
-   sf::RectangleShape& Bar::get_foreground()
+   Quad& Bar::get_foreground()
    {
       return foreground;
    }
 
-   sf::RectangleShape& Bar::get_background()
+   Quad& Bar::get_background()
    {
       return background;
    }
@@ -371,15 +405,34 @@ namespace cx
 
    void Bar::updateBar()
    {
-      clip_shader.setUniform("progress", bar_progress);
-      clip_shader.setUniform("texture", sf::Shader::CurrentTexture);
-
-      if (foreground.getTexture() == nullptr)
-         foreground.setSize(Vec2f(background.getSize().x * bar_progress, background.getSize().y));
-      else
-         foreground.setSize(background.getSize());
+      // Progress is applied when drawing, the foreground always covers the background
+      foreground.setSize(background.getSize());
       
       background.setOrigin(background.getSize() * .5f);
       foreground.setOrigin(background.getOrigin());
    }
+
+   void Bar::render_foreground(sf::RenderTarget& target, const sf::Shader* shader) const
+   {
+      if (bar_progress <= 0.f)
+         return;
+
+      // Shared by every instance, so progress is set right before drawing
+      if (shader_clipping && fill_mode == FillMode::left_to_right && foreground.getTexture() != nullptr)
+      {
+         if (sf::Shader* clip_shader = shaders::get_clipping_shader())
+         {
+            clip_shader->setUniform("progress", bar_progress);
+            target.draw(foreground, clip_shader);
+            return;
+         }
+      }
+
+      sf::Vertex vertices[progress_fill_max_vertices];
+      sf::RenderStates states;
+      states.texture = foreground.getTexture();
+      states.shader = shader;
+
+      target.draw(vertices, build_progress_fill(foreground, bar_progress, fill_mode, vertices), sf::Triangles, states);
+   }
 }
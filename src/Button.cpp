@@ -1,5 +1,6 @@
 #include "CX/Button/Button.hpp"
 
+#include "CX/Render/RenderBatch.hpp"
 #include <sstream>
 
 namespace cx
@@ -68,6 +69,7 @@ namespace cx
    void Button::create(const ButtonStyle& style,
                        const std::string& string)
    {
+      mark_changed();
       if (style.font->getInfo().family.empty())
          throw std::runtime_error(errors::text::invalid_font);
 
@@ -94,6 +96,7 @@ namespace cx
                        const Vec2f& position,
                        unsigned char_size)
    {
+      mark_changed();
       if (font.getInfo().family.empty())
          throw std::runtime_error(errors::text::invalid_font);
 
@@ -115,18 +118,21 @@ namespace cx
 
    void Button::set_center(const Vec2f& position)
    {
+      mark_changed();
       rect.setPosition(position);
       text.setPosition(position);
    }
 
    void Button::set_scale(const Vec2f& scale)
    {
+      mark_changed();
       rect.setScale(scale);
       text.setScale(scale);
    }
 
    void Button::set_size(const Vec2f& size)
    {
+      mark_changed();
       rect.setSize(size);
       rect.setOrigin(size * .5f);
       text.setPosition(rect.getPosition());
@@ -134,33 +140,39 @@ namespace cx
 
    void Button::set_rotation(float angle)
    {
+      mark_changed();
       rect.setRotation(angle);
       text.setRotation(angle);
    }
 
    void Button::set_texture(const sf::Texture* texture)
    {
+      mark_changed();
       rect.setTexture(texture);
    }
 
    void Button::set_texture_rect(const Vec4i& texture_rect)
    {
+      mark_changed();
       rect.setTextureRect(texture_rect);
    }
 
    void Button::set_color(const Color& color)
    {
+      mark_changed();
       rect.setFillColor(color);
    }
 
    void Button::set_string(const std::string& string)
    {
+      mark_changed();
       text.setString(string);
       recenter();
    }
 
    void Button::set_font(const sf::Font& font)
    {
+      mark_changed();
       if (font.getInfo().family.empty())
          throw std::runtime_error(errors::text::invalid_font);
       text.setFont(font);
@@ -169,43 +181,51 @@ namespace cx
 
    void Button::set_char_size(unsigned char_size)
    {
+      mark_changed();
       text.setCharacterSize(char_size);
       recenter();
    }
 
    void Button::set_style(FontStyle style)
    {
+      mark_changed();
       text.setStyle(static_cast<sf::Text::Style>(style));
       recenter();
    }
 
    void Button::set_text_color(const Color& color)
    {
+      mark_changed();
       text.setFillColor(color);
    }
 
    void Button::set_text_opacity(unsigned char opacity)
    {
+      mark_changed();
       text.setFillColor(Color(get_text_color(), opacity));
    }
 
    void Button::set_text_outline_color(const Color& color)
    {
+      mark_changed();
       text.setOutlineColor(color);
    }
 
    void Button::set_text_outline_thickness(float thickness)
    {
+      mark_changed();
       text.setOutlineThickness(thickness);
    }
 
    void Button::set_disabled(bool disabled)
    {
+      mark_changed();
       button_disabled = disabled;
    }
 
    void Button::toggle_disabled()
    {
+      mark_changed();
       button_disabled = !button_disabled;
    }
 
@@ -305,6 +325,7 @@ namespace cx
 
    void Button::truncate()
    {
+      mark_changed();
       const float max_width {rect.getSize().x};
 
       if (text.getGlobalBounds().width <= max_width || text.getString().isEmpty())
@@ -335,6 +356,7 @@ namespace cx
 
    void Button::wrap()
    {
+      mark_changed();
       const float max_width {rect.getSize().x};
 
       if (text.getGlobalBounds().width <= max_width || text.getString().isEmpty())
@@ -387,6 +409,7 @@ namespace cx
 
    void Button::fit_inside()
    {
+      mark_changed();
       const Vec2f rect_size (rect.getSize());
       
       if ((text.getGlobalBounds().width <= rect_size.x && text.getGlobalBounds().height <= rect_size.y) || text.getString().isEmpty())
@@ -481,21 +504,27 @@ namespace cx
 
    // Render functions
 
-   void Button::render(sf::RenderWindow& window) const
+   void Button::render(sf::RenderTarget& target) const
    {
-      window.draw(rect);
-      window.draw(text);
+      target.draw(rect);
+      target.draw(text);
    }
 
-   void Button::render(sf::RenderWindow& window, const sf::Shader* shader) const
+   void Button::render(sf::RenderTarget& target, const sf::Shader* shader) const
    {
-      window.draw(rect, shader);
-      window.draw(text, shader);
+      target.draw(rect, shader);
+      target.draw(text, shader);
+   }
+
+   void Button::submit(RenderBatch& batch, int layer) const
+   {
+      batch.submit(rect, layer);
+      batch.submit(text, glyphs, layer);
    }
 
    // Access functions
 
-   sf::RectangleShape& Button::get_background()
+   Quad& Button::get_background()
    {
       return rect;
    }
@@ -1,5 +1,7 @@
 #include "CX/Circle/Circle.hpp"
 
+#include "CX/Render/RenderBatch.hpp"
+
 namespace cx
 {
    // Set default styles
@@ -37,6 +39,7 @@ namespace cx
 
    void Circle::create(const CircleStyle& style)
    {
+      mark_changed();
       circle.setRadius(style.radius);
       circle.setOrigin(Vec2f(style.radius));
       circle.setPointCount(style.point_count);
@@ -49,6 +52,7 @@ namespace cx
                        const Color& color,
                        size_t point_count)
    {
+      mark_changed();
       circle.setRadius(radius);
       circle.setOrigin(Vec2f(radius));
       circle.setPosition(position);
@@ -60,47 +64,56 @@ namespace cx
 
    void Circle::set_center(const Vec2f& position)
    {
+      mark_changed();
       circle.setPosition(position);
    }
 
    void Circle::set_scale(const Vec2f& scale)
    {
+      mark_changed();
       circle.setScale(scale);
    }
 
    void Circle::set_size(const Vec2f& size)
    {
+      mark_changed();
       circle.setScale(size / get_size());
    }
 
    void Circle::set_rotation(float angle)
    {
+      mark_changed();
       circle.setRotation(angle);
    }
 
    void Circle::set_texture(const sf::Texture* texture)
    {
+      mark_changed();
       circle.setTexture(texture);
    }
 
    void Circle::set_texture_rect(const Vec4i& rect)
    {
+      mark_changed();
       circle.setTextureRect(rect);
    }
 
    void Circle::set_color(const Color& color)
    {
+      mark_changed();
       circle.setFillColor(color);
    }
 
    void Circle::set_radius(float radius)
    {
+      mark_changed();
       circle.setRadius(radius);
       circle.setOrigin(Vec2f(radius));
    }
 
    void Circle::set_point_count(size_t point_count)
    {
+      mark_changed();
       circle.setPointCount(point_count);
    }
 
@@ -181,14 +194,19 @@ namespace cx
 
    // Render functions
 
-   void Circle::render(sf::RenderWindow& window) const
+   void Circle::render(sf::RenderTarget& target) const
+   {
+      target.draw(circle);
+   }
+
+   void Circle::render(sf::RenderTarget& target, const sf::Shader* shader) const
    {
-      window.draw(circle);
+      target.draw(circle, shader);
    }
 
-   void Circle::render(sf::RenderWindow& window, const sf::Shader* shader) const
+   void Circle::submit(RenderBatch& batch, int layer) const
    {
-      window.draw(circle, shader);
+      batch.submit(circle, layer);
    }
 
    // Access functions
@@ -0,0 +1,233 @@
+#include "CX/Text/GlyphRun.hpp"
+
+#include <SFML/Graphics/Font.hpp>
+#include <cmath>
+
+namespace cx
+{
+   namespace
+   {
+      /// @brief Add the quad of a glyph.
+      /// @param out Vertices.
+      /// @param position Pen position.
+      /// @param color Color.
+      /// @param glyph Glyph.
+      /// @param shear Italic shear.
+      void add_glyph_quad(std::vector<sf::Vertex>& out, const sf::Vector2f& position, const sf::Color& color,
+                          const sf::Glyph& glyph, float shear)
+      {
+         // Same padding as sf::Text, keeps smoothed edges from being cut off
+         constexpr float padding = 1.f;
+
+         const float left = glyph.bounds.left - padding;
+         const float top = glyph.bounds.top - padding;
+         const float right = glyph.bounds.left + glyph.bounds.width + padding;
+         const float bottom = glyph.bounds.top + glyph.bounds.height + padding;
+
+         const float u1 = float(glyph.textureRect.left) - padding;
+         const float v1 = float(glyph.textureRect.top) - padding;
+         const float u2 = float(glyph.textureRect.left + glyph.textureRect.width) + padding;
+         const float v2 = float(glyph.textureRect.top + glyph.textureRect.height) + padding;
+
+         out.emplace_back(sf::Vector2f(position.x + left - shear * top, position.y + top), color, sf::Vector2f(u1, v1));
+         out.emplace_back(sf::Vector2f(position.x + right - shear * top, position.y + top), color, sf::Vector2f(u2, v1));
+         out.emplace_back(sf::Vector2f(position.x + left - shear * bottom, position.y + bottom), color, sf::Vector2f(u1, v2));
+         out.emplace_back(sf::Vector2f(position.x + left - shear * bottom, position.y + bottom), color, sf::Vector2f(u1, v2));
+         out.emplace_back(sf::Vector2f(position.x + right - shear * top, position.y + top), color, sf::Vector2f(u2, v1));
+         out.emplace_back(sf::Vector2f(position.x + right - shear * bottom, position.y + bottom), color, sf::Vector2f(u2, v2));
+      }
+
+      /// @brief Add an underline or strike through line.
+      /// @param out Vertices.
+      /// @param length Line length.
+      /// @param line_top Top of the text line.
+      /// @param color Color.
+      /// @param offset Offset of the line from the top of the text line.
+      /// @param thickness Line thickness.
+      /// @param outline Outline thickness.
+      void add_line(std::vector<sf::Vertex>& out, float length, float line_top, const sf::Color& color,
+                    float offset, float thickness, float outline = 0.f)
+      {
+         const float top = std::floor(line_top + offset - thickness / 2.f + .5f);
+         const float bottom = top + std::floor(thickness + .5f);
+
+         // Texture coordinates of a white pixel in every font page
+         const sf::Vector2f white (1.f, 1.f);
+
+         out.emplace_back(sf::Vector2f(-outline, top - outline), color, white);
+         out.emplace_back(sf::Vector2f(length + outline, top - outline), color, white);
+         out.emplace_back(sf::Vector2f(-outline, bottom + outline), color, white);
+         out.emplace_back(sf::Vector2f(-outline, bottom + outline), color, white);
+         out.emplace_back(sf::Vector2f(length + outline, top - outline), color, white);
+         out.emplace_back(sf::Vector2f(length + outline, bottom + outline), color, white);
+      }
+
+      /// @brief Hash a string with FNV-1a, reading it in place.
+      /// @param string String.
+      /// @return Hash.
+      uint64_t hash_string(const sf::String& string)
+      {
+         uint64_t hash = 14695981039346656037ull;
+
+         for (const sf::Uint32 character : string)
+         {
+            hash ^= character;
+            hash *= 1099511628211ull;
+         }
+
+         return hash;
+      }
+   }
+
+   // Key
+
+   bool GlyphRun::Key::operator==(const Key& other) const
+   {
+      return font == other.font && size == other.size && style == other.style &&
+             letter_spacing == other.letter_spacing && line_spacing == other.line_spacing &&
+             outline_thickness == other.outline_thickness && fill_color == other.fill_color &&
+             outline_color == other.outline_color && length == other.length && hash == other.hash;
+   }
+
+   // Update functions
+
+   bool GlyphRun::update(const sf::Text& text)
+   {
+      const sf::String& string = text.getString();
+      const Key current {string.getSize(), hash_string(string), text.getFont(), text.getCharacterSize(),
+                         text.getStyle(), text.getLetterSpacing(), text.getLineSpacing(),
+                         text.getOutlineThickness(), text.getFillColor(), text.getOutlineColor()};
+
+      if (built && current == key)
+         return false;
+
+      key = current;
+      build(string);
+      built = true;
+      ++rebuild_count;
+      return true;
+   }
+
+   void GlyphRun::invalidate()
+   {
+      built = false;
+   }
+
+   // Getter functions
+
+   const std::vector<sf::Vertex>& GlyphRun::get_vertices() const
+   {
+      return vertices;
+   }
+
+   size_t GlyphRun::get_outline_count() const
+   {
+      return outline_count;
+   }
+
+   const sf::Texture* GlyphRun::get_texture() const
+   {
+      return texture;
+   }
+
+   size_t GlyphRun::get_rebuild_count() const
+   {
+      return rebuild_count;
+   }
+
+   // Private functions
+
+   void GlyphRun::build(const sf::String& string)
+   {
+      vertices.clear();
+      fill.clear();
+      outline_count = 0u;
+      texture = nullptr;
+
+      const sf::Font* font = key.font;
+      if (!font || string.isEmpty())
+         return;
+
+      // Follows the layout of sf::Text
+      const bool bold = (key.style & sf::Text::Bold) != 0u;
+      const bool underlined = (key.style & sf::Text::Underlined) != 0u;
+      const bool strike_through = (key.style & sf::Text::StrikeThrough) != 0u;
+      const float shear = (key.style & sf::Text::Italic) != 0u ? .209f : 0.f;
+      const float outline = key.outline_thickness;
+
+      const float underline_offset = font->getUnderlinePosition(key.size);
+      const float underline_thickness = font->getUnderlineThickness(key.size);
+
+      const sf::FloatRect x_bounds = font->getGlyph(U'x', key.size, bold).bounds;
+      const float strike_through_offset = x_bounds.top + x_bounds.height / 2.f;
+
+      float whitespace_width = font->getGlyph(U' ', key.size, bold).advance;
+      const float letter_spacing = (whitespace_width / 3.f) * (key.letter_spacing - 1.f);
+      whitespace_width += letter_spacing;
+      const float line_spacing = font->getLineSpacing(key.size) * key.line_spacing;
+
+      float x = 0.f;
+      float y = float(key.size);
+      sf::Uint32 previous = 0u;
+
+      const auto add_lines = [&]()
+      {
+         if (underlined)
+         {
+            add_line(fill, x, y, key.fill_color, underline_offset, underline_thickness);
+            if (outline != 0.f)
+               add_line(vertices, x, y, key.outline_color, underline_offset, underline_thickness, outline);
+         }
+
+         if (strike_through)
+         {
+            add_line(fill, x, y, key.fill_color, strike_through_offset, underline_thickness);
+            if (outline != 0.f)
+               add_line(vertices, x, y, key.outline_color, strike_through_offset, underline_thickness, outline);
+         }
+      };
+
+      for (const sf::Uint32 current : string)
+      {
+         if (current == U'\r')
+            continue;
+
+         x += font->getKerning(previous, current, key.size, bold);
+
+         if (current == U'\n' && previous != U'\n')
+            add_lines();
+
+         previous = current;
+
+         if (current == U' ' || current == U'\n' || current == U'\t')
+         {
+            switch (current)
+            {
+            case U' ':  x += whitespace_width;      break;
+            case U'\t': x += whitespace_width * 4.f; break;
+            case U'\n': y += line_spacing; x = 0.f;  break;
+            }
+
+            continue;
+         }
+
+         // Outline quads go into the vertices, fill quads are appended after them
+         if (outline != 0.f)
+            add_glyph_quad(vertices, sf::Vector2f(x, y), key.outline_color, font->getGlyph(current, key.size, bold, outline), shear);
+
+         const sf::Glyph& glyph = font->getGlyph(current, key.size, bold);
+         add_glyph_quad(fill, sf::Vector2f(x, y), key.fill_color, glyph, shear);
+
+         x += glyph.advance + letter_spacing;
+      }
+
+      if (x > 0.f)
+         add_lines();
+
+      outline_count = vertices.size();
+      vertices.insert(vertices.end(), fill.begin(), fill.end());
+
+      // Loading glyphs may have grown the page, take it last
+      texture = &font->getTexture(key.size);
+   }
+}
@@ -0,0 +1,249 @@
+#include "CX/Particle/ParticleKernel.hpp"
+
+#include "CX/Config.hpp"
+#include <type_traits>
+
+#ifdef CX_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define CX_TARGET_SSE2
+#define CX_TARGET_AVX2
+#else
+// 32-bit builds may not enable SSE2 by default
+#define CX_TARGET_SSE2 __attribute__((target("sse2")))
+#define CX_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace cx
+{
+   // Vec2f arrays are integrated as flat float arrays
+   static_assert(sizeof(Vec2f) == sizeof(float) * 2 && std::is_standard_layout_v<Vec2f>,
+                 "Vec2f must be two tightly packed floats.");
+
+   namespace
+   {
+      /// @brief Pointers to every array the kernel touches.
+      struct Lanes
+      {
+         float* position;
+         float* velocity;
+         const float* acceleration;
+         float* scale;
+         const float* scale_velocity;
+         float* rotation;
+         const float* rot_velocity;
+         const float* friction;
+         float* age;
+      };
+
+      Lanes get_lanes(ParticleStorage& storage)
+      {
+         return Lanes {
+            reinterpret_cast<float*>(storage.position.data()),
+            reinterpret_cast<float*>(storage.velocity.data()),
+            reinterpret_cast<const float*>(storage.acceleration.data()),
+            reinterpret_cast<float*>(storage.scale.data()),
+            reinterpret_cast<const float*>(storage.scale_velocity.data()),
+            storage.rotation.data(),
+            storage.rot_velocity.data(),
+            storage.friction.data(),
+            storage.age.data()
+         };
+      }
+
+      /// @brief Integrate particles in [begin, end) without vector instructions.
+      void integrate_scalar(const Lanes& lanes, size_t begin, size_t end, float dt)
+      {
+         for (size_t i = begin; i < end; ++i)
+         {
+            lanes.age[i] += dt;
+            lanes.rotation[i] += lanes.rot_velocity[i] * dt;
+
+            const float damping = 1.f - lanes.friction[i] * dt;
+
+            for (size_t j = i * 2; j < i * 2 + 2; ++j)
+            {
+               const float velocity = lanes.velocity[j];
+               lanes.position[j] += velocity * dt;
+               lanes.velocity[j] = (velocity + lanes.acceleration[j] * dt) * damping;
+               lanes.scale[j] += lanes.scale_velocity[j] * dt;
+            }
+         }
+      }
+
+#ifdef CX_X86
+      /// @brief Integrate particles 4 at a time with SSE2, returns the first particle left over.
+      CX_TARGET_SSE2 size_t integrate_sse2(const Lanes& lanes, size_t begin, size_t end, float dt)
+      {
+         const __m128 delta = _mm_set1_ps(dt);
+         const __m128 one = _mm_set1_ps(1.f);
+         size_t i = begin;
+
+         for (; i + 4 <= end; i += 4)
+         {
+            // Scalar lanes
+            _mm_storeu_ps(lanes.age + i, _mm_add_ps(_mm_loadu_ps(lanes.age + i), delta));
+            _mm_storeu_ps(lanes.rotation + i, _mm_add_ps(_mm_loadu_ps(lanes.rotation + i),
+                          _mm_mul_ps(_mm_loadu_ps(lanes.rot_velocity + i), delta)));
+
+            // Broadcast damping of each particle to both of its components
+            const __m128 damping = _mm_sub_ps(one, _mm_mul_ps(_mm_loadu_ps(lanes.friction + i), delta));
+            const __m128 damping_lo = _mm_unpacklo_ps(damping, damping);
+            const __m128 damping_hi = _mm_unpackhi_ps(damping, damping);
+
+            // Vector lanes, 2 particles per register
+            for (size_t half = 0; half < 2; ++half)
+            {
+               const size_t j = i * 2 + half * 4;
+               const __m128 damp = half == 0 ? damping_lo : damping_hi;
+
+               const __m128 velocity = _mm_loadu_ps(lanes.velocity + j);
+               _mm_storeu_ps(lanes.position + j, _mm_add_ps(_mm_loadu_ps(lanes.position + j),
+                             _mm_mul_ps(velocity, delta)));
+               _mm_storeu_ps(lanes.velocity + j, _mm_mul_ps(_mm_add_ps(velocity,
+                             _mm_mul_ps(_mm_loadu_ps(lanes.acceleration + j), delta)), damp));
+               _mm_storeu_ps(lanes.scale + j, _mm_add_ps(_mm_loadu_ps(lanes.scale + j),
+                             _mm_mul_ps(_mm_loadu_ps(lanes.scale_velocity + j), delta)));
+            }
+         }
+
+         return i;
+      }
+
+      /// @brief Integrate particles 8 at a time with AVX2, returns the first particle left over.
+      CX_TARGET_AVX2 size_t integrate_avx2(const Lanes& lanes, size_t begin, size_t end, float dt)
+      {
+         const __m256 delta = _mm256_set1_ps(dt);
+         const __m256 one = _mm256_set1_ps(1.f);
+         size_t i = begin;
+
+         for (; i + 8 <= end; i += 8)
+         {
+            // Scalar lanes
+            _mm256_storeu_ps(lanes.age + i, _mm256_add_ps(_mm256_loadu_ps(lanes.age + i), delta));
+            _mm256_storeu_ps(lanes.rotation + i, _mm256_add_ps(_mm256_loadu_ps(lanes.rotation + i),
+                             _mm256_mul_ps(_mm256_loadu_ps(lanes.rot_velocity + i), delta)));
+
+            // Broadcast damping of each particle to both of its components,
+            // unpack works per 128-bit half so the halves are put back in order after
+            const __m256 damping = _mm256_sub_ps(one, _mm256_mul_ps(_mm256_loadu_ps(lanes.friction + i), delta));
+            const __m256 unpacked_lo = _mm256_unpacklo_ps(damping, damping);
+            const __m256 unpacked_hi = _mm256_unpackhi_ps(damping, damping);
+            const __m256 damping_lo = _mm256_permute2f128_ps(unpacked_lo, unpacked_hi, 0x20);
+            const __m256 damping_hi = _mm256_permute2f128_ps(unpacked_lo, unpacked_hi, 0x31);
+
+            // Vector lanes, 4 particles per register
+            for (size_t half = 0; half < 2; ++half)
+            {
+               const size_t j = i * 2 + half * 8;
+               const __m256 damp = half == 0 ? damping_lo : damping_hi;
+
+               const __m256 velocity = _mm256_loadu_ps(lanes.velocity + j);
+               _mm256_storeu_ps(lanes.position + j, _mm256_add_ps(_mm256_loadu_ps(lanes.position + j),
+                                _mm256_mul_ps(velocity, delta)));
+               _mm256_storeu_ps(lanes.velocity + j, _mm256_mul_ps(_mm256_add_ps(velocity,
+                                _mm256_mul_ps(_mm256_loadu_ps(lanes.acceleration + j), delta)), damp));
+               _mm256_storeu_ps(lanes.scale + j, _mm256_add_ps(_mm256_loadu_ps(lanes.scale + j),
+                                _mm256_mul_ps(_mm256_loadu_ps(lanes.scale_velocity + j), delta)));
+            }
+         }
+
+         return i;
+      }
+
+      /// @brief Check if the CPU and OS support AVX2.
+      bool supports_avx2()
+      {
+#ifdef _MSC_VER
+         int info[4];
+         __cpuid(info, 0);
+         if (info[0] < 7)
+            return false;
+
+         // AVX and OSXSAVE, then check that the OS saves YMM registers
+         __cpuid(info, 1);
+         if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+            return false;
+         if ((_xgetbv(0) & 0x6) != 0x6)
+            return false;
+
+         __cpuidex(info, 7, 0);
+         return (info[1] & (1 << 5)) != 0;
+#else
+         __builtin_cpu_init();
+         return __builtin_cpu_supports("avx2");
+#endif
+      }
+
+      /// @brief Check if the CPU supports SSE2.
+      bool supports_sse2()
+      {
+#if defined(_M_X64) || defined(__x86_64__)
+         return true;
+#elif defined(_MSC_VER)
+         int info[4];
+         __cpuid(info, 1);
+         return (info[3] & (1 << 26)) != 0;
+#else
+         __builtin_cpu_init();
+         return __builtin_cpu_supports("sse2");
+#endif
+      }
+#endif
+   }
+
+   SimdLevel get_simd_level()
+   {
+      static const SimdLevel level = []
+      {
+#ifdef CX_X86
+         if (supports_avx2())
+            return SimdLevel::avx2;
+         if (supports_sse2())
+            return SimdLevel::sse2;
+#endif
+         return SimdLevel::scalar;
+      }();
+
+      return level;
+   }
+
+   void integrate_particles(ParticleStorage& storage, float dt)
+   {
+      integrate_particles(storage, dt, get_simd_level());
+   }
+
+   void integrate_particles(ParticleStorage& storage, float dt, SimdLevel level)
+   {
+      integrate_particles(storage, dt, 0, storage.count(), level);
+   }
+
+   void integrate_particles(ParticleStorage& storage, float dt, size_t begin, size_t end)
+   {
+      integrate_particles(storage, dt, begin, end, get_simd_level());
+   }
+
+   void integrate_particles(ParticleStorage& storage, float dt, size_t begin, size_t end, SimdLevel level)
+   {
+      if (begin >= end)
+         return;
+
+      const Lanes lanes = get_lanes(storage);
+
+      if (level > get_simd_level())
+         level = get_simd_level();
+
+      size_t done = begin;
+
+#ifdef CX_X86
+      if (level == SimdLevel::avx2)
+         done = integrate_avx2(lanes, begin, end, dt);
+      else if (level == SimdLevel::sse2)
+         done = integrate_sse2(lanes, begin, end, dt);
+#endif
+
+      integrate_scalar(lanes, done, end, dt);
+   }
+}
@@ -1,7 +1,10 @@
 #include "CX/ParticleManager.hpp"
 
+#include "CX/Camera.hpp"
 #include "CX/Math/Math.hpp"
 #include "CX/Math/Random.hpp"
+#include "CX/Particle/ParticleKernel.hpp"
+#include <cmath>
 
 namespace cx
 {
@@ -13,12 +16,13 @@ namespace cx
                                     float lifetime,
                                     float spawn_rate)
    {
-      position = spawn_position;
+      position = last_position = spawn_position;
       size_min = size_max = particle_size;
       this->particle_count = particle_count;
       lifetime_min = lifetime_max = lifetime;
       this->spawn_rate = spawn_rate;
       spawn_rate_fraction = 1.f / spawn_rate;
+      reserve_pool();
    }
 
    // Constructors after creation
@@ -29,12 +33,13 @@ namespace cx
                                 float lifetime,
                                 float spawn_rate)
    {
-      position = spawn_position;
+      position = last_position = spawn_position;
       size_min = size_max = particle_size;
       this->particle_count = particle_count;
       lifetime_min = lifetime_max = lifetime;
       this->spawn_rate = spawn_rate;
       spawn_rate_fraction = 1.f / spawn_rate;
+      reserve_pool();
    }
 
    // Setter functions
@@ -224,31 +229,82 @@ namespace cx
       set_texture_pieces(pieces);
    }
 
+   void ParticleManager::set_texture_properties(const TextureRegion& region, size_t pieces)
+   {
+      set_texture_properties(region.texture, region.rect, pieces);
+   }
+
    void ParticleManager::set_texture(const sf::Texture* texture)
    {
       this->texture = texture;
    }
 
+   void ParticleManager::set_texture(const TextureRegion& region)
+   {
+      set_texture(region.texture);
+      set_texture_rect(region.rect);
+   }
+
    void ParticleManager::set_texture_rect(const Vec4i& texture_rect)
    {
       this->texture_rect = texture_rect;
+
+      if (pieces != 0u)
+         set_texture_pieces(pieces);
    }
 
    void ParticleManager::set_texture_pieces(size_t pieces)
    {
       this->pieces = pieces;
-      piece_size = texture->getSize() / unsigned(pieces);
+
+      // Pieces split the texture rectangle, so images packed into an atlas work the same
+      if (!texture_rect.empty())
+         piece_size = Vec2f(float(texture_rect.w), float(texture_rect.h)) / float(pieces);
+      else
+         piece_size = texture->getSize() / unsigned(pieces);
    }
 
    void ParticleManager::set_color(const Color& color)
    {
       color_start = color_end = color;
+      color_curve.clear();
    }
 
    void ParticleManager::set_color(const Color& start_color, const Color& end_color)
    {
       color_start = start_color;
       color_end = end_color;
+
+      if (color_start != color_end)
+         color_curve.set_keys({{0.f, color_start}, {1.f, color_end}});
+      else
+         color_curve.clear();
+   }
+
+   void ParticleManager::set_color_gradient(const std::vector<CurveKey<Color>>& stops)
+   {
+      color_curve.set_keys(stops);
+
+      if (!color_curve.empty())
+      {
+         color_start = color_curve.get_keys().front().value;
+         color_end = color_curve.get_keys().back().value;
+      }
+   }
+
+   void ParticleManager::set_scale_curve(const std::vector<CurveKey<float>>& keys)
+   {
+      scale_curve.set_keys(keys);
+   }
+
+   void ParticleManager::set_alpha_curve(const std::vector<CurveKey<float>>& keys)
+   {
+      alpha_curve.set_keys(keys);
+   }
+
+   void ParticleManager::set_rotation_speed_curve(const std::vector<CurveKey<float>>& keys)
+   {
+      rotation_curve.set_keys(keys);
    }
 
    void ParticleManager::set_properties(float lifetime,
@@ -303,6 +359,7 @@ namespace cx
    {
       this->particle_count = particle_count;
       spawned_count = 0u;
+      reserve_pool();
    }
 
    void ParticleManager::set_explosive(bool explosive)
@@ -321,21 +378,76 @@ namespace cx
       this->can_spawn = can_spawn;
    }
 
+   void ParticleManager::set_capacity(size_t capacity)
+   {
+      this->capacity = capacity;
+      reserve_pool();
+   }
+
+   void ParticleManager::set_seed(uint64_t seed)
+   {
+      rng.seed(seed);
+      bulk_rng.seed(seed);
+   }
+
+   void ParticleManager::set_camera(const Camera* camera)
+   {
+      this->camera = camera;
+   }
+
+   void ParticleManager::set_lazy_offscreen(bool lazy_offscreen)
+   {
+      this->lazy_offscreen = lazy_offscreen;
+   }
+
+   void ParticleManager::set_lod(float near_distance, float far_distance, float far_scale)
+   {
+      lod_near = min(near_distance, far_distance);
+      lod_far = max(near_distance, far_distance);
+      lod_far_scale = clamp(far_scale, 0.f, 1.f);
+   }
+
+   void ParticleManager::disable_lod()
+   {
+      lod_near = lod_far = 0.f;
+      lod_far_scale = lod_scale = 1.f;
+   }
+
+   void ParticleManager::set_overflow_policy(OverflowPolicy overflow_policy)
+   {
+      this->overflow_policy = overflow_policy;
+   }
+
    // Getter functions
 
-   std::vector<std::shared_ptr<Particle>>& ParticleManager::get_particles()
+   ParticleRange ParticleManager::get_particles()
+   {
+      return ParticleRange(particles);
+   }
+
+   ConstParticleRange ParticleManager::get_particles() const
+   {
+      return ConstParticleRange(particles);
+   }
+
+   ParticleStorage& ParticleManager::get_storage()
    {
       return particles;
    }
 
-   const std::vector<std::shared_ptr<Particle>>& ParticleManager::get_particles() const
+   const ParticleStorage& ParticleManager::get_storage() const
    {
       return particles;
    }
 
    size_t ParticleManager::size() const
    {
-      return particles.size();
+      return particles.count();
+   }
+
+   const sf::VertexArray& ParticleManager::get_vertices() const
+   {
+      return vertices;
    }
 
    const sf::Texture* ParticleManager::get_texture() const
@@ -458,6 +570,26 @@ namespace cx
       return color_end;
    }
 
+   const LifetimeCurve<Color>& ParticleManager::get_color_gradient() const
+   {
+      return color_curve;
+   }
+
+   const LifetimeCurve<float>& ParticleManager::get_scale_curve() const
+   {
+      return scale_curve;
+   }
+
+   const LifetimeCurve<float>& ParticleManager::get_alpha_curve() const
+   {
+      return alpha_curve;
+   }
+
+   const LifetimeCurve<float>& ParticleManager::get_rotation_speed_curve() const
+   {
+      return rotation_curve;
+   }
+
    float ParticleManager::get_lifetime_min() const
    {
       return lifetime_min;
@@ -493,138 +625,453 @@ namespace cx
       return can_spawn;
    }
 
+   const Camera* ParticleManager::get_camera() const
+   {
+      return camera;
+   }
+
+   const Vec4f& ParticleManager::get_bounds() const
+   {
+      return bounds;
+   }
+
+   bool ParticleManager::is_visible() const
+   {
+      if (camera == nullptr)
+         return true;
+
+      // Spawn area including the largest particle size, so emitters entering the view count as visible
+      const Vec2f reach = size_max + Vec2f(spawn_radius_max);
+      const Vec4f spawn_area (position - reach, reach * 2.f);
+      const Vec4f area = merge_bounds(bounds, spawn_area);
+
+      return camera->on_screen(Vec5f(area.x, area.y, area.w, area.h, 0.f));
+   }
+
+   bool ParticleManager::get_lazy_offscreen() const
+   {
+      return lazy_offscreen;
+   }
+
+   float ParticleManager::get_lod_scale() const
+   {
+      return lod_scale;
+   }
+
+   size_t ParticleManager::get_capacity() const
+   {
+      return capacity != 0u ? capacity : particle_count;
+   }
+
+   OverflowPolicy ParticleManager::get_overflow_policy() const
+   {
+      return overflow_policy;
+   }
+
+   size_t ParticleManager::get_high_water_mark() const
+   {
+      return high_water_mark;
+   }
+
+   size_t ParticleManager::get_dropped_count() const
+   {
+      return dropped_count;
+   }
+
+   size_t ParticleManager::get_recycled_count() const
+   {
+      return recycled_count;
+   }
+
    // Update functions
 
    void ParticleManager::clear()
    {
       particles.clear();
+      vertices.clear();
+   }
+
+   void ParticleManager::reset_pool_stats()
+   {
+      high_water_mark = particles.count();
+      dropped_count = 0u;
+      recycled_count = 0u;
    }
 
    void ParticleManager::spawn()
    {
-      for (size_t i = 0; i < particle_count - particles.size(); ++i)
-         create_particle();
+      if (particle_count > particles.count())
+         create_particles(particle_count - particles.count());
+
+      update_vertices();
    }
 
    void ParticleManager::update(float dt)
    {
-      // Spawn logic
+      if (update_offscreen(dt))
+         return;
+
+      simulate(dt);
+      update_vertices();
+   }
+
+   void ParticleManager::update_vertices()
+   {
+      vertices.resize(particles.count() * 6u);
+
+      if (!particles.empty())
+         bounds = build_vertices(&vertices[0], 0, particles.count());
+      else
+         bounds = Vec4f();
+   }
+
+   // Render functions
+
+   void ParticleManager::render(sf::RenderWindow& window) const
+   {
+      render(window, nullptr);
+   }
+
+   void ParticleManager::render(sf::RenderWindow& window, const sf::Shader* shader) const
+   {
+      if (vertices.getVertexCount() == 0u || !is_visible())
+         return;
+
+      sf::RenderStates states;
+      states.texture = texture;
+      states.shader = shader;
+
+      window.draw(vertices, states);
+   }
+
+   // Private functions
+
+   void ParticleManager::simulate(float dt)
+   {
+      update_particles(dt, 0, particles.count());
+      particles.remove_dead();
+      update_spawn(dt);
+   }
+
+   bool ParticleManager::update_offscreen(float dt)
+   {
+      // Off screen emitters only keep time, then catch up in small steps once visible
+      if (lazy_offscreen && !is_visible())
+      {
+         offscreen_time += dt;
+         return true;
+      }
+
+      if (offscreen_time > 0.f)
+      {
+         constexpr float step = .1f;
+
+         for (float time = min(offscreen_time, lifetime_max); time > 0.f; time -= step)
+            simulate(min(time, step));
+
+         offscreen_time = 0.f;
+      }
+
+      return false;
+   }
+
+   void ParticleManager::update_lod()
+   {
+      if (camera == nullptr || lod_far <= lod_near)
+      {
+         lod_scale = 1.f;
+         return;
+      }
+
+      const float distance = position.distance(camera->get_center());
+      const float t = clamp((distance - lod_near) / (lod_far - lod_near), 0.f, 1.f);
+      lod_scale = lerp(1.f, lod_far_scale, t);
+   }
+
+   size_t ParticleManager::get_lod_count() const
+   {
+      return size_t(particle_count * lod_scale + .5f);
+   }
+
+   void ParticleManager::update_spawn(float dt)
+   {
+      // Nothing spawned yet, do not trail from the previous position
+      if (spawned_count == 0u)
+         last_position = position;
+
+      update_lod();
+      const size_t count_limit = get_lod_count();
+
       if ((!spawn_once || (spawn_once && spawned_count < particle_count)) && can_spawn)
       {
-         if (explosive && particles.size() == 0u)
-         {
-            for (size_t i = 0; i < particle_count; ++i)
-               create_particle();
-         }
-         else if (!explosive)
+         if (explosive && particles.empty())
+            create_particles(count_limit);
+         else if (!explosive && lod_scale > 0.f)
          {
+            // Count every particle that became due during this frame
+            const float fraction = spawn_rate_fraction / lod_scale;
+            const float start_timer = spawn_timer;
             spawn_timer -= dt;
 
-            if (spawn_timer <= 0.f && particle_count > particles.size())
+            if (spawn_timer <= 0.f)
             {
-               create_particle();
-               spawn_timer += spawn_rate_fraction;
+               size_t owed = size_t(-spawn_timer / fraction) + 1u;
+               spawn_timer += owed * fraction;
+
+               if (spawn_once)
+                  owed = min(owed, particle_count - spawned_count);
+
+               // Owed particles the emitter has no room for are recycled or dropped by the overflow policy
+               if (owed != 0u)
+                  create_particles(owed, max(start_timer, 0.f), dt, fraction);
             }
          }
       }
 
-      // Update particles
-      for (const auto& particle : particles)
+      last_position = position;
+   }
+
+   void ParticleManager::update_particles(float dt, size_t begin, size_t end)
+   {
+      // The kernel rotates by the speed of the current life
+      if (!rotation_curve.empty())
       {
-         particle->age += dt;
+         for (size_t i = begin; i < end; ++i)
+            particles.rot_velocity[i] = particles.rot_velocity_base[i] *
+                                        rotation_curve.sample(particles.age[i] / particles.lifetime[i]);
+      }
 
-         if (!particle->velocity.empty())
-            particle->particle.move(particle->velocity * dt);
+      integrate_particles(particles, dt, begin, end);
 
-         if (!particle->acceleration.empty())
-            particle->velocity = particle->velocity + particle->acceleration * dt;
-         
-         if (particle->friction != 0.f)
-            particle->velocity = particle->velocity * (1.f - particle->friction * dt);
+      if (!color_curve.empty())
+      {
+         for (size_t i = begin; i < end; ++i)
+            particles.color[i] = color_curve.sample(particles.age[i] / particles.lifetime[i]);
+      }
+   }
 
-         if (particle->rot_velocity != 0.f)
-            particle->particle.rotate(particle->rot_velocity * dt);
+   Vec4f ParticleManager::build_vertices(sf::Vertex* out, size_t begin, size_t end) const
+   {
+      if (begin >= end)
+         return Vec4f();
 
-         if (!particle->scale_velocity.empty())
-            particle->particle.setScale(particle->scale_velocity * dt + particle->particle.getScale());
+      Vec2f low = particles.position[begin];
+      Vec2f high = low;
 
-         if (color_start != color_end)
-            particle->particle.setFillColor(color_start.blend(color_end, particle->age / particle->lifetime));
+      for (size_t i = begin; i < end; ++i)
+      {
+         const float life  = particles.age[i] / particles.lifetime[i];
+         const float curve = scale_curve.empty() ? 1.f : scale_curve.sample(life);
+         const Vec2f half  = particles.size[i] * particles.scale[i] * (curve * .5f);
+         const float angle = Rad::convert(particles.rotation[i]);
+         const float cos   = std::cos(angle);
+         const float sin   = std::sin(angle);
+
+         // Rotated half axes of the quad
+         const Vec2f axis_x (half.x * cos, half.x * sin);
+         const Vec2f axis_y (-half.y * sin, half.y * cos);
+         const Vec2f& center = particles.position[i];
+
+         const Vec2f top_left     = center - axis_x - axis_y;
+         const Vec2f top_right    = center + axis_x - axis_y;
+         const Vec2f bottom_right = center + axis_x + axis_y;
+         const Vec2f bottom_left  = center - axis_x + axis_y;
+
+         const Vec4f rect (particles.texture_rect[i].x, particles.texture_rect[i].y,
+                           particles.texture_rect[i].w, particles.texture_rect[i].h);
+         const Vec2f tex_top_left     (rect.x, rect.y);
+         const Vec2f tex_top_right    (rect.x + rect.w, rect.y);
+         const Vec2f tex_bottom_right (rect.x + rect.w, rect.y + rect.h);
+         const Vec2f tex_bottom_left  (rect.x, rect.y + rect.h);
+
+         sf::Color color = particles.color[i];
+         if (!alpha_curve.empty())
+            color.a = sf::Uint8(color.a * std::clamp(alpha_curve.sample(life), 0.f, 1.f));
+
+         sf::Vertex* quad = out + (i - begin) * 6u;
+
+         quad[0] = sf::Vertex(top_left, color, tex_top_left);
+         quad[1] = sf::Vertex(top_right, color, tex_top_right);
+         quad[2] = sf::Vertex(bottom_right, color, tex_bottom_right);
+         quad[3] = sf::Vertex(top_left, color, tex_top_left);
+         quad[4] = sf::Vertex(bottom_right, color, tex_bottom_right);
+         quad[5] = sf::Vertex(bottom_left, color, tex_bottom_left);
+
+         // Corners of a rotated quad are symmetric around the center
+         const Vec2f extent (std::abs(axis_x.x) + std::abs(axis_y.x), std::abs(axis_x.y) + std::abs(axis_y.y));
+         low = Vec2f(min(low.x, center.x - extent.x), min(low.y, center.y - extent.y));
+         high = Vec2f(max(high.x, center.x + extent.x), max(high.y, center.y + extent.y));
       }
 
-      particles.erase(
-         std::remove_if(particles.begin(), particles.end(), [](const auto& p)
-         {return p->age >= p->lifetime;}), particles.end());
+      return Vec4f(low, high - low);
    }
 
-   // Render functions
-
-   void ParticleManager::render(sf::RenderWindow& window) const
+   Vec4f ParticleManager::merge_bounds(const Vec4f& a, const Vec4f& b)
    {
-      for (const auto& particle : particles)
-         window.draw(particle->particle);
+      if (a.w <= 0.f && a.h <= 0.f)
+         return b;
+      if (b.w <= 0.f && b.h <= 0.f)
+         return a;
+
+      const Vec2f low (min(a.x, b.x), min(a.y, b.y));
+      const Vec2f high (max(a.x + a.w, b.x + b.w), max(a.y + a.h, b.y + b.h));
+      return Vec4f(low, high - low);
    }
 
-   void ParticleManager::render(sf::RenderWindow& window, const sf::Shader* shader) const
+   void ParticleManager::create_particle()
    {
-      for (const auto& particle : particles)
-         window.draw(particle->particle, shader);
+      create_particles(1u);
    }
 
-   // Private functions
-
-   void ParticleManager::create_particle()
+   void ParticleManager::create_particles(size_t count, float first_delay, float dt, float interval)
    {
-      ++spawned_count;
+      spawn_indices.clear();
 
-      auto particle = std::make_shared<Particle>();
-      particle->particle.setSize(rand_v(size_min, size_max));
-      particle->particle.setOrigin(particle->particle.getSize() * .5f);
+      // Take free slots first, then recycle or drop the rest
+      const size_t old_count = particles.count();
+      const size_t limit = min(get_capacity(), get_lod_count());
+      const size_t free = limit > old_count ? limit - old_count : 0u;
+      const size_t pushed = min(count, free);
+      const size_t first = particles.push(pushed);
 
-      particle->particle.setScale(rand_v(scale_min, scale_max));
-      particle->particle.setRotation(rand_f(rotation_min, rotation_max));
-   
-      if (spawn_radius_min == 0.f && spawn_radius_max == 0.f)
-         particle->particle.setPosition(position);
-      else
+      for (size_t i = first; i < first + pushed; ++i)
+         spawn_indices.push_back(i);
+
+      if (count > pushed && overflow_policy == OverflowPolicy::recycle_oldest && old_count != 0u)
       {
-         const float angle  = rand_f(0.f, Constants<float>::two_pi);
-         const float radius = std::sqrt(rand_f(spawn_radius_min * spawn_radius_min, spawn_radius_max * spawn_radius_max));
-         const Vec2f offset (cos(angle) * radius, sin(angle) * radius);
-         particle->particle.setPosition(position + offset);
-      }
+         const size_t recycled = min(count - pushed, old_count);
+         const size_t start = spawn_indices.size();
 
-      particle->particle.setTexture(texture);
-      particle->particle.setFillColor(color_start);
+         for (size_t i = 0; i < old_count; ++i)
+            spawn_indices.push_back(i);
 
-      if (!texture_rect.empty())
-         particle->particle.setTextureRect(texture_rect);
+         auto oldest_first = [this](size_t a, size_t b)
+         {
+            return particles.age[a] / particles.lifetime[a] > particles.age[b] / particles.lifetime[b];
+         };
+
+         std::nth_element(spawn_indices.begin() + start, spawn_indices.begin() + start + recycled - 1u,
+                          spawn_indices.end(), oldest_first);
+         spawn_indices.resize(start + recycled);
+
+         for (size_t i = start; i < spawn_indices.size(); ++i)
+            particles.reset(spawn_indices[i]);
+
+         recycled_count += recycled;
+      }
+
+      dropped_count += count - spawn_indices.size();
+      spawned_count += spawn_indices.size();
+      high_water_mark = max(high_water_mark, particles.count());
+
+      // Initialize one property at a time over all new particles
+      spawn_column(particles.size, size_min, size_max);
+      spawn_column(particles.scale, scale_min, scale_max);
+      spawn_column(particles.rotation, rotation_min, rotation_max);
+      spawn_column(particles.acceleration, acceleration_min, acceleration_max);
+      spawn_column(particles.velocity, velocity_min, velocity_max);
+      spawn_column(particles.scale_velocity, scale_velocity_min, scale_velocity_max);
+      spawn_column(particles.rot_velocity, rot_velocity_min, rot_velocity_max);
+      for (size_t i : spawn_indices)
+         particles.rot_velocity_base[i] = particles.rot_velocity[i];
+      spawn_column(particles.friction, friction_min, friction_max);
+      spawn_column(particles.lifetime, lifetime_min, lifetime_max);
+
+      for (size_t i : spawn_indices)
+         particles.color[i] = color_start;
 
       if (pieces != 0u)
       {
-         const size_t index_x = randiu<size_t>(0, pieces - 1);
-         const size_t index_y = randiu<size_t>(0, pieces - 1);
+         for (size_t i : spawn_indices)
+         {
+            const size_t index_x = rng.randi<size_t>(0, pieces - 1);
+            const size_t index_y = rng.randi<size_t>(0, pieces - 1);
 
-         particle->particle.setTextureRect(Vec4i(piece_size.x * index_x, piece_size.y * index_y, piece_size.x, piece_size.y));
+            particles.texture_rect[i] = Vec4i(texture_rect.x + piece_size.x * index_x, texture_rect.y + piece_size.y * index_y,
+                                              piece_size.x, piece_size.y);
+         }
       }
+      else
+      {
+         Vec4i rect;
+
+         if (!texture_rect.empty())
+            rect = texture_rect;
+         else if (texture != nullptr)
+            rect = Vec4i(Vec2u(), Vec2u(texture->getSize()));
+
+         for (size_t i : spawn_indices)
+            particles.texture_rect[i] = rect;
+      }
+
+      // Spawn positions, interpolated along the emitter path within the frame
+      const bool spread = spawn_radius_min != 0.f || spawn_radius_max != 0.f;
+      if (spread)
+      {
+         spawn_vectors.resize(spawn_indices.size());
+         bulk_rng.fill_disk(spawn_vectors, Vec2f(), spawn_radius_min, spawn_radius_max);
+      }
+
+      for (size_t n = 0; n < spawn_indices.size(); ++n)
+      {
+         const size_t i = spawn_indices[n];
+         Vec2f origin = position;
+         float residual = 0.f;
+
+         if (dt > 0.f)
+         {
+            const float delay = min(first_delay + n * interval, dt);
+            origin = last_position.lerp(position, delay / dt);
+            residual = dt - delay;
+         }
 
-      particle->acceleration = rand_v(acceleration_min, acceleration_max);
-      particle->velocity = rand_v(velocity_min, velocity_max);
-      particle->scale_velocity = rand_v(scale_velocity_min, scale_velocity_max);
-      particle->rot_velocity = rand_f(rot_velocity_min, rot_velocity_max);
-      particle->friction = rand_f(friction_min, friction_max);
-      particle->lifetime = rand_f(lifetime_min, lifetime_max);
+         particles.position[i] = spread ? origin + spawn_vectors[n] : origin;
 
-      particles.push_back(std::move(particle));
+         // Advance by the part of the frame the particle already lived
+         particles.age[i] = residual;
+         particles.position[i] += particles.velocity[i] * residual;
+         particles.rotation[i] += particles.rot_velocity[i] * residual;
+         particles.scale[i] += particles.scale_velocity[i] * residual;
+      }
    }
 
-   float ParticleManager::rand_f(float min, float max)
+   void ParticleManager::reserve_pool()
    {
-      return (min == max ? min : randfu(min, max));
+      particles.reserve(get_capacity());
+      spawn_indices.reserve(get_capacity());
+      spawn_vectors.reserve(get_capacity());
+      spawn_floats.reserve(get_capacity());
    }
 
-   Vec2f ParticleManager::rand_v(const Vec2f& min, const Vec2f& max)
+   void ParticleManager::spawn_column(std::vector<float>& column, float min, float max)
    {
-      return (min != max ? Vec2f::random(min, max) : min);
+      if (min == max)
+      {
+         for (size_t i : spawn_indices)
+            column[i] = min;
+         return;
+      }
+
+      spawn_floats.resize(spawn_indices.size());
+      bulk_rng.fill(spawn_floats, min, max);
+
+      for (size_t n = 0; n < spawn_indices.size(); ++n)
+         column[spawn_indices[n]] = spawn_floats[n];
+   }
+
+   void ParticleManager::spawn_column(std::vector<Vec2f>& column, const Vec2f& min, const Vec2f& max)
+   {
+      if (min == max)
+      {
+         for (size_t i : spawn_indices)
+            column[i] = min;
+         return;
+      }
+
+      spawn_vectors.resize(spawn_indices.size());
+      bulk_rng.fill(spawn_vectors, min, max);
+
+      for (size_t n = 0; n < spawn_indices.size(); ++n)
+         column[spawn_indices[n]] = spawn_vectors[n];
    }
 }
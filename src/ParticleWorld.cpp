@@ -0,0 +1,247 @@
+#include "CX/ParticleWorld.hpp"
+
+#include "CX/Math/Random.hpp"
+#include <algorithm>
+
+namespace cx
+{
+   // Constructors
+
+   ParticleWorld::ParticleWorld(size_t thread_count)
+      : pool(thread_count) {}
+
+   // Emitter functions
+
+   ParticleManager& ParticleWorld::add_emitter()
+   {
+      return *emitters.emplace_back(std::make_unique<ParticleManager>());
+   }
+
+   ParticleManager& ParticleWorld::add_emitter(const ParticleManager& emitter)
+   {
+      ParticleManager& copy = *emitters.emplace_back(std::make_unique<ParticleManager>(emitter));
+
+      // A copied engine would spawn the same pattern as the original in lockstep
+      copy.set_seed((uint64_t(random_engine()()) << 32u) | random_engine()());
+      return copy;
+   }
+
+   void ParticleWorld::remove_emitter(const ParticleManager& emitter)
+   {
+      std::erase_if(emitters, [&emitter](const auto& owned) { return owned.get() == &emitter; });
+   }
+
+   void ParticleWorld::clear()
+   {
+      emitters.clear();
+      batch_count = 0u;
+   }
+
+   // Setter functions
+
+   void ParticleWorld::set_chunk_size(size_t chunk_size)
+   {
+      this->chunk_size = std::max(chunk_size, size_t(1));
+   }
+
+   // Getter functions
+
+   ParticleManager& ParticleWorld::get_emitter(size_t index)
+   {
+      return *emitters[index];
+   }
+
+   const ParticleManager& ParticleWorld::get_emitter(size_t index) const
+   {
+      return *emitters[index];
+   }
+
+   size_t ParticleWorld::emitter_count() const
+   {
+      return emitters.size();
+   }
+
+   size_t ParticleWorld::particle_count() const
+   {
+      size_t count = 0u;
+
+      for (const auto& emitter : emitters)
+         count += emitter->size();
+
+      return count;
+   }
+
+   size_t ParticleWorld::get_chunk_size() const
+   {
+      return chunk_size;
+   }
+
+   size_t ParticleWorld::get_batch_count() const
+   {
+      return batch_count;
+   }
+
+   const sf::VertexArray& ParticleWorld::get_vertices(size_t index) const
+   {
+      return batches[index].vertices;
+   }
+
+   // Update functions
+
+   void ParticleWorld::update(float dt)
+   {
+      // Lazy emitters off screen only keep time, the ones back on screen catch up before the shared step
+      updating.resize(emitters.size());
+      for (size_t i = 0; i < emitters.size(); ++i)
+         updating[i] = !emitters[i]->update_offscreen(dt);
+
+      build_jobs(false);
+      pool.parallel_for(jobs.size(), 1, [this, dt](size_t begin, size_t end)
+      {
+         for (size_t i = begin; i < end; ++i)
+            jobs[i].emitter->update_particles(dt, jobs[i].begin, jobs[i].end);
+      });
+
+      // Spawning uses random numbers, keep it in emitter order
+      for (size_t i = 0; i < emitters.size(); ++i)
+      {
+         if (!updating[i])
+            continue;
+
+         emitters[i]->particles.remove_dead();
+         emitters[i]->update_spawn(dt);
+      }
+
+      build_jobs(true);
+      pool.parallel_for(jobs.size(), 1, [this](size_t begin, size_t end)
+      {
+         for (size_t i = begin; i < end; ++i)
+            jobs[i].bounds = jobs[i].emitter->build_vertices(jobs[i].vertices, jobs[i].begin, jobs[i].end);
+      });
+
+      // Jobs of an emitter are consecutive
+      ParticleManager* last = nullptr;
+
+      for (const auto& job : jobs)
+      {
+         if (job.emitter != last)
+            job.emitter->bounds = job.bounds;
+         else
+            job.emitter->bounds = ParticleManager::merge_bounds(job.emitter->bounds, job.bounds);
+
+         last = job.emitter;
+      }
+   }
+
+   // Render functions
+
+   void ParticleWorld::render(sf::RenderWindow& window) const
+   {
+      render(window, nullptr);
+   }
+
+   void ParticleWorld::render(sf::RenderWindow& window, const sf::Shader* shader) const
+   {
+      sf::RenderStates states;
+      states.shader = shader;
+
+      for (size_t i = 0; i < batch_count; ++i)
+      {
+         if (batches[i].vertices.getVertexCount() == 0u)
+            continue;
+
+         states.texture = batches[i].texture;
+         window.draw(batches[i].vertices, states);
+      }
+   }
+
+   // Private functions
+
+   void ParticleWorld::build_jobs(bool with_vertices)
+   {
+      jobs.clear();
+
+      if (with_vertices)
+      {
+         // Group neighbouring visible emitters sharing a texture, keeping draw order.
+         // Batch sizes are counted first so jobs can point into them without reallocation.
+         batch_indices.resize(emitters.size());
+         batch_count = 0u;
+         const sf::Texture* last_texture = nullptr;
+
+         for (size_t i = 0; i < emitters.size(); ++i)
+         {
+            ParticleManager& emitter = *emitters[i];
+
+            // Checked against the bounds of the last frame, so particles drifting into view keep the emitter visible.
+            // Bounds are rebuilt by the jobs, culled emitters still build into their own vertices to keep them up to date.
+            const bool visible = emitter.is_visible();
+            emitter.bounds = Vec4f();
+
+            if (!visible)
+            {
+               batch_indices[i] = no_batch;
+               continue;
+            }
+
+            if (batch_count == 0u || emitter.get_texture() != last_texture)
+            {
+               if (batches.size() == batch_count)
+                  batches.emplace_back();
+
+               batches[batch_count].texture = emitter.get_texture();
+               batches[batch_count].count = 0u;
+               ++batch_count;
+            }
+
+            last_texture = emitter.get_texture();
+            batch_indices[i] = batch_count - 1u;
+            batches[batch_count - 1u].count += emitter.size();
+         }
+
+         for (size_t i = 0; i < batches.size(); ++i)
+            batches[i].vertices.resize(i < batch_count ? batches[i].count * 6u : 0u);
+
+         for (size_t i = 0; i < emitters.size(); ++i)
+         {
+            ParticleManager* emitter = emitters[i].get();
+            sf::Vertex* vertices = nullptr;
+
+            if (batch_indices[i] == no_batch)
+            {
+               emitter->vertices.resize(emitter->size() * 6u);
+               if (emitter->size() != 0u)
+                  vertices = &emitter->vertices[0];
+            }
+            else
+            {
+               Batch& batch = batches[batch_indices[i]];
+               if (emitter->size() != 0u)
+                  vertices = &batch.vertices[batch.offset * 6u];
+               batch.offset += emitter->size();
+            }
+
+            for (size_t begin = 0; begin < emitter->size(); begin += chunk_size)
+            {
+               const size_t end = std::min(begin + chunk_size, emitter->size());
+               jobs.push_back(Job {emitter, begin, end, vertices + begin * 6u, Vec4f()});
+            }
+         }
+
+         for (size_t i = 0; i < batch_count; ++i)
+            batches[i].offset = 0u;
+      }
+      else
+      {
+         for (size_t i = 0; i < emitters.size(); ++i)
+         {
+            if (!updating[i])
+               continue;
+
+            ParticleManager* emitter = emitters[i].get();
+            for (size_t begin = 0; begin < emitter->size(); begin += chunk_size)
+               jobs.push_back(Job {emitter, begin, std::min(begin + chunk_size, emitter->size()), nullptr, Vec4f()});
+         }
+      }
+   }
+}
@@ -1,6 +1,7 @@
 #include "CX/Plane/Plane.hpp"
 
 #include <SFML/Graphics/Texture.hpp>
+#include "CX/Render/RenderBatch.hpp"
 #include "CX/Vector/Vec3.hpp"
 
 namespace cx
@@ -49,6 +50,7 @@ namespace cx
 
    void Plane::create(const PlaneStyle& style)
    {
+      mark_changed();
       rect.setPrimitiveType(sf::PrimitiveType::Quads);
       rect.resize(4);
       this->size = style.size;
@@ -64,6 +66,7 @@ namespace cx
                       const Vec2f& position,
                       const Color& color)
    {
+      mark_changed();
       rect.setPrimitiveType(sf::PrimitiveType::Quads);
       rect.resize(4);
       this->size = size;
@@ -77,18 +80,21 @@ namespace cx
 
    void Plane::set_center(const Vec2f& center)
    {
+      mark_changed();
       this->center = center;
       redraw();
    }
 
    void Plane::set_scale(const Vec2f& scale)
    {
+      mark_changed();
       this->scale = scale.abs();
       redraw();
    }
 
    void Plane::set_size(const Vec2f& size)
    {
+      mark_changed();
       this->size = size;
       this->origin = (size * .5f).abs();
       redraw();
@@ -96,114 +102,143 @@ namespace cx
 
    void Plane::set_rotation(float angle)
    {
+      mark_changed();
       this->rotation.z = angle;
       redraw();
    }
 
    void Plane::set_3d_rotation(const Vec3f& angle)
    {
+      mark_changed();
       this->rotation = angle;
       redraw();
    }
 
    void Plane::set_3d_rotation(float angle_x, float angle_y, float angle_z)
    {
+      mark_changed();
       set_3d_rotation({angle_x, angle_y, angle_z});
    }
 
    void Plane::set_3d_rotation(float angle)
    {
+      mark_changed();
       set_3d_rotation({angle, angle, angle});
    }
 
    void Plane::set_3d_rotation_x(float angle)
    {
+      mark_changed();
       set_3d_rotation({angle, this->rotation.y, this->rotation.z});
    }
 
    void Plane::set_3d_rotation_y(float angle)
    {
+      mark_changed();
       set_3d_rotation({this->rotation.x, angle, this->rotation.z});
    }
 
    void Plane::set_3d_rotation_z(float angle)
    {
+      mark_changed();
       set_3d_rotation({this->rotation.x, this->rotation.y, angle});
    }
 
    void Plane::set_texture(const sf::Texture* texture)
    {
+      mark_changed();
       this->texture = texture;
       this->texture_rect = Vec4i(sf::Vector2u(), this->texture->getSize());
       bind_texture();
    }
 
+   void Plane::set_texture(const TextureRegion& region)
+   {
+      mark_changed();
+      this->texture = region.texture;
+      this->texture_rect = region.rect;
+      bind_texture();
+   }
+
    void Plane::set_texture_rect(const Vec4i& rect)
    {
+      mark_changed();
       this->texture_rect = rect;
       bind_texture();
    }
 
    void Plane::set_color(const Color& color)
    {
+      mark_changed();
       this->color = color;
       recolor();
    }
 
    void Plane::set_skew(const Vec2f& skew)
    {
+      mark_changed();
       this->skew = skew;
       redraw();
    }
 
    void Plane::set_skew(float skew_x, float skew_y)
    {
+      mark_changed();
       set_skew({skew_x, skew_y});
    }
 
    void Plane::set_skew(float skew)
    {
+      mark_changed();
       set_skew({skew, skew});
    }
 
    void Plane::set_skew_x(float skew)
    {
+      mark_changed();
       set_skew({skew, this->skew.y});
    }
 
    void Plane::set_skew_y(float skew)
    {
+      mark_changed();
       set_skew({this->skew.x, skew});
    }
 
    void Plane::set_3d_offset(const Vec3f& offset)
    {
+      mark_changed();
       this->offset = offset;
       redraw(); 
    }
 
    void Plane::set_3d_offset(float offset_x, float offset_y, float offset_z)
    {
+      mark_changed();
       set_3d_offset({offset_x, offset_y, offset_z});
    }
 
    void Plane::set_3d_offset(float offset)
    {
+      mark_changed();
       set_3d_offset({offset, offset, offset});
    }
 
    void Plane::set_3d_offset_x(float offset)
    {
+      mark_changed();
       set_3d_offset({offset, this->offset.y, this->offset.z});
    }
 
    void Plane::set_3d_offset_y(float offset)
    {
+      mark_changed();
       set_3d_offset({this->offset.x, offset, this->offset.z});
    }
 
    void Plane::set_3d_offset_z(float offset)
    {
+      mark_changed();
       set_3d_offset({this->offset.x, this->offset.y, offset});
    }
 
@@ -338,26 +373,31 @@ namespace cx
       rotate_3d({0.f, 0.f, angle});
    }
 
-   void Plane::render(sf::RenderWindow& window) const
+   void Plane::render(sf::RenderTarget& target) const
    {
       if (texture)
       {
          sf::RenderStates states;
          states.texture = texture;
-         window.draw(rect, states);
+         target.draw(rect, states);
       }
       else
-         window.draw(rect);
+         target.draw(rect);
    }
 
-   void Plane::render(sf::RenderWindow& window, const sf::Shader* shader) const
+   void Plane::render(sf::RenderTarget& target, const sf::Shader* shader) const
    {
       sf::RenderStates states;
       states.shader = shader;
       if (texture)
          states.texture = texture;
 
-      window.draw(rect, states);
+      target.draw(rect, states);
+   }
+
+   void Plane::submit(RenderBatch& batch, int layer) const
+   {
+      batch.submit(rect, texture, layer);
    }
 
    // Access functions
@@ -0,0 +1,98 @@
+#include "CX/Render/ProgressFill.hpp"
+
+#include "CX/Math/Constants.hpp"
+#include "CX/Vector/Vec2.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace cx
+{
+   namespace
+   {
+      /// @brief Create a vertex from a local point of the shape.
+      /// @param shape Shape.
+      /// @param point Local point.
+      /// @return Vertex in world coordinates.
+      sf::Vertex make_vertex(const Quad& shape, const Vec2f& point)
+      {
+         const Vec2f size = shape.getSize();
+         const sf::IntRect rect = shape.getTextureRect();
+         const float ratio_x = size.x != 0.f ? point.x / size.x : 0.f;
+         const float ratio_y = size.y != 0.f ? point.y / size.y : 0.f;
+
+         return sf::Vertex(shape.getTransform().transformPoint(point), shape.getFillColor(),
+                           Vec2f(rect.left + rect.width * ratio_x, rect.top + rect.height * ratio_y));
+      }
+
+      /// @brief Get where a ray from the center leaves the rectangle.
+      /// @param size Size of the rectangle.
+      /// @param angle Angle in radians, clockwise from up.
+      /// @return Local point on the edge.
+      Vec2f edge_point(const Vec2f& size, float angle)
+      {
+         const Vec2f half = size * .5f;
+         const Vec2f direction (std::sin(angle), -std::cos(angle));
+         const float scale_x = std::abs(direction.x) > 1e-6f ? half.x / std::abs(direction.x) : INFINITY;
+         const float scale_y = std::abs(direction.y) > 1e-6f ? half.y / std::abs(direction.y) : INFINITY;
+
+         return half + direction * std::min(scale_x, scale_y);
+      }
+   }
+
+   size_t build_progress_fill(const Quad& shape, float progress, FillMode mode, sf::Vertex* out)
+   {
+      progress = std::clamp(progress, 0.f, 1.f);
+      const Vec2f size = shape.getSize();
+
+      if (progress <= 0.f || size.x <= 0.f || size.y <= 0.f)
+         return 0u;
+
+      if (mode != FillMode::radial)
+      {
+         Vec2f low, high = size;
+
+         switch (mode)
+         {
+         case FillMode::left_to_right: high.x = size.x * progress;         break;
+         case FillMode::right_to_left: low.x = size.x * (1.f - progress);  break;
+         case FillMode::top_to_bottom: high.y = size.y * progress;         break;
+         case FillMode::bottom_to_top: low.y = size.y * (1.f - progress);  break;
+         default: break;
+         }
+
+         const sf::Vertex top_left = make_vertex(shape, low);
+         const sf::Vertex bottom_right = make_vertex(shape, high);
+         const sf::Vertex top_right = make_vertex(shape, Vec2f(high.x, low.y));
+         const sf::Vertex bottom_left = make_vertex(shape, Vec2f(low.x, high.y));
+
+         out[0] = top_left;    out[1] = top_right;    out[2] = bottom_right;
+         out[3] = top_left;    out[4] = bottom_right; out[5] = bottom_left;
+         return 6u;
+      }
+
+      // Fan from the center through every corner the sweep passes
+      const float end = progress * Constants<float>::two_pi;
+      const float corner = std::atan2(size.x, size.y);
+      const float corners[4] {corner, Constants<float>::pi - corner, Constants<float>::pi + corner,
+                              Constants<float>::two_pi - corner};
+
+      const sf::Vertex center = make_vertex(shape, size * .5f);
+      sf::Vertex previous = make_vertex(shape, Vec2f(size.x * .5f, 0.f));
+      size_t count = 0u;
+
+      for (float angle : corners)
+      {
+         if (angle >= end)
+            break;
+
+         const sf::Vertex next = make_vertex(shape, edge_point(size, angle));
+         out[count++] = center; out[count++] = previous; out[count++] = next;
+         previous = next;
+      }
+
+      out[count++] = center;
+      out[count++] = previous;
+      out[count++] = make_vertex(shape, progress >= 1.f ? Vec2f(size.x * .5f, 0.f) : edge_point(size, end));
+      return count;
+   }
+}
@@ -0,0 +1,199 @@
+#include "CX/Render/Quad.hpp"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+
+namespace cx
+{
+   // Constructors
+
+   Quad::Quad(const sf::Vector2f& size)
+      : size(size) {}
+
+   // Setter functions
+
+   void Quad::setSize(const sf::Vector2f& size)
+   {
+      this->size = size;
+      dirty = true;
+   }
+
+   void Quad::setTexture(const sf::Texture* texture, bool resetRect)
+   {
+      // Same as sf::Shape, the first texture without a rect shows whole
+      if (texture && (resetRect || (!this->texture && texture_rect == sf::IntRect())))
+         setTextureRect(sf::IntRect(0, 0, int(texture->getSize().x), int(texture->getSize().y)));
+
+      this->texture = texture;
+   }
+
+   void Quad::setTextureRect(const sf::IntRect& rect)
+   {
+      texture_rect = rect;
+      dirty = true;
+   }
+
+   void Quad::setFillColor(const sf::Color& color)
+   {
+      fill_color = color;
+      dirty = true;
+   }
+
+   void Quad::setOutlineColor(const sf::Color& color)
+   {
+      outline_color = color;
+      dirty = true;
+   }
+
+   void Quad::setOutlineThickness(float thickness)
+   {
+      outline_thickness = thickness;
+      dirty = true;
+   }
+
+   // Getter functions
+
+   const sf::Vector2f& Quad::getSize() const
+   {
+      return size;
+   }
+
+   const sf::Texture* Quad::getTexture() const
+   {
+      return texture;
+   }
+
+   const sf::IntRect& Quad::getTextureRect() const
+   {
+      return texture_rect;
+   }
+
+   const sf::Color& Quad::getFillColor() const
+   {
+      return fill_color;
+   }
+
+   const sf::Color& Quad::getOutlineColor() const
+   {
+      return outline_color;
+   }
+
+   float Quad::getOutlineThickness() const
+   {
+      return outline_thickness;
+   }
+
+   size_t Quad::getPointCount() const
+   {
+      return 4u;
+   }
+
+   sf::Vector2f Quad::getPoint(size_t index) const
+   {
+      switch (index)
+      {
+      default:
+      case 0: return sf::Vector2f(0.f, 0.f);
+      case 1: return sf::Vector2f(size.x, 0.f);
+      case 2: return sf::Vector2f(size.x, size.y);
+      case 3: return sf::Vector2f(0.f, size.y);
+      }
+   }
+
+   sf::FloatRect Quad::getLocalBounds() const
+   {
+      const float grow = std::max(outline_thickness, 0.f);
+      return sf::FloatRect(-grow, -grow, size.x + grow * 2.f, size.y + grow * 2.f);
+   }
+
+   sf::FloatRect Quad::getGlobalBounds() const
+   {
+      return getTransform().transformRect(getLocalBounds());
+   }
+
+   // Vertex functions
+
+   void Quad::getFillTriangles(sf::Vertex* out) const
+   {
+      update();
+      const sf::Transform& transform = getTransform();
+
+      // Strip order is top left, top right, bottom left, bottom right
+      constexpr size_t order[6] {0u, 1u, 3u, 0u, 3u, 2u};
+      for (size_t i = 0; i < fill_vertex_count; ++i)
+      {
+         out[i] = fill[order[i]];
+         out[i].position = transform.transformPoint(out[i].position);
+      }
+   }
+
+   size_t Quad::getOutlineTriangles(sf::Vertex* out) const
+   {
+      if (outline_thickness == 0.f)
+         return 0u;
+
+      update();
+      const sf::Transform& transform = getTransform();
+
+      for (size_t i = 0; i < 8u; ++i)
+      {
+         out[i * 3u] = outline[i];
+         out[i * 3u + 1u] = outline[i + 1u];
+         out[i * 3u + 2u] = outline[i + 2u];
+
+         for (size_t v = i * 3u; v < i * 3u + 3u; ++v)
+            out[v].position = transform.transformPoint(out[v].position);
+      }
+
+      return outline_vertex_count;
+   }
+
+   // Private functions
+
+   void Quad::update() const
+   {
+      if (!dirty)
+         return;
+
+      const float left = float(texture_rect.left);
+      const float top = float(texture_rect.top);
+      const float right = left + float(texture_rect.width);
+      const float bottom = top + float(texture_rect.height);
+
+      fill[0] = sf::Vertex(sf::Vector2f(0.f, 0.f), fill_color, sf::Vector2f(left, top));
+      fill[1] = sf::Vertex(sf::Vector2f(size.x, 0.f), fill_color, sf::Vector2f(right, top));
+      fill[2] = sf::Vertex(sf::Vector2f(0.f, size.y), fill_color, sf::Vector2f(left, bottom));
+      fill[3] = sf::Vertex(sf::Vector2f(size.x, size.y), fill_color, sf::Vector2f(right, bottom));
+
+      // Ring of inner and outer corners, closed by repeating the first pair
+      const float t = outline_thickness;
+      const sf::Vector2f outer[4] {
+         sf::Vector2f(-t, -t), sf::Vector2f(size.x + t, -t),
+         sf::Vector2f(size.x + t, size.y + t), sf::Vector2f(-t, size.y + t)
+      };
+
+      for (size_t i = 0; i < 5u; ++i)
+      {
+         const size_t corner = i % 4u;
+         outline[i * 2u] = sf::Vertex(getPoint(corner), outline_color);
+         outline[i * 2u + 1u] = sf::Vertex(outer[corner], outline_color);
+      }
+
+      dirty = false;
+   }
+
+   void Quad::draw(sf::RenderTarget& target, sf::RenderStates states) const
+   {
+      update();
+      states.transform *= getTransform();
+      states.texture = texture;
+      target.draw(fill, 4u, sf::TriangleStrip, states);
+
+      if (outline_thickness != 0.f)
+      {
+         states.texture = nullptr;
+         target.draw(outline, 10u, sf::TriangleStrip, states);
+      }
+   }
+}
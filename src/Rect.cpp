@@ -1,5 +1,7 @@
 #include "CX/Rect/Rect.hpp"
 
+#include "CX/Render/RenderBatch.hpp"
+
 namespace cx
 {
    // Set default styles
@@ -34,6 +36,7 @@ namespace cx
 
    void Rect::create(const RectStyle& style)
    {
+      mark_changed();
       rect.setSize(style.size);
       rect.setOrigin(style.size * .5f);
       rect.setFillColor(style.color);
@@ -44,6 +47,7 @@ namespace cx
                      const Vec2f& position,
                      const Color& color)
    {
+      mark_changed();
       rect.setPosition(position);
       rect.setSize(size);
       rect.setOrigin(size * .5f);
@@ -54,37 +58,51 @@ namespace cx
 
    void Rect::set_center(const Vec2f& position)
    {
+      mark_changed();
       rect.setPosition(position);
    }
 
    void Rect::set_scale(const Vec2f& scale)
    {
+      mark_changed();
       rect.setScale(scale);
    }
 
    void Rect::set_size(const Vec2f& size)
    {
+      mark_changed();
       rect.setSize(size);
       rect.setOrigin(size * .5f);
    }
 
    void Rect::set_rotation(float angle)
    {
+      mark_changed();
       rect.setRotation(angle);
    }
 
    void Rect::set_texture(const sf::Texture* texture)
    {
+      mark_changed();
       rect.setTexture(texture);
    }
 
+   void Rect::set_texture(const TextureRegion& region)
+   {
+      mark_changed();
+      rect.setTexture(region.texture);
+      rect.setTextureRect(region.rect);
+   }
+
    void Rect::set_texture_rect(const Vec4i& rect_)
    {
+      mark_changed();
       rect.setTextureRect(rect_);
    }
 
    void Rect::set_color(const Color& color)
    {
+      mark_changed();
       rect.setFillColor(color);
    }
 
@@ -144,19 +162,24 @@ namespace cx
 
    // Render functions
 
-   void Rect::render(sf::RenderWindow& window) const
+   void Rect::render(sf::RenderTarget& target) const
+   {
+      target.draw(rect);
+   }
+
+   void Rect::render(sf::RenderTarget& target, const sf::Shader* shader) const
    {
-      window.draw(rect);
+      target.draw(rect, shader);
    }
 
-   void Rect::render(sf::RenderWindow& window, const sf::Shader* shader) const
+   void Rect::submit(RenderBatch& batch, int layer) const
    {
-      window.draw(rect, shader);
+      batch.submit(rect, layer);
    }
 
    // Access functions
 
-   sf::RectangleShape& Rect::get_rectangle()
+   Quad& Rect::get_rectangle()
    {
       return rect;
    }
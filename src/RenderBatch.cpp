@@ -0,0 +1,436 @@
+#include "CX/Render/RenderBatch.hpp"
+
+#include "CX/Text/GlyphRun.hpp"
+#include "CX/UIElement/UIElement.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace cx
+{
+   namespace
+   {
+      constexpr float no_bound = std::numeric_limits<float>::max();
+
+      /// @brief Get area of bounds.
+      float area(const Vec2f& low, const Vec2f& high)
+      {
+         return std::max(high.x - low.x, 0.f) * std::max(high.y - low.y, 0.f);
+      }
+   }
+
+   // Submit functions
+
+   void RenderBatch::submit(const UIElement& element, int layer)
+   {
+      element.submit(*this, layer);
+   }
+
+   void RenderBatch::submit(const sf::Shape& shape, int layer, const sf::Shader* shader)
+   {
+      const size_t count = shape.getPointCount();
+      if (count < 3u)
+         return;
+
+      ++submissions;
+      const sf::Transform& transform = shape.getTransform();
+
+      // Texture coordinates span the bounds of the points
+      Vec2f low = shape.getPoint(0);
+      Vec2f high = low;
+
+      for (size_t i = 1; i < count; ++i)
+      {
+         const Vec2f point = shape.getPoint(i);
+         low = Vec2f(std::min(low.x, point.x), std::min(low.y, point.y));
+         high = Vec2f(std::max(high.x, point.x), std::max(high.y, point.y));
+      }
+
+      const Vec2f size = high - low;
+      const sf::IntRect rect = shape.getTextureRect();
+
+      auto fill_vertex = [&](size_t index)
+      {
+         const Vec2f point = shape.getPoint(index);
+         const float ratio_x = size.x > 0.f ? (point.x - low.x) / size.x : 0.f;
+         const float ratio_y = size.y > 0.f ? (point.y - low.y) / size.y : 0.f;
+         const Vec2f tex_coords (rect.left + rect.width * ratio_x, rect.top + rect.height * ratio_y);
+
+         return sf::Vertex(transform.transformPoint(point), shape.getFillColor(), tex_coords);
+      };
+
+      // Fill, as a fan of the convex shape
+      if (shape.getFillColor().a != 0u)
+      {
+         begin_geometry(shape.getTexture(), layer, shader);
+         const sf::Vertex first = fill_vertex(0);
+
+         for (size_t i = 1; i + 1u < count; ++i)
+            add_triangle(first, fill_vertex(i), fill_vertex(i + 1u));
+      }
+
+      // Outline, never textured
+      const float thickness = shape.getOutlineThickness();
+      if (thickness == 0.f || shape.getOutlineColor().a == 0u)
+         return;
+
+      const Vec2f center = (low + high) * .5f;
+      auto normal = [&center](const Vec2f& from, const Vec2f& to)
+      {
+         Vec2f result (from.y - to.y, to.x - from.x);
+         const float length = std::sqrt(result.x * result.x + result.y * result.y);
+         if (length != 0.f)
+            result /= length;
+
+         // Point away from the center
+         if (result.x * (center.x - to.x) + result.y * (center.y - to.y) > 0.f)
+            result = -result;
+
+         return result;
+      };
+
+      auto outline_vertices = [&](size_t index)
+      {
+         const Vec2f previous = shape.getPoint(index == 0u ? count - 1u : index - 1u);
+         const Vec2f point = shape.getPoint(index);
+         const Vec2f next = shape.getPoint(index + 1u == count ? 0u : index + 1u);
+
+         const Vec2f first = normal(previous, point);
+         const Vec2f second = normal(point, next);
+         const float factor = 1.f + (first.x * second.x + first.y * second.y);
+         const Vec2f offset = (first + second) / factor * thickness;
+
+         return std::pair<sf::Vertex, sf::Vertex> {
+            sf::Vertex(transform.transformPoint(point), shape.getOutlineColor()),
+            sf::Vertex(transform.transformPoint(point + offset), shape.getOutlineColor())
+         };
+      };
+
+      begin_geometry(nullptr, layer, shader);
+      const auto start = outline_vertices(0);
+      auto current = start;
+
+      for (size_t i = 0; i < count; ++i)
+      {
+         const auto next = i + 1u == count ? start : outline_vertices(i + 1u);
+         add_triangle(current.first, current.second, next.second);
+         add_triangle(current.first, next.second, next.first);
+         current = next;
+      }
+   }
+
+   void RenderBatch::submit(const Quad& quad, int layer, const sf::Shader* shader)
+   {
+      ++submissions;
+      sf::Vertex triangles[Quad::outline_vertex_count];
+
+      if (quad.getFillColor().a != 0u)
+      {
+         begin_geometry(quad.getTexture(), layer, shader);
+         quad.getFillTriangles(triangles);
+         add_triangle(triangles[0], triangles[1], triangles[2]);
+         add_triangle(triangles[3], triangles[4], triangles[5]);
+      }
+
+      // Outline, never textured
+      if (quad.getOutlineColor().a == 0u)
+         return;
+
+      const size_t count = quad.getOutlineTriangles(triangles);
+      if (count == 0u)
+         return;
+
+      begin_geometry(nullptr, layer, shader);
+      for (size_t i = 0; i < count; i += 3u)
+         add_triangle(triangles[i], triangles[i + 1u], triangles[i + 2u]);
+   }
+
+   void RenderBatch::submit(const sf::Text& text, GlyphRun& glyphs, int layer, const sf::Shader* shader)
+   {
+      glyphs.update(text);
+
+      const std::vector<sf::Vertex>& quads = glyphs.get_vertices();
+      if (quads.empty())
+         return;
+
+      ++submissions;
+      const sf::Transform& transform = text.getTransform();
+      begin_geometry(glyphs.get_texture(), layer, shader);
+
+      for (size_t i = 0; i + 2u < quads.size(); i += 3u)
+      {
+         sf::Vertex a = quads[i];
+         sf::Vertex b = quads[i + 1u];
+         sf::Vertex c = quads[i + 2u];
+         a.position = transform.transformPoint(a.position);
+         b.position = transform.transformPoint(b.position);
+         c.position = transform.transformPoint(c.position);
+         add_triangle(a, b, c);
+      }
+   }
+
+   void RenderBatch::submit(const sf::VertexArray& vertices, const sf::Texture* texture,
+                            int layer, const sf::Shader* shader)
+   {
+      const size_t count = vertices.getVertexCount();
+
+      switch (vertices.getPrimitiveType())
+      {
+      case sf::Triangles:
+         ++submissions;
+         begin_geometry(texture, layer, shader);
+         for (size_t i = 0; i + 2u < count; i += 3u)
+            add_triangle(vertices[i], vertices[i + 1u], vertices[i + 2u]);
+         break;
+
+      case sf::TriangleStrip:
+         ++submissions;
+         begin_geometry(texture, layer, shader);
+         for (size_t i = 0; i + 2u < count; ++i)
+            add_triangle(vertices[i], vertices[i + 1u], vertices[i + 2u]);
+         break;
+
+      case sf::TriangleFan:
+         ++submissions;
+         begin_geometry(texture, layer, shader);
+         for (size_t i = 1; i + 1u < count; ++i)
+            add_triangle(vertices[0], vertices[i], vertices[i + 1u]);
+         break;
+
+      case sf::Quads:
+         ++submissions;
+         begin_geometry(texture, layer, shader);
+         for (size_t i = 0; i + 3u < count; i += 4u)
+         {
+            add_triangle(vertices[i], vertices[i + 1u], vertices[i + 2u]);
+            add_triangle(vertices[i], vertices[i + 2u], vertices[i + 3u]);
+         }
+         break;
+
+      default:
+      {
+         sf::RenderStates states;
+         states.texture = texture;
+         states.shader = shader;
+         submit(vertices, layer, states);
+         break;
+      }
+      }
+   }
+
+   void RenderBatch::submit(const sf::Vertex* triangles, size_t count, const sf::Texture* texture,
+                            int layer, const sf::Shader* shader)
+   {
+      ++submissions;
+      begin_geometry(texture, layer, shader);
+
+      for (size_t i = 0; i + 2u < count; i += 3u)
+         add_triangle(triangles[i], triangles[i + 1u], triangles[i + 2u]);
+   }
+
+   void RenderBatch::submit(const sf::Drawable& drawable, int layer, const sf::RenderStates& states)
+   {
+      ++submissions;
+      commands.push_back(Command {layer, states.shader, states.texture, commands.size(),
+                                  0u, 0u, &drawable, states, Vec2f(no_bound), Vec2f(-no_bound), 0u});
+   }
+
+   // Render functions
+
+   void RenderBatch::flush(sf::RenderTarget& target)
+   {
+      stats = RenderStats();
+      stats.submissions = submissions;
+
+      std::sort(commands.begin(), commands.end(), [](const Command& a, const Command& b)
+      {
+         if (a.layer != b.layer)
+            return a.layer < b.layer;
+         return a.order < b.order;
+      });
+
+      // Groups are created in draw order, inside a group submissions keep their order
+      group_commands();
+      std::sort(commands.begin(), commands.end(), [](const Command& a, const Command& b)
+      {
+         if (a.group != b.group)
+            return a.group < b.group;
+         return a.order < b.order;
+      });
+
+      for (size_t i = 0; i < commands.size(); )
+      {
+         const Command& command = commands[i];
+
+         if (command.drawable != nullptr)
+         {
+            target.draw(*command.drawable, command.states);
+            ++stats.draw_calls;
+            ++i;
+            continue;
+         }
+
+         // Merge the rest of the group
+         size_t last = i + 1u;
+         while (last < commands.size() && commands[last].group == command.group)
+            ++last;
+
+         const sf::Vertex* data = vertices.data() + command.first;
+         size_t count = command.count;
+
+         if (last - i > 1u)
+         {
+            merged.clear();
+            for (size_t j = i; j < last; ++j)
+               merged.insert(merged.end(), vertices.begin() + commands[j].first,
+                             vertices.begin() + commands[j].first + commands[j].count);
+
+            data = merged.data();
+            count = merged.size();
+         }
+
+         if (count != 0u)
+         {
+            sf::RenderStates states;
+            states.texture = command.texture;
+            states.shader = command.shader;
+
+            target.draw(data, count, sf::Triangles, states);
+            ++stats.draw_calls;
+            stats.vertices += count;
+         }
+
+         i = last;
+      }
+
+      clear();
+   }
+
+   void RenderBatch::clear()
+   {
+      commands.clear();
+      vertices.clear();
+      submissions = 0u;
+   }
+
+   // Getter functions
+
+   size_t RenderBatch::size() const
+   {
+      return submissions;
+   }
+
+   const RenderStats& RenderBatch::get_stats() const
+   {
+      return stats;
+   }
+
+   // Private functions
+
+   void RenderBatch::begin_geometry(const sf::Texture* texture, int layer, const sf::Shader* shader)
+   {
+      if (!commands.empty())
+      {
+         const Command& last = commands.back();
+
+         if (last.drawable == nullptr && last.layer == layer && last.shader == shader && last.texture == texture)
+            return;
+      }
+
+      commands.push_back(Command {layer, shader, texture, commands.size(),
+                                  vertices.size(), 0u, nullptr, sf::RenderStates(), Vec2f(no_bound), Vec2f(-no_bound), 0u});
+   }
+
+   void RenderBatch::add_triangle(const sf::Vertex& a, const sf::Vertex& b, const sf::Vertex& c)
+   {
+      vertices.push_back(a);
+      vertices.push_back(b);
+      vertices.push_back(c);
+
+      Command& command = commands.back();
+      command.count += 3u;
+
+      for (const sf::Vertex* vertex : {&a, &b, &c})
+      {
+         command.low = Vec2f(std::min(command.low.x, vertex->position.x), std::min(command.low.y, vertex->position.y));
+         command.high = Vec2f(std::max(command.high.x, vertex->position.x), std::max(command.high.y, vertex->position.y));
+      }
+   }
+
+   void RenderBatch::group_commands()
+   {
+      groups.clear();
+      bounds.clear();
+
+      for (Command& command : commands)
+      {
+         size_t target = groups.size();
+
+         // Walk back until a group with the same state, or one the command overlaps and has to stay above
+         if (command.drawable == nullptr)
+         {
+            for (size_t i = groups.size(); i > 0u && groups.size() - i < max_lookback; --i)
+            {
+               const Group& group = groups[i - 1u];
+
+               if (group.layer != command.layer || group.drawable)
+                  break;
+
+               if (group.shader == command.shader && group.texture == command.texture)
+               {
+                  target = i - 1u;
+                  break;
+               }
+
+               if (overlaps(group, command))
+                  break;
+            }
+         }
+
+         if (target == groups.size())
+            groups.push_back(Group {command.layer, command.shader, command.texture, command.drawable != nullptr, no_bounds});
+
+         add_bounds(groups[target], command);
+         command.group = target;
+      }
+   }
+
+   bool RenderBatch::overlaps(const Group& group, const Command& command) const
+   {
+      for (size_t i = group.last_bounds; i != no_bounds; i = bounds[i].previous)
+      {
+         const Bounds& other = bounds[i];
+
+         // Touching edges do not overlap
+         if (other.low.x < command.high.x && command.low.x < other.high.x &&
+             other.low.y < command.high.y && command.low.y < other.high.y)
+            return true;
+      }
+
+      return false;
+   }
+
+   void RenderBatch::add_bounds(Group& group, const Command& command)
+   {
+      if (command.low.x > command.high.x)
+         return;
+
+      // Neighbours like a row of buttons share bounds, distant ones get their own to not hide free space
+      if (group.last_bounds != no_bounds)
+      {
+         Bounds& last = bounds[group.last_bounds];
+         const Vec2f low (std::min(last.low.x, command.low.x), std::min(last.low.y, command.low.y));
+         const Vec2f high (std::max(last.high.x, command.high.x), std::max(last.high.y, command.high.y));
+
+         if (area(low, high) <= 2.f * (area(last.low, last.high) + area(command.low, command.high)))
+         {
+            last.low = low;
+            last.high = high;
+            return;
+         }
+      }
+
+      bounds.push_back(Bounds {command.low, command.high, group.last_bounds});
+      group.last_bounds = bounds.size() - 1u;
+   }
+}
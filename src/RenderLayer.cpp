@@ -0,0 +1,295 @@
+#include "CX/Render/RenderLayer.hpp"
+
+#include <SFML/Graphics/RectangleShape.hpp>
+#include "CX/UIElement/UIElement.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace cx
+{
+   namespace
+   {
+      /// @brief Get the smallest rectangle containing two rectangles.
+      /// @param a First rectangle.
+      /// @param b Second rectangle.
+      /// @return Union.
+      Vec4f merge_rects(const Vec4f& a, const Vec4f& b)
+      {
+         const float left = std::min(a.x, b.x);
+         const float top = std::min(a.y, b.y);
+         return Vec4f(left, top, std::max(a.x + a.w, b.x + b.w) - left, std::max(a.y + a.h, b.y + b.h) - top);
+      }
+
+      /// @brief Get the overlap of two rectangles.
+      /// @param a First rectangle.
+      /// @param b Second rectangle.
+      /// @return Intersection, empty if they do not overlap.
+      Vec4f intersect_rects(const Vec4f& a, const Vec4f& b)
+      {
+         const float left = std::max(a.x, b.x);
+         const float top = std::max(a.y, b.y);
+         const float right = std::min(a.x + a.w, b.x + b.w);
+         const float bottom = std::min(a.y + a.h, b.y + b.h);
+
+         if (right <= left || bottom <= top)
+            return Vec4f();
+
+         return Vec4f(left, top, right - left, bottom - top);
+      }
+   }
+
+   // Snapshot
+
+   bool RenderLayer::Snapshot::operator==(const Snapshot& other) const
+   {
+      return bounds.x == other.bounds.x && bounds.y == other.bounds.y && bounds.w == other.bounds.w &&
+             bounds.h == other.bounds.h && color == other.color && revision == other.revision &&
+             hovering == other.hovering && mouse_down == other.mouse_down;
+   }
+
+   // Constructors
+
+   RenderLayer::RenderLayer(const Vec4f& area)
+   {
+      create(area);
+   }
+
+   // Constructors after creation
+
+   void RenderLayer::create(const Vec4f& area)
+   {
+      this->area = area;
+      texture.create(unsigned(std::ceil(std::max(area.w, 1.f))), unsigned(std::ceil(std::max(area.h, 1.f))));
+      full_redraw = true;
+   }
+
+   // Member functions
+
+   void RenderLayer::add(const UIElement& element, int layer)
+   {
+      members.push_back(Member {&element, layer, take_snapshot(element)});
+      add_dirty(members.back().snapshot.bounds);
+   }
+
+   void RenderLayer::remove(const UIElement& element)
+   {
+      const auto found = std::find_if(members.begin(), members.end(), [&element](const Member& member)
+      {
+         return member.element == &element;
+      });
+
+      if (found == members.end())
+         return;
+
+      add_dirty(found->snapshot.bounds);
+      members.erase(found);
+   }
+
+   void RenderLayer::clear()
+   {
+      members.clear();
+      dirty.clear();
+      full_redraw = true;
+   }
+
+   void RenderLayer::mark_dirty()
+   {
+      full_redraw = true;
+   }
+
+   void RenderLayer::mark_dirty(const UIElement& element)
+   {
+      for (auto& member : members)
+      {
+         if (member.element != &element)
+            continue;
+
+         add_dirty(member.snapshot.bounds);
+         member.snapshot = take_snapshot(element);
+         add_dirty(member.snapshot.bounds);
+      }
+   }
+
+   // Setter functions
+
+   void RenderLayer::set_clear_color(const Color& color)
+   {
+      clear_color = color;
+      full_redraw = true;
+   }
+
+   void RenderLayer::set_margin(float margin)
+   {
+      this->margin = margin;
+   }
+
+   // Getter functions
+
+   const Vec4f& RenderLayer::get_area() const
+   {
+      return area;
+   }
+
+   size_t RenderLayer::size() const
+   {
+      return members.size();
+   }
+
+   const sf::Texture& RenderLayer::get_texture() const
+   {
+      return texture.getTexture();
+   }
+
+   size_t RenderLayer::get_redraw_count() const
+   {
+      return redraw_count;
+   }
+
+   // Update functions
+
+   void RenderLayer::update()
+   {
+      for (auto& member : members)
+      {
+         const Snapshot snapshot = take_snapshot(*member.element);
+         if (snapshot == member.snapshot)
+            continue;
+
+         // Both where it was and where it is now
+         add_dirty(member.snapshot.bounds);
+         add_dirty(snapshot.bounds);
+         member.snapshot = snapshot;
+      }
+
+      // Many small redraws cost more than one big one
+      float dirty_area = 0.f;
+      for (const auto& region : dirty)
+         dirty_area += region.w * region.h;
+
+      if (full_redraw || dirty_area > area.w * area.h * .5f)
+      {
+         dirty.assign(1u, area);
+         full_redraw = false;
+      }
+
+      redraw_count = 0u;
+      for (const auto& region : dirty)
+      {
+         const Vec4f clipped = intersect_rects(region, area);
+         if (clipped.w <= 0.f || clipped.h <= 0.f)
+            continue;
+
+         redraw(clipped);
+         ++redraw_count;
+      }
+
+      if (redraw_count != 0u)
+         texture.display();
+
+      dirty.clear();
+   }
+
+   // Render functions
+
+   void RenderLayer::render(sf::RenderWindow& window) const
+   {
+      render(window, nullptr);
+   }
+
+   void RenderLayer::render(sf::RenderWindow& window, const sf::Shader* shader) const
+   {
+      sf::Vertex vertices[6];
+      build_quad(vertices);
+
+      sf::RenderStates states;
+      states.texture = &texture.getTexture();
+      states.shader = shader;
+      window.draw(vertices, 6u, sf::Triangles, states);
+   }
+
+   void RenderLayer::submit(RenderBatch& batch, int layer) const
+   {
+      sf::Vertex vertices[6];
+      build_quad(vertices);
+      batch.submit(vertices, 6u, &texture.getTexture(), layer);
+   }
+
+   // Private functions
+
+   RenderLayer::Snapshot RenderLayer::take_snapshot(const UIElement& element) const
+   {
+      Vec4f bounds = element.get_simple_bounds();
+
+      // Rotated elements can reach as far as their half diagonal from the center
+      if (std::fmod(element.get_rotation().degrees(), 360.f) != 0.f)
+      {
+         const Vec2f center = element.get_center();
+         const float radius = std::sqrt(bounds.w * bounds.w + bounds.h * bounds.h) * .5f;
+         bounds = Vec4f(center.x - radius, center.y - radius, radius * 2.f, radius * 2.f);
+      }
+
+      bounds = Vec4f(bounds.x - margin, bounds.y - margin, bounds.w + margin * 2.f, bounds.h + margin * 2.f);
+      return Snapshot {bounds, element.get_color(), element.get_revision(), element.is_hovering(), element.is_mouse_down()};
+   }
+
+   void RenderLayer::add_dirty(const Vec4f& region)
+   {
+      Vec4f merged = region;
+
+      // Keep regions disjoint so nothing is drawn twice
+      for (size_t i = 0; i < dirty.size(); )
+      {
+         if (dirty[i].colliding(merged))
+         {
+            merged = merge_rects(merged, dirty[i]);
+            dirty.erase(dirty.begin() + i);
+            i = 0u;
+         }
+         else
+            ++i;
+      }
+
+      dirty.push_back(merged);
+   }
+
+   void RenderLayer::redraw(const Vec4f& region)
+   {
+      // Snap to whole texture pixels
+      const float left = std::floor(region.x - area.x);
+      const float top = std::floor(region.y - area.y);
+      const float right = std::ceil(region.x + region.w - area.x);
+      const float bottom = std::ceil(region.y + region.h - area.y);
+      const Vec4f pixels (left, top, right - left, bottom - top);
+      const Vec4f world (area.x + left, area.y + top, pixels.w, pixels.h);
+
+      const sf::Vector2u size = texture.getSize();
+      sf::View view (sf::FloatRect(world.x, world.y, world.w, world.h));
+      view.setViewport(sf::FloatRect(pixels.x / size.x, pixels.y / size.y, pixels.w / size.x, pixels.h / size.y));
+      texture.setView(view);
+
+      sf::RectangleShape clear (Vec2f(world.w, world.h));
+      clear.setPosition(world.x, world.y);
+      clear.setFillColor(clear_color);
+      texture.draw(clear, sf::BlendNone);
+
+      for (const auto& member : members)
+      {
+         if (member.snapshot.bounds.colliding(world))
+            member.element->submit(batch, member.layer);
+      }
+
+      batch.flush(texture);
+   }
+
+   void RenderLayer::build_quad(sf::Vertex* vertices) const
+   {
+      const sf::Vector2u size = texture.getSize();
+      const sf::Vertex top_left (Vec2f(area.x, area.y), Vec2f(0.f, 0.f));
+      const sf::Vertex top_right (Vec2f(area.x + size.x, area.y), Vec2f(float(size.x), 0.f));
+      const sf::Vertex bottom_right (Vec2f(area.x + size.x, area.y + size.y), Vec2f(float(size.x), float(size.y)));
+      const sf::Vertex bottom_left (Vec2f(area.x, area.y + size.y), Vec2f(0.f, float(size.y)));
+
+      vertices[0] = top_left; vertices[1] = top_right;    vertices[2] = bottom_right;
+      vertices[3] = top_left; vertices[4] = bottom_right; vertices[5] = bottom_left;
+   }
+}
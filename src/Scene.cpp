@@ -0,0 +1,382 @@
+#include "CX/Scene/Scene.hpp"
+
+#include "CX/Camera.hpp"
+#include "CX/UIElement/UIElement.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace cx
+{
+   // Constructors
+
+   Scene::Scene(float cell_size)
+      : cell_size(std::max(cell_size, 1.f)) {}
+
+   // Member functions
+
+   void Scene::add(UIElement& element, int layer)
+   {
+      if (lookup.contains(&element))
+      {
+         set_layer(element, layer);
+         return;
+      }
+
+      uint32_t index;
+      if (free_members.empty())
+      {
+         index = static_cast<uint32_t>(members.size());
+         members.emplace_back();
+      }
+      else
+      {
+         index = free_members.back();
+         free_members.pop_back();
+      }
+
+      Member& member = members[index];
+      member = Member();
+      member.element = &element;
+      member.layer = layer;
+      member.order = next_order++;
+      member.box = get_box(element);
+
+      lookup.emplace(&element, index);
+      insert(index);
+   }
+
+   void Scene::remove(const UIElement& element)
+   {
+      const auto found = lookup.find(&element);
+      if (found == lookup.end())
+         return;
+
+      erase(found->second);
+      members[found->second].element = nullptr;
+      free_members.push_back(found->second);
+      lookup.erase(found);
+   }
+
+   void Scene::clear()
+   {
+      members.clear();
+      free_members.clear();
+      lookup.clear();
+      cells.clear();
+      oversized.clear();
+      hits.clear();
+      visible.clear();
+   }
+
+   bool Scene::contains(const UIElement& element) const
+   {
+      return lookup.contains(&element);
+   }
+
+   void Scene::update(const UIElement& element)
+   {
+      const auto found = lookup.find(&element);
+      if (found != lookup.end())
+         reindex(found->second);
+   }
+
+   void Scene::refresh()
+   {
+      for (uint32_t i = 0; i < members.size(); ++i)
+      {
+         if (members[i].element)
+            reindex(i);
+      }
+   }
+
+   // Setter functions
+
+   void Scene::set_cell_size(float cell_size)
+   {
+      this->cell_size = std::max(cell_size, 1.f);
+
+      cells.clear();
+      oversized.clear();
+
+      for (uint32_t i = 0; i < members.size(); ++i)
+      {
+         if (members[i].element)
+            insert(i);
+      }
+   }
+
+   void Scene::set_layer(const UIElement& element, int layer)
+   {
+      const auto found = lookup.find(&element);
+      if (found != lookup.end())
+         members[found->second].layer = layer;
+   }
+
+   // Getter functions
+
+   float Scene::get_cell_size() const
+   {
+      return cell_size;
+   }
+
+   size_t Scene::size() const
+   {
+      return lookup.size();
+   }
+
+   size_t Scene::cell_count() const
+   {
+      return cells.size();
+   }
+
+   // Query functions
+
+   const std::vector<UIElement*>& Scene::query(const Camera& camera)
+   {
+      return query(camera.get_bounds());
+   }
+
+   const std::vector<UIElement*>& Scene::query(const Vec4f& area)
+   {
+      return collect(area, [](const Vec4f&) { return true; });
+   }
+
+   const std::vector<UIElement*>& Scene::query(const Vec5f& area)
+   {
+      if (!area.rotated())
+         return query(Vec4f(area.x, area.y, area.w, area.h));
+
+      // Cells are walked over the box around the area, members are then tested against the area itself
+      float left = std::numeric_limits<float>::max();
+      float top = std::numeric_limits<float>::max();
+      float right = std::numeric_limits<float>::lowest();
+      float bottom = std::numeric_limits<float>::lowest();
+
+      for (const auto& corner : area.get_corners())
+      {
+         left = std::min(left, corner.x);
+         top = std::min(top, corner.y);
+         right = std::max(right, corner.x);
+         bottom = std::max(bottom, corner.y);
+      }
+
+      return collect(Vec4f(left, top, right - left, bottom - top), [&area](const Vec4f& box)
+      {
+         return area.colliding(Vec5f(box));
+      });
+   }
+
+   // Render functions
+
+   void Scene::render(sf::RenderWindow& window, const Camera& camera)
+   {
+      for (const auto element : query(camera))
+         element->render(window);
+   }
+
+   void Scene::render(sf::RenderWindow& window, const Camera& camera, const sf::Shader* shader)
+   {
+      for (const auto element : query(camera))
+         element->render(window, shader);
+   }
+
+   void Scene::submit(RenderBatch& batch, const Camera& camera, int layer)
+   {
+      query(camera);
+
+      for (const auto index : hits)
+         members[index].element->submit(batch, layer + members[index].layer);
+   }
+
+   // Private functions
+
+   Vec4f Scene::get_box(const UIElement& element)
+   {
+      const Vec5f bounds = element.get_bounds();
+      if (!bounds.rotated())
+         return Vec4f(bounds.x, bounds.y, bounds.w, bounds.h);
+
+      float left = std::numeric_limits<float>::max();
+      float top = std::numeric_limits<float>::max();
+      float right = std::numeric_limits<float>::lowest();
+      float bottom = std::numeric_limits<float>::lowest();
+
+      for (const auto& corner : bounds.get_corners())
+      {
+         left = std::min(left, corner.x);
+         top = std::min(top, corner.y);
+         right = std::max(right, corner.x);
+         bottom = std::max(bottom, corner.y);
+      }
+
+      return Vec4f(left, top, right - left, bottom - top);
+   }
+
+   uint64_t Scene::cell_key(int32_t x, int32_t y)
+   {
+      return (uint64_t(uint32_t(x)) << 32u) | uint32_t(y);
+   }
+
+   Scene::CellRange Scene::get_cells(const Vec4f& box) const
+   {
+      // Keep far away elements from overflowing cell coordinates
+      const auto cell = [this](float position)
+      {
+         constexpr float limit = float(std::numeric_limits<int32_t>::max() / 2);
+         return static_cast<int32_t>(std::clamp(std::floor(position / cell_size), -limit, limit));
+      };
+
+      return CellRange {cell(box.x), cell(box.y), cell(box.x + box.w), cell(box.y + box.h)};
+   }
+
+   void Scene::insert(uint32_t index)
+   {
+      Member& member = members[index];
+      member.cells = get_cells(member.box);
+
+      const int64_t count = (int64_t(member.cells.right) - member.cells.left + 1) *
+                            (int64_t(member.cells.bottom) - member.cells.top + 1);
+      member.oversized = count > max_cells;
+
+      if (member.oversized)
+      {
+         oversized.push_back(index);
+         return;
+      }
+
+      for (int32_t y = member.cells.top; y <= member.cells.bottom; ++y)
+      {
+         for (int32_t x = member.cells.left; x <= member.cells.right; ++x)
+            cells[cell_key(x, y)].push_back(index);
+      }
+   }
+
+   void Scene::erase(uint32_t index)
+   {
+      const Member& member = members[index];
+
+      if (member.oversized)
+      {
+         std::erase(oversized, index);
+         return;
+      }
+
+      for (int32_t y = member.cells.top; y <= member.cells.bottom; ++y)
+      {
+         for (int32_t x = member.cells.left; x <= member.cells.right; ++x)
+         {
+            const auto found = cells.find(cell_key(x, y));
+            if (found == cells.end())
+               continue;
+
+            auto& list = found->second;
+            const auto position = std::find(list.begin(), list.end(), index);
+            if (position != list.end())
+            {
+               *position = list.back();
+               list.pop_back();
+            }
+
+            if (list.empty())
+               cells.erase(found);
+         }
+      }
+   }
+
+   void Scene::reindex(uint32_t index)
+   {
+      Member& member = members[index];
+      const Vec4f box = get_box(*member.element);
+
+      if (box.x == member.box.x && box.y == member.box.y && box.w == member.box.w && box.h == member.box.h)
+         return;
+
+      member.box = box;
+      const CellRange range = get_cells(box);
+
+      // Moving inside the same cells only needs the new box
+      if (!member.oversized && range.left == member.cells.left && range.top == member.cells.top &&
+          range.right == member.cells.right && range.bottom == member.cells.bottom)
+         return;
+
+      erase(index);
+      insert(index);
+   }
+
+   template<typename Test>
+   const std::vector<UIElement*>& Scene::collect(const Vec4f& box, Test&& test)
+   {
+      hits.clear();
+      visible.clear();
+
+      // Stamps mark members already seen by this query, reset them when they wrap
+      if (++stamp == 0u)
+      {
+         for (auto& member : members)
+            member.stamp = 0u;
+         stamp = 1u;
+      }
+
+      const auto visit = [&](uint32_t index)
+      {
+         Member& member = members[index];
+         if (member.stamp == stamp)
+            return;
+
+         member.stamp = stamp;
+         if (member.box.colliding(box) && test(member.box))
+            hits.push_back(index);
+      };
+
+      const CellRange range = get_cells(box);
+      const int64_t count = (int64_t(range.right) - range.left + 1) * (int64_t(range.bottom) - range.top + 1);
+
+      // Areas covering more cells than there are filled cells are cheaper to check cell by cell
+      if (count > int64_t(cells.size()))
+      {
+         for (const auto& [key, list] : cells)
+         {
+            const int32_t x = int32_t(uint32_t(key >> 32u));
+            const int32_t y = int32_t(uint32_t(key));
+
+            if (x < range.left || x > range.right || y < range.top || y > range.bottom)
+               continue;
+
+            for (const auto index : list)
+               visit(index);
+         }
+      }
+      else
+      {
+         for (int32_t y = range.top; y <= range.bottom; ++y)
+         {
+            for (int32_t x = range.left; x <= range.right; ++x)
+            {
+               const auto cell = cells.find(cell_key(x, y));
+               if (cell == cells.end())
+                  continue;
+
+               for (const auto index : cell->second)
+                  visit(index);
+            }
+         }
+      }
+
+      for (const auto index : oversized)
+         visit(index);
+
+      std::sort(hits.begin(), hits.end(), [this](uint32_t a, uint32_t b)
+      {
+         if (members[a].layer != members[b].layer)
+            return members[a].layer < members[b].layer;
+         return members[a].order < members[b].order;
+      });
+
+      visible.reserve(hits.size());
+      for (const auto index : hits)
+         visible.push_back(members[index].element);
+
+      return visible;
+   }
+}
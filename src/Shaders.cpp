@@ -0,0 +1,42 @@
+#include "CX/Render/Shaders.hpp"
+
+#include "CX/Errors.hpp"
+#include "CX/Render/EmbeddedShaders.hpp"
+#include <format>
+#include <memory>
+
+namespace cx::shaders
+{
+   namespace
+   {
+      // Owned by hand and never destroyed at exit, the GL context may already be gone by then
+      sf::Shader* clipping_shader = nullptr;
+      bool clipping_loaded = false;
+   }
+
+   sf::Shader* get_clipping_shader()
+   {
+      if (clipping_loaded)
+         return clipping_shader;
+
+      clipping_loaded = true;
+
+      if (!sf::Shader::isAvailable())
+         return nullptr;
+
+      auto shader = std::make_unique<sf::Shader>();
+      if (!shader->loadFromMemory(embedded::clipping_shader, sf::Shader::Fragment))
+         throw std::runtime_error(std::format(errors::shader::could_not_compile, "clipping_shader.frag"));
+
+      shader->setUniform("texture", sf::Shader::CurrentTexture);
+      clipping_shader = shader.release();
+      return clipping_shader;
+   }
+
+   void release_shaders()
+   {
+      delete clipping_shader;
+      clipping_shader = nullptr;
+      clipping_loaded = false;
+   }
+}
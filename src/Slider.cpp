@@ -1,6 +1,7 @@
 #include "CX/Slider/Slider.hpp"
 
-#include "CX/Config.hpp" // IWYU pragma: export
+#include "CX/Render/ProgressFill.hpp"
+#include "CX/Render/RenderBatch.hpp"
 
 namespace cx
 {
@@ -12,14 +13,7 @@ namespace cx
 
    // Constructors
 
-   Slider::Slider()
-   {
-      if (!clip_shader.loadFromFile(CX_SHADER_PATH "clipping_shader.frag", sf::Shader::Fragment))
-         throw std::runtime_error(errors::slider::could_not_load_shader);
-
-      clip_shader.setUniform("texture", sf::Shader::CurrentTexture);
-      clip_shader.setUniform("progress", slider_progress);
-   }
+   Slider::Slider() {}
 
    Slider::Slider(const SliderStyle& style,
                   float step,
@@ -27,9 +21,6 @@ namespace cx
                   float max_value,
                   float progress)
    {
-      if (!clip_shader.loadFromFile(CX_SHADER_PATH "clipping_shader.frag", sf::Shader::Fragment))
-         throw std::runtime_error(errors::slider::could_not_load_shader);
-
       slider_step = step;
       slider_min = min_value;
       slider_max = max_value;
@@ -62,9 +53,6 @@ namespace cx
                   float max_value,
                   float progress)
    {
-      if (!clip_shader.loadFromFile(CX_SHADER_PATH "clipping_shader.frag", sf::Shader::Fragment))
-         throw std::runtime_error(errors::slider::could_not_load_shader);
-
       slider_step = step;
       slider_min = min_value;
       slider_max = max_value;
@@ -96,9 +84,7 @@ namespace cx
                        float max_value,
                        float progress)
    {
-      if (!clip_shader.loadFromFile(CX_SHADER_PATH "clipping_shader.frag", sf::Shader::Fragment))
-         throw std::runtime_error(errors::slider::could_not_load_shader);
-
+      mark_changed();
       slider_step = step;
       slider_min = min_value;
       slider_max = max_value;
@@ -131,9 +117,7 @@ namespace cx
                        float max_value,
                        float progress)
    {
-      if (!clip_shader.loadFromFile(CX_SHADER_PATH "clipping_shader.frag", sf::Shader::Fragment))
-         throw std::runtime_error(errors::slider::could_not_load_shader);
-
+      mark_changed();
       slider_step = step;
       slider_min = min_value;
       slider_max = max_value;
@@ -161,6 +145,7 @@ namespace cx
 
    void Slider::set_center(const Vec2f& center)
    {
+      mark_changed();
       background.setPosition(center);
       foreground.setPosition(center);
       reposition_knob();
@@ -168,6 +153,7 @@ namespace cx
 
    void Slider::set_scale(const Vec2f& scale)
    {
+      mark_changed();
       background.setScale(scale);
       foreground.setScale(scale);
       knob.setScale(scale);
@@ -176,37 +162,44 @@ namespace cx
 
    void Slider::set_size(const Vec2f& size)
    {
+      mark_changed();
       background.setSize(size);
       reposition_knob();
    }
 
    void Slider::set_knob_size(const Vec2f& size)
    {
+      mark_changed();
       knob.setSize(size);
    }
 
    void Slider::set_knob_size(float width, float height)
    {
+      mark_changed();
       knob.setSize(Vec2f(width, height));
    }
 
    void Slider::set_knob_size(float size)
    {
+      mark_changed();
       knob.setSize(Vec2f(size));
    }
 
    void Slider::set_knob_width(float width)
    {
+      mark_changed();
       knob.setSize(Vec2f(width, knob.getSize().y));
    }
 
    void Slider::set_knob_height(float height)
    {
+      mark_changed();
       knob.setSize(Vec2f(knob.getSize().x, height));
    }
 
    void Slider::set_rotation(float angle)
    {
+      mark_changed();
       background.setRotation(angle);
       foreground.setRotation(angle);
       knob.setRotation(angle);
@@ -215,18 +208,21 @@ namespace cx
 
    void Slider::set_texture(const sf::Texture* texture)
    {
+      mark_changed();
       background.setTexture(texture);
       reposition_knob();
    }
 
    void Slider::set_fg_texture(const sf::Texture* texture)
    {
+      mark_changed();
       foreground.setTexture(texture);
       reposition_knob();
    }
 
    void Slider::set_knob_texture(const sf::Texture* texture)
    {
+      mark_changed();
       knob.setTexture(texture);
       reposition_knob();
    }
@@ -235,6 +231,7 @@ namespace cx
                             const sf::Texture* fg_texture,
                             const sf::Texture* knob_texture)
    {
+      mark_changed();
       background.setTexture(bg_texture);
       foreground.setTexture(fg_texture);
       knob.setTexture(knob_texture);
@@ -243,16 +240,19 @@ namespace cx
 
    void Slider::set_texture_rect(const Vec4i& rect)
    {
+      mark_changed();
       background.setTextureRect(rect);
    }
 
    void Slider::set_fg_texture_rect(const Vec4i& rect)
    {
+      mark_changed();
       foreground.setTextureRect(rect);
    }
 
    void Slider::set_knob_texture_rect(const Vec4i& rect)
    {
+      mark_changed();
       knob.setTextureRect(rect);
    }
 
@@ -260,6 +260,7 @@ namespace cx
                                  const Vec4i& fg_rect,
                                  const Vec4i& knob_rect)
    {
+      mark_changed();
       background.setTextureRect(bg_rect);
       foreground.setTextureRect(fg_rect);
       knob.setTextureRect(knob_rect);
@@ -267,16 +268,19 @@ namespace cx
 
    void Slider::set_color(const Color& color)
    {
+      mark_changed();
       background.setFillColor(color);
    }
 
    void Slider::set_fg_color(const Color& color)
    {
+      mark_changed();
       foreground.setFillColor(color);
    }
 
    void Slider::set_knob_color(const Color& color)
    {
+      mark_changed();
       knob.setFillColor(color);
    }
 
@@ -284,6 +288,7 @@ namespace cx
                           const Color& fg_color,
                           const Color& knob_color)
    {
+      mark_changed();
       background.setFillColor(bg_color);
       foreground.setFillColor(fg_color);
       knob.setFillColor(knob_color);
@@ -291,37 +296,44 @@ namespace cx
 
    void Slider::set_fg_opacity(unsigned char opacity)
    {
+      mark_changed();
       foreground.setFillColor(Color(get_fg_color(), opacity));
    }
 
    void Slider::set_knob_opacity(unsigned char opacity)
    {
+      mark_changed();
       knob.setFillColor(Color(get_knob_color(), opacity));
    }
 
    void Slider::set_step(float step)
    {
+      mark_changed();
       slider_step = step;
    }
 
    void Slider::set_minimum_value(float min)
    {
+      mark_changed();
       slider_min = min;
    }
 
    void Slider::set_maximum_value(float max)
    {
+      mark_changed();
       slider_max = max;
    }
 
    void Slider::set_value_bounds(float min, float max)
    {
+      mark_changed();
       slider_min = min;
       slider_max = max;
    }
 
    void Slider::set_value(float value)
    {
+      mark_changed();
       slider_value = value;
       calculate_progress();
       reposition_knob();
@@ -329,6 +341,7 @@ namespace cx
 
    void Slider::set_progress(float progress)
    {
+      mark_changed();
       slider_progress = progress;
       calculate_value();
       reposition_knob();
@@ -336,6 +349,7 @@ namespace cx
 
    void Slider::set_progress_percent(char percent)
    {
+      mark_changed();
       slider_progress = static_cast<float>(percent) * .01f;
       calculate_value();
       reposition_knob();
@@ -552,6 +566,7 @@ namespace cx
 
    void Slider::increment_value(float value)
    {
+      mark_changed();
       slider_value = std::clamp(slider_value + value, slider_min, slider_max);
       calculate_progress();
       reposition_knob();
@@ -559,6 +574,7 @@ namespace cx
 
    void Slider::increment_progress(float value)
    {
+      mark_changed();
       slider_progress = std::clamp(slider_progress + value, 0.f, 1.f);
       calculate_value();
       reposition_knob();
@@ -566,6 +582,7 @@ namespace cx
 
    void Slider::increment_progress_percent(char percent)
    {
+      mark_changed();
       slider_progress = std::clamp(slider_progress + static_cast<float>(percent) * .01f,
          0.f, 1.f);
       calculate_value();
@@ -574,6 +591,7 @@ namespace cx
 
    void Slider::decrement_value(float value)
    {
+      mark_changed();
       slider_value = std::clamp(slider_value - value, slider_min, slider_max);
       calculate_progress();
       reposition_knob();
@@ -581,6 +599,7 @@ namespace cx
 
    void Slider::decrement_progress(float value)
    {
+      mark_changed();
       slider_progress = std::clamp(slider_progress - value, 0.f, 1.f);
       calculate_value();
       reposition_knob();
@@ -588,6 +607,7 @@ namespace cx
 
    void Slider::decrement_progress_percent(char percent)
    {
+      mark_changed();
       slider_progress = std::clamp(slider_progress - static_cast<float>(percent) * .01f,
          0.f, 1.f);
       calculate_value();
@@ -596,6 +616,7 @@ namespace cx
 
    void Slider::update_value(float value, bool condition)
    {
+      mark_changed();
       slider_value = std::clamp(slider_value + (condition ? value : -value), slider_min, slider_max);
       calculate_progress();
       reposition_knob();
@@ -603,6 +624,7 @@ namespace cx
 
    void Slider::update_progress(float value, bool condition)
    {
+      mark_changed();
       slider_progress = std::clamp(slider_progress + (condition ? value : -value), 0.f, 1.f);
       calculate_value();
       reposition_knob();
@@ -610,6 +632,7 @@ namespace cx
 
    void Slider::update_progress_percent(char percent, bool condition)
    {
+      mark_changed();
       slider_progress = std::clamp(slider_progress + static_cast<float>(percent)
          * (condition ? .01f : -.01f), 0.f, 1.f);
       calculate_value();
@@ -618,6 +641,7 @@ namespace cx
 
    void Slider::update_value(float positive, float negative, bool condition)
    {
+      mark_changed();
       slider_value = std::clamp(slider_value + (condition ? positive : -negative),
          slider_min, slider_max);
       calculate_progress();
@@ -626,6 +650,7 @@ namespace cx
 
    void Slider::update_progress(float positive, float negative, bool condition)
    {
+      mark_changed();
       slider_progress = std::clamp(slider_progress + (condition ? positive : -negative),
          0.f, 1.f);
       calculate_value();
@@ -634,6 +659,7 @@ namespace cx
 
    void Slider::update_progress_percent(char positive, char negative, bool condition)
    {
+      mark_changed();
       slider_progress = std::clamp(slider_progress + (condition ? static_cast<float>(positive)
          * .01f : static_cast<float>(negative) * -.01f), 0.f, 1.f);
       calculate_value();
@@ -671,43 +697,48 @@ namespace cx
 
    // Render functions
 
-   void Slider::render(sf::RenderWindow& window) const
+   void Slider::render(sf::RenderTarget& target) const
    {
-      window.draw(background);
+      target.draw(background);
 
-      if (slider_progress > 0.f && foreground.getTexture() != nullptr)
-         window.draw(foreground, &clip_shader);
-      else if (slider_progress > 0.f)
-         window.draw(foreground);
+      render_foreground(target, nullptr);
 
-      window.draw(knob);
+      target.draw(knob);
    }
 
-   void Slider::render(sf::RenderWindow& window, const sf::Shader* shader) const
+   void Slider::render(sf::RenderTarget& target, const sf::Shader* shader) const
    {
-      window.draw(background, shader);
+      target.draw(background, shader);
 
-      if (slider_progress > 0.f && foreground.getTexture() != nullptr)
-         window.draw(foreground, &clip_shader);
-      else if (slider_progress > 0.f)
-         window.draw(foreground, shader);
+      render_foreground(target, shader);
 
-      window.draw(knob, shader);
+      target.draw(knob, shader);
+   }
+
+   void Slider::submit(RenderBatch& batch, int layer) const
+   {
+      batch.submit(background, layer);
+
+      sf::Vertex vertices[progress_fill_max_vertices];
+      const size_t count = build_progress_fill(foreground, slider_progress, FillMode::left_to_right, vertices);
+      batch.submit(vertices, count, foreground.getTexture(), layer);
+
+      batch.submit(knob, layer);
    }
 
    // Access functions
 
-   sf::RectangleShape& Slider::get_knob()
+   Quad& Slider::get_knob()
    {
       return knob;
    }
 
-   sf::RectangleShape& Slider::get_foreground()
+   Quad& Slider::get_foreground()
    {
       return foreground;
    }
 
-   sf::RectangleShape& Slider::get_background()
+   Quad& Slider::get_background()
    {
       return background;
    }
@@ -727,13 +758,8 @@ namespace cx
 
    void Slider::reposition_knob()
    {
-      clip_shader.setUniform("progress", slider_progress);
-      clip_shader.setUniform("texture", sf::Shader::CurrentTexture);
-
-      if (foreground.getTexture() == nullptr)
-         foreground.setSize(Vec2f(background.getSize().x * slider_progress, background.getSize().y));
-      else
-         foreground.setSize(background.getSize());
+      // Progress is applied when drawing, the foreground always covers the background
+      foreground.setSize(background.getSize());
 
       knob.setPosition(foreground.getPosition().x - foreground.getOrigin().x
          * foreground.getScale().x + background.getSize().x * slider_progress
@@ -747,4 +773,15 @@ namespace cx
          .rotate(foreground.getRotation() * M_PIf / 180.f)
          + foreground.getPosition());
    }
+
+   void Slider::render_foreground(sf::RenderTarget& target, const sf::Shader* shader) const
+   {
+      sf::Vertex vertices[progress_fill_max_vertices];
+      sf::RenderStates states;
+      states.texture = foreground.getTexture();
+      states.shader = shader;
+
+      target.draw(vertices, build_progress_fill(foreground, slider_progress, FillMode::left_to_right, vertices),
+                  sf::Triangles, states);
+   }
 }
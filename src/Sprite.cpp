@@ -1,5 +1,7 @@
 #include "CX/Sprite/Sprite.hpp"
 
+#include "CX/Render/RenderBatch.hpp"
+
 namespace cx
 {
    /// Set default styles
@@ -23,6 +25,9 @@ namespace cx
 
       if (!style.texture_rect.empty())
          rect.setTextureRect(style.texture_rect);
+
+      if (style.animations)
+         set_animation_sheet(style.animations);
    }
 
    Sprite::Sprite(const Vec2f& size,
@@ -43,6 +48,7 @@ namespace cx
 
    void Sprite::create(const SpriteStyle& style)
    {
+      mark_changed();
       rect.setSize(style.size);
       rect.setOrigin(style.size * .5f);
       rect.setFillColor(style.color);
@@ -50,6 +56,9 @@ namespace cx
 
       if (!style.texture_rect.empty())
          rect.setTextureRect(style.texture_rect);
+
+      if (style.animations)
+         set_animation_sheet(style.animations);
    }
 
    void Sprite::create(const Vec2f& size,
@@ -57,6 +66,7 @@ namespace cx
                        const sf::Texture* texture,
                        const Vec4i& textureRect)
    {
+      mark_changed();
       rect.setPosition(position);
       rect.setSize(size);
       rect.setOrigin(size * .5f);
@@ -70,37 +80,51 @@ namespace cx
 
    void Sprite::set_center(const Vec2f& position)
    {
+      mark_changed();
       rect.setPosition(position);   
    }
 
    void Sprite::set_scale(const Vec2f& scale)
    {
+      mark_changed();
       rect.setScale(scale);
    }
 
    void Sprite::set_size(const Vec2f& size)
    {
+      mark_changed();
       rect.setSize(size);
       rect.setOrigin(size * .5f);
    }
 
    void Sprite::set_rotation(float angle)
    {
+      mark_changed();
       rect.setRotation(angle);
    }
 
    void Sprite::set_texture(const sf::Texture* texture)
    {
+      mark_changed();
       rect.setTexture(texture);
    }
 
+   void Sprite::set_texture(const TextureRegion& region)
+   {
+      mark_changed();
+      rect.setTexture(region.texture);
+      rect.setTextureRect(region.rect);
+   }
+
    void Sprite::set_texture_rect(const Vec4i& rect_)
    {
+      mark_changed();
       rect.setTextureRect(rect_);
    }
 
    void Sprite::set_color(const Color& color)
    {
+      mark_changed();
       rect.setFillColor(color);
    }
 
@@ -166,140 +190,183 @@ namespace cx
 
    void Sprite::update_animation(float dt)
    {
-      if (!playing || !animations.contains(current_animation))
+      if (!playing || current_animation == no_animation)
          return;
 
       elapsedTime += dt;
 
-      if (elapsedTime * speedMult >= animations.at(current_animation).speed)
+      if (elapsedTime * speedMult >= sheet->get_clip(current_animation).speed)
          advance_frame();
    }
 
    void Sprite::play()
    {
-      if (!current_animation.empty())
+      if (current_animation != no_animation)
          playing = true;
    }
 
    void Sprite::pause()
    {
-      if (!current_animation.empty())
+      if (current_animation != no_animation)
          playing = false;
    }
 
    void Sprite::reset()
    {
-      playing = !idle.empty();
+      mark_changed();
+      playing = idle != no_animation;
       index = 0;
       elapsedTime = 0.f;
 
-      if (!animations.contains(current_animation))
-      {
-         const Animation& anim {animations.at(current_animation)};
-         rect.setTextureRect(Vec4i(anim.posX, anim.posY, anim.sizeX, anim.sizeY));
-      }
+      if (current_animation != no_animation && sheet->get_clip(current_animation).length != 0u)
+         rect.setTextureRect(sheet->get_frame(current_animation, 0));
 
       current_animation = idle;
    }
 
    void Sprite::advance_frame()
    {
-      if (!animations.contains(current_animation))
+      if (current_animation == no_animation)
+         return;
+
+      const AnimationClip& clip {sheet->get_clip(current_animation)};
+      if (clip.length == 0u)
          return;
-      const Animation& anim {animations.at(current_animation)};
 
+      mark_changed();
       elapsedTime = 0.f;
 
-      if (anim.reversed)
-         index = (index - 1 + anim.length) % anim.length;
+      if (clip.reversed)
+         index = (index - 1 + clip.length) % clip.length;
       else
-         index = (index + 1) % anim.length;
+         index = (index + 1) % clip.length;
 
-      rect.setTextureRect(Vec4i(
-         anim.posX + (anim.gap * static_cast<unsigned>(index)) + (anim.sizeX * static_cast<unsigned>(index)),
-         anim.posY,
-         anim.sizeX,
-         anim.sizeY
-      ));
+      rect.setTextureRect(sheet->get_frame(current_animation, index));
 
-      if (!(index == anim.length - 1 && !anim.reversed) && !(index == 0 && anim.reversed))
+      if (!(index == clip.length - 1 && !clip.reversed) && !(index == 0 && clip.reversed))
          return;
 
-      if (anim.looping)
+      if (clip.looping)
          return;
 
       elapsedTime = 0.f;
       index = 0;
 
-      rect.setTextureRect(Vec4i(anim.posX, anim.posY, anim.sizeX, anim.sizeY));
+      rect.setTextureRect(sheet->get_frame(current_animation, 0));
 
-      if (animations.contains(idle))
+      if (idle != no_animation)
          current_animation = idle;
       else
       {
          playing = false;
-         current_animation = "";
+         current_animation = no_animation;
       }
    }
 
-   void Sprite::add_animation(const std::string& identifier,
-                              const Animation& animation,
-                              bool default_animation)
+   AnimationId Sprite::add_animation(const std::string& identifier,
+                                     const Animation& animation,
+                                     bool default_animation)
    {
-      if (!animations.contains(identifier))
-         animations.emplace(identifier, animation);
+      // A sheet this sprite created and alone holds, through sheet and owned_sheet, is edited in place
+      if (!owned_sheet || owned_sheet.use_count() > 2)
+      {
+         owned_sheet = sheet ? std::make_shared<AnimationSheet>(*sheet) : std::make_shared<AnimationSheet>();
+         sheet = owned_sheet;
+      }
+
+      const AnimationId id = owned_sheet->add(identifier, animation);
 
       if (default_animation)
       {
-         current_animation = idle = identifier;
+         current_animation = idle = id;
          playing = true;
       }
+
+      return id;
+   }
+
+   void Sprite::set_animation_sheet(std::shared_ptr<const AnimationSheet> sheet)
+   {
+      mark_changed();
+      this->sheet = std::move(sheet);
+      owned_sheet.reset();
+      current_animation = idle = no_animation;
+      playing = false;
+      index = 0;
+      elapsedTime = 0.f;
    }
 
    void Sprite::set_default_animation(const std::string& identifier)
    {
-      current_animation = idle = identifier;
+      set_default_animation(sheet ? sheet->find(identifier) : no_animation);
+   }
+
+   void Sprite::set_default_animation(AnimationId id)
+   {
+      if (!sheet || !sheet->contains(id))
+         id = no_animation;
+
+      if (id == current_animation && id == idle && playing)
+         return;
+
+      mark_changed();
+      current_animation = idle = id;
       playing = true;
    }
 
    void Sprite::play_animation(const std::string& identifier, bool reset)
    {
-      if (!reset && identifier == current_animation)
+      play_animation(sheet ? sheet->find(identifier) : no_animation, reset);
+   }
+
+   void Sprite::play_animation(AnimationId id, bool reset)
+   {
+      if (!sheet || !sheet->contains(id))
+         id = no_animation;
+
+      if (!reset && id == current_animation)
          return;
 
-      if (animations.contains(identifier) && (current_animation != identifier
-         || !animations.at(identifier).looping))
+      // Playing a looping animation again only resumes it
+      const bool restart = id != no_animation && (current_animation != id || !sheet->get_clip(id).looping);
+      if (!restart && id == current_animation && playing)
+         return;
+
+      mark_changed();
+
+      if (restart)
       {
          index = 0;
          elapsedTime = 0.f;
       }
 
-      current_animation = identifier;
+      current_animation = id;
       playing = true;
    }
 
    bool Sprite::is_animation_finished() const
    {
-      return !playing && !animations.contains(current_animation);
+      return !playing && current_animation == no_animation;
    }
 
    bool Sprite::is_default_playing() const
    {
-      return playing && animations.contains(current_animation) && current_animation == idle;
+      return playing && current_animation != no_animation && current_animation == idle;
    }
 
    bool Sprite::is_playing() const
    {
-      return playing && animations.contains(current_animation);
+      return playing && current_animation != no_animation;
    }
 
    bool Sprite::is_paused() const
    {
-      return !playing && animations.contains(current_animation);
+      return !playing && current_animation != no_animation;
    }
 
    void Sprite::set_speed_multiplier(float multiplier)
    {
+      mark_changed();
       speedMult = multiplier;
    }
 
@@ -315,44 +382,60 @@ namespace cx
 
    const std::string& Sprite::get_playing_animation() const
    {
-      return (is_playing() ? current_animation : empty_string);
+      return (is_playing() ? sheet->get_name(current_animation) : empty_string);
    }
 
    const std::string& Sprite::get_default_animation() const
+   {
+      return (sheet ? sheet->get_name(idle) : empty_string);
+   }
+
+   AnimationId Sprite::get_playing_animation_id() const
+   {
+      return (is_playing() ? current_animation : no_animation);
+   }
+
+   AnimationId Sprite::get_default_animation_id() const
    {
       return idle;
    }
 
+   const std::shared_ptr<const AnimationSheet>& Sprite::get_animation_sheet() const
+   {
+      return sheet;
+   }
+
    void Sprite::clear_animations()
    {
       playing = false;
       index = 0;
       elapsedTime = 0.f;
-      current_animation = idle = "";
-      animations.clear();
+      current_animation = idle = no_animation;
+      sheet.reset();
+      owned_sheet.reset();
    }
 
    // Render functions
 
-   void Sprite::render(sf::RenderWindow& window) const
+   void Sprite::render(sf::RenderTarget& target) const
    {
-      window.draw(rect);
+      target.draw(rect);
    }
 
-   void Sprite::render(sf::RenderWindow& window, const sf::Shader* shader) const
+   void Sprite::render(sf::RenderTarget& target, const sf::Shader* shader) const
    {
-      window.draw(rect, shader);
+      target.draw(rect, shader);
    }
 
-   // Access functions
-
-   sf::RectangleShape& Sprite::get_sprite()
+   void Sprite::submit(RenderBatch& batch, int layer) const
    {
-      return rect;
+      batch.submit(rect, layer);
    }
 
-   std::unordered_map<std::string, Animation>& Sprite::get_animations()
+   // Access functions
+
+   Quad& Sprite::get_sprite()
    {
-      return animations;
+      return rect;
    }
 }
@@ -1,6 +1,7 @@
 #include "CX/Text/Text.hpp"
 
 #include <SFML/Graphics/RectangleShape.hpp>
+#include "CX/Render/RenderBatch.hpp"
 #include <sstream>
 
 namespace cx
@@ -58,6 +59,7 @@ namespace cx
    void Text::create(const TextStyle& style,
                      const std::string& string)
    {
+      mark_changed();
       if (style.font->getInfo().family.empty())
          throw std::runtime_error(errors::text::invalid_font);
 
@@ -77,6 +79,7 @@ namespace cx
                      unsigned char_size,
                      float shadow_thickness)
    {
+      mark_changed();
       if (font.getInfo().family.empty())
          throw std::runtime_error(errors::text::invalid_font);
 
@@ -94,6 +97,7 @@ namespace cx
 
    void Text::set_string(const std::string& string, bool stay_still)
    {
+      mark_changed();
       text.setString(string);
 
       if (stay_still)
@@ -107,6 +111,7 @@ namespace cx
 
    void Text::set_font(const sf::Font& font)
    {
+      mark_changed();
       if (font.getInfo().family.empty())
          throw std::runtime_error(errors::text::invalid_font);
       text.setFont(font);
@@ -115,48 +120,57 @@ namespace cx
 
    void Text::set_char_size(unsigned char_size)
    {
+      mark_changed();
       text.setCharacterSize(char_size);
       recenter();
    }
 
    void Text::set_style(FontStyle style)
    {
+      mark_changed();
       text.setStyle(static_cast<sf::Text::Style>(style));
       recenter();
    }
 
    void Text::set_center(const Vec2f& position)
    {
+      mark_changed();
       text.setPosition(position);
    }
 
    void Text::set_scale(const Vec2f& scale)
    {
+      mark_changed();
       text.setScale(scale);
    }
 
    void Text::set_size(const Vec2f& size)
    {
+      mark_changed();
       text.setScale(size / Vec2f(text.getLocalBounds().getSize()));
    }
 
    void Text::set_rotation(float angle)
    {
+      mark_changed();
       text.setRotation(angle);
    }
 
    void Text::set_color(const Color& color)
    {
+      mark_changed();
       text.setFillColor(color);
    }
 
    void Text::set_outline_color(const Color& color)
    {
+      mark_changed();
       text.setOutlineColor(color);
    }
 
    void Text::set_outline_thickness(float thickness)
    {
+      mark_changed();
       text.setOutlineThickness(thickness);
    }
 
@@ -177,6 +191,7 @@ namespace cx
 
    void Text::fit_inside(const Vec2f& rectSize)
    {
+      mark_changed();
       if ((get_width() <= rectSize.x && get_height() <= rectSize.y) || text.getString().isEmpty())
          return;
       
@@ -274,6 +289,7 @@ namespace cx
 
    void Text::wrap(float maxWidth)
    {
+      mark_changed();
       if (get_width() <= maxWidth || text.getString().isEmpty())
          return;
 
@@ -337,6 +353,7 @@ namespace cx
 
    void Text::truncate(float maxWidth)
    {
+      mark_changed();
       if (get_width() <= maxWidth || text.getString().isEmpty())
          return;
 
@@ -439,14 +456,19 @@ namespace cx
 
    // Render functions
    
-   void Text::render(sf::RenderWindow& window) const
+   void Text::render(sf::RenderTarget& target) const
    {
-      window.draw(text);
+      target.draw(text);
    }
 
-   void Text::render(sf::RenderWindow& window, const sf::Shader* shader) const
+   void Text::render(sf::RenderTarget& target, const sf::Shader* shader) const
    {
-      window.draw(text, shader);
+      target.draw(text, shader);
+   }
+
+   void Text::submit(RenderBatch& batch, int layer) const
+   {
+      batch.submit(text, glyphs, layer);
    }
 
    // Access functions
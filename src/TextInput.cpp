@@ -1,6 +1,7 @@
 #include "CX/TextInput/TextInput.hpp"
 
 #include "CX/EventHandler/EventHandler.hpp"
+#include "CX/Render/RenderBatch.hpp"
 
 namespace cx
 {
@@ -68,6 +69,7 @@ namespace cx
    void TextInput::create(const TextInputStyle& style,
                           const std::string& string)
    {
+      mark_changed();
       if (style.font->getInfo().family.empty())
          throw std::runtime_error(errors::text::invalid_font);
 
@@ -94,6 +96,7 @@ namespace cx
                           const Vec2f& position,
                           unsigned char_size)
    {
+      mark_changed();
       if (font.getInfo().family.empty())
          throw std::runtime_error(errors::text::invalid_font);
 
@@ -115,18 +118,21 @@ namespace cx
 
    void TextInput::set_center(const Vec2f& position)
    {
+      mark_changed();
       rect.setPosition(position);
       text.setPosition(position);
    }
 
    void TextInput::set_scale(const Vec2f& scale)
    {
+      mark_changed();
       rect.setScale(scale);
       text.setScale(scale);
    }
 
    void TextInput::set_size(const Vec2f& size)
    {
+      mark_changed();
       rect.setSize(size);
       rect.setOrigin(size * .5f);
       text.setPosition(rect.getPosition());
@@ -134,27 +140,32 @@ namespace cx
 
    void TextInput::set_rotation(float angle)
    {
+      mark_changed();
       rect.setRotation(angle);
       text.setRotation(angle);
    }
 
    void TextInput::set_texture(const sf::Texture* texture)
    {
+      mark_changed();
       rect.setTexture(texture);
    }
 
    void TextInput::set_texture_rect(const Vec4i& texture_rect)
    {
+      mark_changed();
       rect.setTextureRect(texture_rect);
    }
 
    void TextInput::set_color(const Color& color)
    {
+      mark_changed();
       rect.setFillColor(color);
    }
 
    void TextInput::set_string(const std::string& string)
    {
+      mark_changed();
       hidden = string;
       if (!input_active)
       {
@@ -165,6 +176,7 @@ namespace cx
 
    void TextInput::set_input(const std::string& string)
    {
+      mark_changed();
       input = string;
       if (input_active)
       {
@@ -175,6 +187,7 @@ namespace cx
 
    void TextInput::set_font(const sf::Font& font)
    {
+      mark_changed();
       if (font.getInfo().family.empty())
          throw std::runtime_error(errors::text::invalid_font);
 
@@ -184,78 +197,93 @@ namespace cx
 
    void TextInput::set_char_size(unsigned char_size)
    {
+      mark_changed();
       text.setCharacterSize(char_size);
       recenter();
    }
 
    void TextInput::set_style(FontStyle style)
    {
+      mark_changed();
       text.setStyle(static_cast<sf::Text::Style>(style));
       recenter();
    }
 
    void TextInput::set_text_color(const Color& color)
    {
+      mark_changed();
       text.setFillColor(color);
    }
 
    void TextInput::set_text_opacity(unsigned char opacity)
    {
+      mark_changed();
       text.setFillColor(Color(get_text_color(), opacity));
    }
 
    void TextInput::set_text_outline_color(const Color& color)
    {
+      mark_changed();
       text.setOutlineColor(color);
    }
 
    void TextInput::set_text_outline_thickness(float thickness)
    {
+      mark_changed();
       text.setOutlineThickness(thickness);
    }
 
    void TextInput::set_disabled(bool disabled)
    {
+      mark_changed();
       input_disabled = disabled;
    }
 
    void TextInput::toggle_disabled()
    {
+      mark_changed();
       input_disabled = !input_disabled;
    }
 
    void TextInput::set_active(bool active)
    {
+      mark_changed();
       input_active = active;
    }
 
    void TextInput::toggle_active()
    {
+      mark_changed();
       input_active = !input_active;
    }
 
    void TextInput::set_clear_on_enter(bool clear)
    {
+      mark_changed();
       clear_on_enter = clear;
    }
 
    void TextInput::set_maximum_char_count(unsigned char_count)
    {
+      mark_changed();
       max_char_count = char_count;
    }
 
    void TextInput::set_enter_key(Key key)
    {
+      mark_changed();
       enter_key = key;
    }
 
    void TextInput::set_controller_enter_key(Controller key)
    {
+      mark_changed();
       enter_btn = key;
    }
 
    void TextInput::set_enter_keys(Key key1, Controller key2)
    {
+      mark_changed();
       enter_key = key1;
       enter_btn = key2;
    }
@@ -422,12 +450,14 @@ namespace cx
 
          text.setString(input);
          recenter();
+         mark_changed();
       }
 
       if (was_input_active && !input_active)
       {
          if (input == "")
             text.setString(hidden);
+         mark_changed();
       }
 
       if (!was_input_active && input_active)
@@ -436,27 +466,34 @@ namespace cx
          {
             input = "";
             text.setString("");
+            mark_changed();
          }
       }
    }
 
    // Render functions
 
-   void TextInput::render(sf::RenderWindow& window) const
+   void TextInput::render(sf::RenderTarget& target) const
    {
-      window.draw(rect);
-      window.draw(text);
+      target.draw(rect);
+      target.draw(text);
    }
 
-   void TextInput::render(sf::RenderWindow& window, const sf::Shader* shader) const
+   void TextInput::render(sf::RenderTarget& target, const sf::Shader* shader) const
    {
-      window.draw(rect, shader);
-      window.draw(text, shader);
+      target.draw(rect, shader);
+      target.draw(text, shader);
+   }
+
+   void TextInput::submit(RenderBatch& batch, int layer) const
+   {
+      batch.submit(rect, layer);
+      batch.submit(text, glyphs, layer);
    }
 
    // Access functions
 
-   sf::RectangleShape& TextInput::get_background()
+   Quad& TextInput::get_background()
    {
       return rect;
    }
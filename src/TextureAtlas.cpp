@@ -0,0 +1,281 @@
+#include "CX/Atlas/TextureAtlas.hpp"
+
+#include "CX/Atlas/SkylinePacker.hpp"
+#include "CX/Errors.hpp"
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <numeric>
+
+namespace cx
+{
+   namespace
+   {
+      constexpr const char* layout_header = "cx_atlas";
+      constexpr int layout_version = 1;
+
+      /// @brief Get a stamp that changes when a file is modified.
+      /// @param path Path to the file.
+      /// @return File size and last write time.
+      std::pair<uintmax_t, long long> get_file_stamp(const fs::path& path)
+      {
+         std::error_code size_error, time_error;
+         const uintmax_t size = fs::file_size(path, size_error);
+         const auto time = fs::last_write_time(path, time_error);
+         return {size_error ? 0u : size, time_error ? 0ll : static_cast<long long>(time.time_since_epoch().count())};
+      }
+   }
+
+   // Constructors
+
+   TextureAtlas::TextureAtlas(unsigned page_size, unsigned padding)
+      : page_size(page_size), padding(padding) {}
+
+   // Build functions
+
+   void TextureAtlas::add(const std::string& identifier, const fs::path& path)
+   {
+      if (lookup.contains(identifier))
+         return;
+
+      lookup.insert({identifier, entries.size()});
+      entries.push_back(Entry {identifier, path, sf::Image(), 0u, Vec4i()});
+   }
+
+   void TextureAtlas::build(const fs::path& layout_path, const loader_t& loader)
+   {
+      page_size = std::min(page_size, sf::Texture::getMaximumSize());
+
+      for (auto& entry : entries)
+      {
+         if (loader)
+            loader(entry.image, entry.path);
+         else if (!entry.image.loadFromFile(entry.path.string()))
+            throw std::runtime_error(std::format(errors::atlas::cannot_load_image, entry.path.string()));
+
+         const sf::Vector2u size = entry.image.getSize();
+         if (size.x + padding * 2u > page_size || size.y + padding * 2u > page_size)
+            throw std::runtime_error(std::format(errors::atlas::image_too_large, entry.path.string(), page_size, page_size));
+      }
+
+      size_t count = layout_path.empty() ? 0u : load_layout(layout_path);
+      layout_cached = count != 0u;
+
+      if (!layout_cached)
+      {
+         count = pack();
+
+         if (!layout_path.empty())
+            save_layout(layout_path, count);
+      }
+
+      create_pages(count);
+
+      // Pixels live on the pages now
+      for (auto& entry : entries)
+         entry.image = sf::Image();
+   }
+
+   void TextureAtlas::clear()
+   {
+      entries.clear();
+      pages.clear();
+      lookup.clear();
+      layout_cached = false;
+   }
+
+   // Getter functions
+
+   bool TextureAtlas::contains(const std::string& identifier) const
+   {
+      return lookup.contains(identifier);
+   }
+
+   TextureRegion TextureAtlas::get_region(const std::string& identifier) const
+   {
+      const auto found = lookup.find(identifier);
+      if (found == lookup.end() || pages.empty())
+         throw std::runtime_error(std::format(errors::atlas::image_does_not_exist, identifier));
+
+      const Entry& entry = entries[found->second];
+      return TextureRegion(pages[entry.page].get(), entry.rect);
+   }
+
+   const sf::Texture& TextureAtlas::get_page(size_t index) const
+   {
+      return *pages[index];
+   }
+
+   size_t TextureAtlas::page_count() const
+   {
+      return pages.size();
+   }
+
+   size_t TextureAtlas::size() const
+   {
+      return entries.size();
+   }
+
+   unsigned TextureAtlas::get_page_size() const
+   {
+      return page_size;
+   }
+
+   unsigned TextureAtlas::get_padding() const
+   {
+      return padding;
+   }
+
+   bool TextureAtlas::is_layout_cached() const
+   {
+      return layout_cached;
+   }
+
+   // Private functions
+
+   size_t TextureAtlas::pack()
+   {
+      // Tallest first keeps the skyline flat
+      std::vector<size_t> order (entries.size());
+      std::iota(order.begin(), order.end(), size_t(0));
+      std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b)
+      {
+         const sf::Vector2u size_a = entries[a].image.getSize();
+         const sf::Vector2u size_b = entries[b].image.getSize();
+         return size_a.y != size_b.y ? size_a.y > size_b.y : size_a.x > size_b.x;
+      });
+
+      std::vector<SkylinePacker> packers;
+
+      for (size_t index : order)
+      {
+         Entry& entry = entries[index];
+         const sf::Vector2u size = entry.image.getSize();
+         const Vec2i padded (int32_t(size.x + padding * 2u), int32_t(size.y + padding * 2u));
+
+         std::optional<Vec2i> position;
+         for (entry.page = 0u; entry.page < packers.size(); ++entry.page)
+         {
+            position = packers[entry.page].insert(padded);
+            if (position)
+               break;
+         }
+
+         if (!position)
+         {
+            packers.emplace_back(Vec2i(int32_t(page_size), int32_t(page_size)));
+            position = packers.back().insert(padded);
+         }
+
+         entry.rect = Vec4i(position->x + int32_t(padding), position->y + int32_t(padding), int32_t(size.x), int32_t(size.y));
+      }
+
+      return packers.size();
+   }
+
+   size_t TextureAtlas::load_layout(const fs::path& layout_path)
+   {
+      std::ifstream file (layout_path);
+      if (!file)
+         return 0u;
+
+      std::string header;
+      int version = 0;
+      unsigned file_page_size = 0u, file_padding = 0u;
+      size_t count = 0u, entry_count = 0u;
+
+      file >> header >> version >> file_page_size >> file_padding >> count >> entry_count;
+      if (!file || header != layout_header || version != layout_version || file_page_size != page_size ||
+          file_padding != padding || entry_count != entries.size() || count == 0u)
+         return 0u;
+
+      // Read everything first so a mismatch leaves the entries untouched
+      std::vector<std::pair<size_t, Vec4i>> placements (entries.size());
+
+      for (size_t i = 0; i < entries.size(); ++i)
+      {
+         const Entry& entry = entries[i];
+         uintmax_t size = 0u;
+         long long time = 0;
+         std::string path;
+
+         auto& [page, rect] = placements[i];
+         file >> page >> rect.x >> rect.y >> rect.w >> rect.h >> size >> time >> std::ws;
+         std::getline(file, path);
+
+         const sf::Vector2u image_size = entry.image.getSize();
+         if (!file || path != entry.path.string() || get_file_stamp(entry.path) != std::make_pair(size, time) ||
+             page >= count || rect.w != int32_t(image_size.x) || rect.h != int32_t(image_size.y))
+            return 0u;
+      }
+
+      for (size_t i = 0; i < entries.size(); ++i)
+      {
+         entries[i].page = placements[i].first;
+         entries[i].rect = placements[i].second;
+      }
+
+      return count;
+   }
+
+   void TextureAtlas::save_layout(const fs::path& layout_path, size_t count) const
+   {
+      std::ofstream file (layout_path);
+      if (!file)
+         return;
+
+      file << layout_header << ' ' << layout_version << ' ' << page_size << ' ' << padding << ' '
+           << count << ' ' << entries.size() << '\n';
+
+      for (const auto& entry : entries)
+      {
+         const auto [size, time] = get_file_stamp(entry.path);
+         file << entry.page << ' ' << entry.rect.x << ' ' << entry.rect.y << ' ' << entry.rect.w << ' '
+              << entry.rect.h << ' ' << size << ' ' << time << ' ' << entry.path.string() << '\n';
+      }
+   }
+
+   void TextureAtlas::create_pages(size_t count)
+   {
+      std::vector<sf::Image> images (count);
+      for (auto& image : images)
+         image.create(page_size, page_size, sf::Color::Transparent);
+
+      for (const auto& entry : entries)
+      {
+         sf::Image& page = images[entry.page];
+         const unsigned left = unsigned(entry.rect.x);
+         const unsigned top = unsigned(entry.rect.y);
+         const unsigned width = unsigned(entry.rect.w);
+         const unsigned height = unsigned(entry.rect.h);
+
+         page.copy(entry.image, left, top);
+
+         if (width == 0u || height == 0u)
+            continue;
+
+         // Extend edge pixels into the padding so filtering does not bleed in neighbours
+         for (unsigned y = 0; y < height + padding * 2u; ++y)
+         {
+            const unsigned source_y = std::clamp(y, padding, padding + height - 1u) - padding;
+
+            for (unsigned x = 0; x < width + padding * 2u; ++x)
+            {
+               if (x >= padding && x < padding + width && y >= padding && y < padding + height)
+                  continue;
+
+               const unsigned source_x = std::clamp(x, padding, padding + width - 1u) - padding;
+               page.setPixel(left - padding + x, top - padding + y, entry.image.getPixel(source_x, source_y));
+            }
+         }
+      }
+
+      pages.clear();
+      for (const auto& image : images)
+      {
+         auto& page = pages.emplace_back(std::make_unique<sf::Texture>());
+         if (!page->loadFromImage(image))
+            throw std::runtime_error(std::format(errors::atlas::cannot_create_page, page_size, page_size));
+      }
+   }
+}
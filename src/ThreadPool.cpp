@@ -0,0 +1,172 @@
+#include "CX/ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace cx
+{
+   // Constructors
+
+   ThreadPool::ThreadPool()
+      : ThreadPool(std::max(std::thread::hardware_concurrency(), 2u) - 1u) {}
+
+   ThreadPool::ThreadPool(size_t thread_count)
+   {
+      workers.reserve(thread_count);
+
+      for (size_t i = 0; i < thread_count; ++i)
+         workers.emplace_back(&ThreadPool::work, this);
+   }
+
+   ThreadPool::~ThreadPool()
+   {
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         stopping = true;
+      }
+
+      task_condition.notify_all();
+
+      for (auto& worker : workers)
+         worker.join();
+   }
+
+   // Getter functions
+
+   size_t ThreadPool::get_thread_count() const
+   {
+      return workers.size();
+   }
+
+   size_t ThreadPool::get_pending_count() const
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      return tasks.size() + running;
+   }
+
+   // Task functions
+
+   void ThreadPool::submit(std::function<void()> task)
+   {
+      if (workers.empty())
+      {
+         task();
+         return;
+      }
+
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         tasks.push_back(std::move(task));
+      }
+
+      task_condition.notify_one();
+   }
+
+   void ThreadPool::parallel_for(size_t count, size_t chunk_size,
+                                 const std::function<void(size_t, size_t)>& func)
+   {
+      if (count == 0)
+         return;
+
+      chunk_size = std::max(chunk_size, size_t(1));
+      const size_t chunks = (count + chunk_size - 1) / chunk_size;
+
+      if (workers.empty() || chunks == 1)
+      {
+         for (size_t begin = 0; begin < count; begin += chunk_size)
+            func(begin, std::min(begin + chunk_size, count));
+         return;
+      }
+
+      // Chunks are claimed from a shared counter by both the workers and this thread.
+      // State is shared so helpers that start after every chunk is done can still read it.
+      struct State
+      {
+         std::atomic<size_t> next_chunk = 0;
+         std::atomic<size_t> done_chunks = 0;
+         std::exception_ptr error;
+         std::mutex mutex;
+         std::condition_variable finished;
+      };
+
+      auto state = std::make_shared<State>();
+
+      auto run = [state, chunks, chunk_size, count, &func]
+      {
+         size_t finished = 0;
+
+         for (size_t chunk = state->next_chunk++; chunk < chunks; chunk = state->next_chunk++, ++finished)
+         {
+            const size_t begin = chunk * chunk_size;
+
+            try
+            {
+               func(begin, std::min(begin + chunk_size, count));
+            }
+            catch (...)
+            {
+               std::lock_guard<std::mutex> lock(state->mutex);
+               if (!state->error)
+                  state->error = std::current_exception();
+            }
+         }
+
+         if (finished != 0 && state->done_chunks.fetch_add(finished) + finished == chunks)
+         {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->finished.notify_one();
+         }
+      };
+
+      const size_t helpers = std::min(workers.size(), chunks - 1);
+      for (size_t i = 0; i < helpers; ++i)
+         submit(run);
+
+      run();
+
+      std::unique_lock<std::mutex> lock(state->mutex);
+      state->finished.wait(lock, [&] { return state->done_chunks == chunks; });
+
+      if (state->error)
+         std::rethrow_exception(state->error);
+   }
+
+   void ThreadPool::wait()
+   {
+      std::unique_lock<std::mutex> lock(mutex);
+      done_condition.wait(lock, [this] { return tasks.empty() && running == 0; });
+   }
+
+   // Private functions
+
+   void ThreadPool::work()
+   {
+      while (true)
+      {
+         std::function<void()> task;
+
+         {
+            std::unique_lock<std::mutex> lock(mutex);
+            task_condition.wait(lock, [this] { return stopping || !tasks.empty(); });
+
+            if (tasks.empty())
+               return;
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+            ++running;
+         }
+
+         task();
+
+         {
+            std::lock_guard<std::mutex> lock(mutex);
+            --running;
+         }
+
+         done_condition.notify_all();
+      }
+   }
+}
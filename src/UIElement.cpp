@@ -1,5 +1,7 @@
 #include "CX/Circle/Circle.hpp"
 
+#include "CX/Render/RenderBatch.hpp"
+
 namespace cx
 {
    // Circle functions
@@ -295,6 +297,24 @@ namespace cx
       return get_color().a;
    }
 
+   uint32_t UIElement::get_revision() const
+   {
+      return revision;
+   }
+
+   // Render functions
+
+   void UIElement::submit(RenderBatch& batch, int layer) const
+   {
+      drawable.element = this;
+      batch.submit(drawable, layer, sf::RenderStates::Default);
+   }
+
+   void UIElement::ElementDrawable::draw(sf::RenderTarget& target, sf::RenderStates states) const
+   {
+      element->render(target, states.shader);
+   }
+
    // Update functions
 
    void UIElement::flip_horizontally()
@@ -406,4 +426,9 @@ namespace cx
 
       (*on_update_func)(*this);
    }
+
+   void UIElement::mark_changed()
+   {
+      ++revision;
+   }
 }
@@ -0,0 +1,28 @@
+#include "CX/Asset/AssetPack.hpp"
+
+#include <exception>
+#include <iostream>
+
+/// @brief Pack every asset file in a directory, to be mounted with AssetManager::mount_pack.
+/// Usage: cx_pack <directory> <output>
+int main(int argc, char** argv)
+{
+   if (argc != 3)
+   {
+      std::cerr << "Usage: " << argv[0] << " <directory> <output>" << std::endl;
+      return 1;
+   }
+
+   try
+   {
+      const size_t count = cx::AssetPack::write(argv[1], argv[2]);
+      std::cout << "Packed " << count << " files into '" << argv[2] << "'" << std::endl;
+   }
+   catch (const std::exception& e)
+   {
+      std::cerr << "Error in 'cx_pack': " << e.what() << std::endl;
+      return 1;
+   }
+
+   return 0;
+}